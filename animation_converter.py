@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""
+Animation Converter for ESP32 LED Panel
+Turns GIFs / PNG sequences into the flash animation pack played by anim_player.cpp
+"""
+
+import os
+import sys
+import struct
+import argparse
+from typing import List, Tuple
+
+from PIL import Image, ImageSequence
+
+# Must match anim_player.h and config.h
+PACK_MAGIC = 0x50414C42        # "LBAP"
+ANIMATION_MAGIC = 0x31414C42   # "LBA1"
+PACK_VERSION = 1
+NAME_LENGTH = 16
+MAX_ANIMATIONS = 16
+MATRIX_WIDTH = 16
+MATRIX_HEIGHT = 16
+FRAME_KEY = 0
+FRAME_DELTA = 1
+
+# "anim" partition in partitions.csv
+PARTITION_OFFSET = 0x310000
+PARTITION_SIZE = 0xE0000
+
+
+def xy_to_index(x, y):
+    """Serpentine wiring, same as xyToIndex() in led_control.cpp"""
+    if y & 1:
+        return y * MATRIX_WIDTH + (MATRIX_WIDTH - 1 - x)
+    return y * MATRIX_WIDTH + x
+
+
+def frame_to_bytes(image: Image.Image) -> bytes:
+    """Scale to the panel and lay out RGB bytes in LED (not logical) order"""
+    image = image.convert('RGB').resize((MATRIX_WIDTH, MATRIX_HEIGHT), Image.BOX)
+    data = bytearray(MATRIX_WIDTH * MATRIX_HEIGHT * 3)
+    for y in range(MATRIX_HEIGHT):
+        for x in range(MATRIX_WIDTH):
+            index = xy_to_index(x, y) * 3
+            data[index:index + 3] = bytes(image.getpixel((x, y)))
+    return bytes(data)
+
+
+def rle_encode(data: bytes) -> bytes:
+    """Control byte: bit 7 set = repeat next byte (n & 0x7F) + 1 times, else copy n + 1 literals"""
+    out = bytearray()
+    literal = bytearray()
+    i = 0
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+            del literal[:128]
+
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    flush_literal()
+    return bytes(out)
+
+
+def load_frames(path: str) -> Tuple[List[bytes], int]:
+    """Returns (frames, frame delay in ms) for a GIF/PNG file or a directory of PNGs"""
+    if os.path.isdir(path):
+        names = sorted(n for n in os.listdir(path) if n.lower().endswith('.png'))
+        if not names:
+            raise ValueError(f"No PNG frames in {path}")
+        return [frame_to_bytes(Image.open(os.path.join(path, n))) for n in names], 0
+
+    image = Image.open(path)
+    frames = [frame_to_bytes(frame.copy()) for frame in ImageSequence.Iterator(image)]
+    return frames, int(image.info.get('duration', 0))
+
+
+def encode_animation(frames: List[bytes], delay_ms: int, keyframe_interval: int) -> bytes:
+    """Keyframe when forced by the interval or when a delta would not be smaller"""
+    blob = bytearray(struct.pack('<IBBHHH', ANIMATION_MAGIC, MATRIX_WIDTH, MATRIX_HEIGHT,
+                                 len(frames), delay_ms, 0))
+    previous = None
+    since_keyframe = 0
+
+    for frame in frames:
+        key_payload = rle_encode(frame)
+        frame_type, payload = FRAME_KEY, key_payload
+
+        if previous is not None and since_keyframe < keyframe_interval:
+            delta = bytes(a ^ b for a, b in zip(frame, previous))
+            delta_payload = rle_encode(delta)
+            if len(delta_payload) < len(key_payload):
+                frame_type, payload = FRAME_DELTA, delta_payload
+
+        since_keyframe = 0 if frame_type == FRAME_KEY else since_keyframe + 1
+        blob += struct.pack('<BBH', frame_type, 0, len(payload))
+        blob += payload
+        previous = frame
+
+    return bytes(blob)
+
+
+def build_pack(animations: List[Tuple[str, bytes]]) -> bytes:
+    """Pack header, directory, then each animation aligned to 4 bytes"""
+    header_size = struct.calcsize('<IHH') + len(animations) * (NAME_LENGTH + 8)
+    pack = bytearray(struct.pack('<IHH', PACK_MAGIC, PACK_VERSION, len(animations)))
+    body = bytearray()
+    offset = (header_size + 3) & ~3
+
+    for name, blob in animations:
+        pack += name.encode('ascii', 'replace')[:NAME_LENGTH].ljust(NAME_LENGTH, b'\0')
+        pack += struct.pack('<II', offset + len(body), len(blob))
+        body += blob
+        body += b'\0' * (-len(body) % 4)
+
+    pack += b'\0' * (offset - len(pack))
+    return bytes(pack + body)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('inputs', nargs='+', help='GIF/PNG files or directories of PNG frames')
+    parser.add_argument('-o', '--output', default='animations.bin', help='pack file to write')
+    parser.add_argument('--fps', type=float, help='override frame rate (default: GIF timing, else 20)')
+    parser.add_argument('--keyframe-interval', type=int, default=30,
+                        help='max deltas between keyframes (bounds resync cost)')
+    args = parser.parse_args()
+
+    if len(args.inputs) > MAX_ANIMATIONS:
+        sys.exit(f"At most {MAX_ANIMATIONS} animations fit in one pack")
+
+    animations = []
+    for path in args.inputs:
+        frames, delay_ms = load_frames(path)
+        if args.fps:
+            delay_ms = int(round(1000 / args.fps))
+        elif delay_ms <= 0:
+            delay_ms = 50
+        if len(frames) > 0xFFFF:
+            sys.exit(f"{path}: too many frames")
+
+        name = os.path.splitext(os.path.basename(os.path.normpath(path)))[0]
+        blob = encode_animation(frames, delay_ms, max(1, args.keyframe_interval))
+        raw_size = len(frames) * MATRIX_WIDTH * MATRIX_HEIGHT * 3
+        print(f"{name}: {len(frames)} frames @ {delay_ms} ms, "
+              f"{len(blob)} bytes ({100.0 * len(blob) / raw_size:.1f}% of raw)")
+        animations.append((name, blob))
+
+    pack = build_pack(animations)
+    if len(pack) > PARTITION_SIZE:
+        sys.exit(f"Pack is {len(pack)} bytes but the anim partition holds {PARTITION_SIZE}")
+
+    with open(args.output, 'wb') as f:
+        f.write(pack)
+
+    print(f"Wrote {args.output} ({len(pack)} bytes). Flash it with:")
+    print(f"  esptool.py write_flash 0x{PARTITION_OFFSET:X} {args.output}")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,132 @@
+/*
+ * Allocation Guard Module Implementation
+ * Counts heap allocations made by the loop task while a hot-path stage is armed
+ *
+ * With CONFIG_HEAP_USE_HOOKS the ESP-IDF heap calls esp_heap_trace_alloc_hook()
+ * for every malloc/realloc, so counts are exact. Without it only C++ operator new
+ * is seen (Arduino String reallocs are missed) and isAllocGuardExact() is false.
+ */
+
+#include "alloc_guard.h"
+#include <stdarg.h>
+#include <new>
+
+// Armed stage and the task that armed it (allocations from WiFi/other tasks are ignored)
+static volatile AllocStage armedStage = ALLOC_STAGE_NONE;
+static volatile TaskHandle_t armedTask = NULL;
+static volatile uint32_t allocCounts[ALLOC_STAGE_COUNT] = {0};
+
+static const char* allocStageNames[ALLOC_STAGE_COUNT] = {
+  "none", "pattern", "show", "buttons"
+};
+
+static inline void IRAM_ATTR countAllocation() {
+  if (armedStage != ALLOC_STAGE_NONE && xTaskGetCurrentTaskHandle() == armedTask) {
+    allocCounts[armedStage]++;
+  }
+}
+
+#ifdef CONFIG_HEAP_USE_HOOKS
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+  countAllocation();
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void* ptr) {
+}
+#else
+void* operator new(size_t size) {
+  countAllocation();
+  void* ptr = malloc(size);
+  if (ptr == NULL) {
+    abort();
+  }
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  countAllocation();
+  void* ptr = malloc(size);
+  if (ptr == NULL) {
+    abort();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, size_t size) noexcept {
+  free(ptr);
+}
+#endif
+
+void initializeAllocGuard() {
+  for (int i = 0; i < ALLOC_STAGE_COUNT; i++) {
+    allocCounts[i] = 0;
+  }
+  if (isAllocGuardExact()) {
+    DEBUG_INFO("Allocation guard: heap hooks active");
+  } else {
+    DEBUG_WARN("Allocation guard: heap hooks unavailable, counting operator new only");
+  }
+}
+
+void armAllocGuard(AllocStage stage) {
+  #if ENABLE_ALLOC_GUARD
+  armedTask = xTaskGetCurrentTaskHandle();
+  armedStage = stage;
+  #endif
+}
+
+void disarmAllocGuard() {
+  #if ENABLE_ALLOC_GUARD
+  AllocStage stage = armedStage;
+  armedStage = ALLOC_STAGE_NONE;
+  
+  #if ALLOC_GUARD_STRICT
+  // Test builds: any hot-path allocation is a hard failure
+  if (stage != ALLOC_STAGE_NONE && allocCounts[stage] != 0) {
+    printfNoAlloc("[ERROR] Heap allocation inside %s stage (%u total) - halting\n",
+                  allocStageNames[stage], (unsigned int)allocCounts[stage]);
+    Serial.flush();
+    abort();
+  }
+  #else
+  (void)stage;
+  #endif
+  #endif
+}
+
+uint32_t getAllocCount(AllocStage stage) {
+  return allocCounts[stage];
+}
+
+const char* getAllocStageName(AllocStage stage) {
+  return allocStageNames[stage];
+}
+
+bool isAllocGuardExact() {
+  #ifdef CONFIG_HEAP_USE_HOOKS
+  return true;
+  #else
+  return false;
+  #endif
+}
+
+void printfNoAlloc(const char* format, ...) {
+  char buffer[160];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  Serial.print(buffer);
+}
@@ -0,0 +1,31 @@
+/*
+ * Allocation Guard Module
+ * Counts heap allocations made by the loop task while a hot-path stage is armed
+ */
+
+#ifndef ALLOC_GUARD_H
+#define ALLOC_GUARD_H
+
+#include "config.h"
+
+// Loop stages that must never touch the heap
+enum AllocStage {
+  ALLOC_STAGE_NONE,
+  ALLOC_STAGE_PATTERN,    // updateCurrentPattern()
+  ALLOC_STAGE_SHOW,       // showLEDs()
+  ALLOC_STAGE_BUTTONS,    // handleButtons()
+  ALLOC_STAGE_COUNT
+};
+
+// Function declarations
+void initializeAllocGuard();
+void armAllocGuard(AllocStage stage);
+void disarmAllocGuard();
+uint32_t getAllocCount(AllocStage stage);
+const char* getAllocStageName(AllocStage stage);
+bool isAllocGuardExact();
+
+// Formats into a stack buffer - Serial.printf() mallocs for lines over 64 bytes
+void printfNoAlloc(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+#endif // ALLOC_GUARD_H
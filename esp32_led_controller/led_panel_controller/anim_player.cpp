@@ -0,0 +1,415 @@
+/*
+ * Animation Player Module Implementation
+ * Plays pre-made animations from a memory-mapped flash partition
+ * (keyframes plus XOR delta frames, RLE-compressed - see animation_converter.py)
+ */
+
+#include "anim_player.h"
+#include "alloc_guard.h"
+#include <esp_partition.h>
+
+// A stall longer than this many frames drops the backlog instead of fast-forwarding
+#define ANIMATION_MAX_CATCH_UP 4
+
+#define ANIMATION_FRAME_BYTES (NUM_LEDS * 3)
+
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+static esp_partition_mmap_handle_t animationMapHandle;
+#define ANIMATION_MMAP_DATA ESP_PARTITION_MMAP_DATA
+#define unmapAnimationPartition(handle) esp_partition_munmap(handle)
+#else
+static spi_flash_mmap_handle_t animationMapHandle;
+#define ANIMATION_MMAP_DATA SPI_FLASH_MMAP_DATA
+#define unmapAnimationPartition(handle) spi_flash_munmap(handle)
+#endif
+
+// Mapped pack - read in place, never copied to RAM
+static const uint8_t* packBase = NULL;
+static uint32_t packSize = 0;
+static uint8_t animationCount = 0;
+static uint8_t selectedAnimation = 0;
+
+// Mapped pack while a pinned one is playing
+static const uint8_t* savedPackBase = NULL;
+static uint32_t savedPackSize = 0;
+static uint8_t savedAnimationCount = 0;
+static uint8_t savedSelectedAnimation = 0;
+static bool packPinned = false;
+
+// Resolved view of one animation inside the pack
+struct AnimationView {
+  const uint8_t* blob;
+  uint32_t length;
+  uint16_t frameCount;
+  uint16_t frameDelayMs;
+};
+
+static AnimationPackEntry readPackEntry(uint8_t index) {
+  // Flash-mapped data may be unaligned for the packed structs - copy out
+  AnimationPackEntry entry;
+  memcpy(&entry, packBase + sizeof(AnimationPackHeader) + index * sizeof(AnimationPackEntry), sizeof(entry));
+  return entry;
+}
+
+static bool loadAnimationView(uint8_t index, AnimationView& view) {
+  AnimationPackEntry entry = readPackEntry(index);
+  if (entry.length < sizeof(AnimationHeader) || entry.offset > packSize ||
+      entry.length > packSize - entry.offset) {
+    return false;
+  }
+
+  AnimationHeader header;
+  memcpy(&header, packBase + entry.offset, sizeof(header));
+  if (header.magic != ANIMATION_MAGIC || header.width != MATRIX_WIDTH ||
+      header.height != MATRIX_HEIGHT || header.frameCount == 0) {
+    return false;
+  }
+
+  view.blob = packBase + entry.offset;
+  view.length = entry.length;
+  view.frameCount = header.frameCount;
+  view.frameDelayMs = (header.frameDelayMs > 0) ? header.frameDelayMs : PATTERN_UPDATE_MS;
+  return true;
+}
+
+void initializeAnimationPlayer() {
+  const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                              ESP_PARTITION_SUBTYPE_ANY,
+                                                              ANIMATION_PARTITION_LABEL);
+  if (partition == NULL) {
+    Serial.println("🎬 No animation partition - animation pattern disabled");
+    return;
+  }
+
+  const void* mapped = NULL;
+  if (esp_partition_mmap(partition, 0, partition->size, ANIMATION_MMAP_DATA,
+                         &mapped, &animationMapHandle) != ESP_OK) {
+    Serial.println("❌ Failed to map animation partition");
+    return;
+  }
+
+  AnimationPackHeader header;
+  memcpy(&header, mapped, sizeof(header));
+  if (header.magic != ANIMATION_PACK_MAGIC || header.version != ANIMATION_PACK_VERSION ||
+      header.animationCount == 0 || header.animationCount > ANIMATION_MAX_COUNT ||
+      sizeof(header) + header.animationCount * sizeof(AnimationPackEntry) > partition->size) {
+    Serial.println("🎬 Animation partition is empty - flash a pack from animation_converter.py");
+    unmapAnimationPartition(animationMapHandle);
+    return;
+  }
+
+  packBase = (const uint8_t*)mapped;
+  packSize = partition->size;
+
+  // Reject the whole pack on any bad entry rather than renumbering animations
+  for (uint8_t i = 0; i < header.animationCount; i++) {
+    AnimationView view;
+    if (!loadAnimationView(i, view)) {
+      Serial.printf("❌ Animation %d in pack is invalid - animation pattern disabled\n", i);
+      packBase = NULL;
+      unmapAnimationPartition(animationMapHandle);
+      return;
+    }
+  }
+
+  animationCount = header.animationCount;
+  Serial.printf("🎬 Animation pack mapped: %d animation(s)\n", animationCount);
+}
+
+uint8_t getAnimationCount() {
+  return animationCount;
+}
+
+const char* getAnimationName(uint8_t index) {
+  static char name[ANIMATION_NAME_LENGTH + 1];
+  if (index >= animationCount) {
+    return "";
+  }
+  AnimationPackEntry entry = readPackEntry(index);
+  memcpy(name, entry.name, ANIMATION_NAME_LENGTH);
+  name[ANIMATION_NAME_LENGTH] = '\0';
+  return name;
+}
+
+void selectAnimation(uint8_t index) {
+  if (index < animationCount) {
+    selectedAnimation = index;
+  }
+}
+
+uint8_t getSelectedAnimation() {
+  return selectedAnimation;
+}
+
+bool pinAnimationPack(const uint8_t* pack, uint32_t size) {
+  if (!packPinned) {
+    savedPackBase = packBase;
+    savedPackSize = packSize;
+    savedAnimationCount = animationCount;
+    savedSelectedAnimation = selectedAnimation;
+    packPinned = true;
+  }
+
+  AnimationPackHeader header;
+  memcpy(&header, pack, sizeof(header));
+  packBase = pack;
+  packSize = size;
+  animationCount = 0;
+  selectedAnimation = 0;
+  if (size < sizeof(header) || header.magic != ANIMATION_PACK_MAGIC || header.animationCount == 0 ||
+      header.animationCount > ANIMATION_MAX_COUNT ||
+      sizeof(header) + header.animationCount * sizeof(AnimationPackEntry) > size) {
+    return false;
+  }
+  for (uint8_t i = 0; i < header.animationCount; i++) {
+    AnimationView view;
+    if (!loadAnimationView(i, view)) {
+      return false;
+    }
+  }
+  animationCount = header.animationCount;
+  return true;
+}
+
+void releaseAnimationPack() {
+  if (!packPinned) {
+    return;
+  }
+  packBase = savedPackBase;
+  packSize = savedPackSize;
+  animationCount = savedAnimationCount;
+  selectedAnimation = savedSelectedAnimation;
+  packPinned = false;
+}
+
+static bool decodeRle(const uint8_t* src, uint16_t length, uint8_t* dst, bool xorInto) {
+  uint16_t in = 0;
+  uint16_t out = 0;
+
+  while (in < length) {
+    uint8_t control = src[in++];
+    uint16_t count = (control & 0x7F) + 1;
+    if (out + count > ANIMATION_FRAME_BYTES) {
+      return false;
+    }
+
+    if (control & 0x80) {
+      if (in >= length) {
+        return false;
+      }
+      uint8_t value = src[in++];
+      if (!xorInto) {
+        memset(dst + out, value, count);
+      } else if (value != 0) {
+        // Zero runs are the unchanged pixels of a delta - nothing to do
+        for (uint16_t i = 0; i < count; i++) {
+          dst[out + i] ^= value;
+        }
+      }
+    } else {
+      if (in + count > length) {
+        return false;
+      }
+      if (xorInto) {
+        for (uint16_t i = 0; i < count; i++) {
+          dst[out + i] ^= src[in + i];
+        }
+      } else {
+        memcpy(dst + out, src + in, count);
+      }
+      in += count;
+    }
+    out += count;
+  }
+
+  return out == ANIMATION_FRAME_BYTES;
+}
+
+// Decodes the frame record at offset into target; advances offset past it
+static bool decodeFrame(const AnimationView& view, uint32_t& offset, CRGB* target, bool& keyframe) {
+  AnimationFrameHeader frame;
+  if (offset + sizeof(frame) > view.length) {
+    return false;
+  }
+  memcpy(&frame, view.blob + offset, sizeof(frame));
+
+  uint32_t payloadOffset = offset + sizeof(frame);
+  if (payloadOffset + frame.payloadLength > view.length) {
+    return false;
+  }
+
+  keyframe = (frame.type == ANIMATION_FRAME_KEY);
+  if (!decodeRle(view.blob + payloadOffset, frame.payloadLength, (uint8_t*)target, !keyframe)) {
+    return false;
+  }
+
+  offset = payloadOffset + frame.payloadLength;
+  return true;
+}
+
+static bool showFrame(AnimationPlayback& playback, const AnimationView& view, CRGB* target,
+                      uint16_t frameIndex, uint32_t offset) {
+  uint32_t frameOffset = offset;
+  bool keyframe;
+  if (!decodeFrame(view, offset, target, keyframe)) {
+    return false;
+  }
+  if (keyframe) {
+    playback.keyframeIndex = frameIndex;
+    playback.keyframeOffset = frameOffset;
+  } else if (frameIndex == 0) {
+    return false;  // Loops restart on frame 0, so it must be a keyframe
+  }
+  playback.frameIndex = frameIndex;
+  playback.nextOffset = offset;
+  return true;
+}
+
+static bool rebuildFromKeyframe(AnimationPlayback& playback, const AnimationView& view, CRGB* target) {
+  // The target buffer does not hold our last frame - replay deltas from the keyframe
+  uint16_t wantedIndex = playback.frameIndex;
+  uint32_t offset = playback.keyframeOffset;
+  for (uint16_t index = playback.keyframeIndex; index <= wantedIndex; index++) {
+    if (!showFrame(playback, view, target, index, offset)) {
+      return false;
+    }
+    offset = playback.nextOffset;
+  }
+  return true;
+}
+
+void stepAnimation(AnimationPlayback& playback, CRGB* target, unsigned long now) {
+  AnimationView view;
+  if (playback.failed || playback.animation >= animationCount || !loadAnimationView(playback.animation, view)) {
+    fill_solid(target, NUM_LEDS, CRGB::Black);
+    return;
+  }
+
+  bool ok = true;
+  if (!playback.started) {
+    ok = showFrame(playback, view, target, 0, sizeof(AnimationHeader));
+    playback.started = true;
+    playback.nextFrameTime = now + view.frameDelayMs;
+  } else if (target != playback.lastTarget) {
+    ok = rebuildFromKeyframe(playback, view, target);
+  }
+
+  // Fixed frame rate independent of the pattern tick
+  uint8_t advanced = 0;
+  while (ok && (long)(now - playback.nextFrameTime) >= 0 && advanced < ANIMATION_MAX_CATCH_UP) {
+    if (playback.frameIndex + 1 >= view.frameCount) {
+      ok = showFrame(playback, view, target, 0, sizeof(AnimationHeader));
+    } else {
+      ok = showFrame(playback, view, target, playback.frameIndex + 1, playback.nextOffset);
+    }
+    playback.nextFrameTime += view.frameDelayMs;
+    advanced++;
+  }
+  if ((long)(now - playback.nextFrameTime) >= 0) {
+    playback.nextFrameTime = now + view.frameDelayMs;
+  }
+
+  if (!ok) {
+    printfNoAlloc("❌ Animation %d frame %d is corrupt - stopping playback\n",
+                  playback.animation, playback.frameIndex);
+    playback.failed = true;
+    fill_solid(target, NUM_LEDS, CRGB::Black);
+    return;
+  }
+  playback.lastTarget = target;
+}
+
+// Writes src[start, end) as literal chunks of up to 128 bytes
+static bool flushLiterals(const uint8_t* src, uint16_t start, uint16_t end,
+                          uint8_t* dst, uint16_t& out, uint16_t capacity) {
+  while (start < end) {
+    uint16_t count = min((uint16_t)(end - start), (uint16_t)128);
+    if (out + 1 + count > capacity) {
+      return false;
+    }
+    dst[out++] = count - 1;
+    memcpy(dst + out, src + start, count);
+    out += count;
+    start += count;
+  }
+  return true;
+}
+
+// Same encoding as rle_encode() in animation_converter.py; returns 0 if it would not fit
+static uint16_t encodeRle(const uint8_t* src, uint16_t length, uint8_t* dst, uint16_t capacity) {
+  uint16_t in = 0;
+  uint16_t out = 0;
+  uint16_t literalStart = 0;
+
+  while (in < length) {
+    uint16_t run = 1;
+    while (in + run < length && run < 128 && src[in + run] == src[in]) {
+      run++;
+    }
+    if (run < 3) {
+      in++;
+      continue;
+    }
+
+    if (!flushLiterals(src, literalStart, in, dst, out, capacity) || out + 2 > capacity) {
+      return 0;
+    }
+    dst[out++] = 0x80 | (run - 1);
+    dst[out++] = src[in];
+    in += run;
+    literalStart = in;
+  }
+
+  if (!flushLiterals(src, literalStart, length, dst, out, capacity)) {
+    return 0;
+  }
+  return out;
+}
+
+size_t encodeAnimationFrame(const CRGB* frame, const CRGB* previous, uint8_t* out, size_t capacity) {
+  if (capacity < sizeof(AnimationFrameHeader)) {
+    return 0;
+  }
+  uint16_t payloadCapacity = min(capacity - sizeof(AnimationFrameHeader), (size_t)0xFFFF);
+  uint8_t* payload = out + sizeof(AnimationFrameHeader);
+
+  AnimationFrameHeader header;
+  header.type = ANIMATION_FRAME_KEY;
+  header.reserved = 0;
+  header.payloadLength = encodeRle((const uint8_t*)frame, ANIMATION_FRAME_BYTES, payload, payloadCapacity);
+
+  if (previous != NULL) {
+    // Keep the delta only when it beats the keyframe (as the converter does)
+    static uint8_t difference[ANIMATION_FRAME_BYTES];
+    static uint8_t deltaPayload[ANIMATION_FRAME_RECORD_MAX];
+    for (uint16_t i = 0; i < ANIMATION_FRAME_BYTES; i++) {
+      difference[i] = ((const uint8_t*)frame)[i] ^ ((const uint8_t*)previous)[i];
+    }
+    uint16_t deltaLength = encodeRle(difference, ANIMATION_FRAME_BYTES, deltaPayload,
+                                     min(payloadCapacity, (uint16_t)sizeof(deltaPayload)));
+    if (deltaLength > 0 && (header.payloadLength == 0 || deltaLength < header.payloadLength)) {
+      header.type = ANIMATION_FRAME_DELTA;
+      header.payloadLength = deltaLength;
+      memcpy(payload, deltaPayload, deltaLength);
+    }
+  }
+
+  if (header.payloadLength == 0) {
+    return 0;
+  }
+  memcpy(out, &header, sizeof(header));
+  return sizeof(header) + header.payloadLength;
+}
+
+uint32_t getAnimationPackFingerprint() {
+  // FNV-1a over the header and directory - changes whenever a new pack is flashed
+  uint32_t hash = 0x811C9DC5;
+  if (packBase == NULL) {
+    return hash;
+  }
+  size_t length = sizeof(AnimationPackHeader) + animationCount * sizeof(AnimationPackEntry);
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ packBase[i]) * 0x01000193;
+  }
+  return hash;
+}
@@ -0,0 +1,98 @@
+/*
+ * Animation Player Module
+ * Plays pre-made animations from a memory-mapped flash partition
+ * (keyframes plus XOR delta frames, RLE-compressed - see animation_converter.py)
+ */
+
+#ifndef ANIM_PLAYER_H
+#define ANIM_PLAYER_H
+
+#include "config.h"
+#include <FastLED.h>
+
+// Data partition holding the animation pack (see partitions.csv)
+#ifndef ANIMATION_PARTITION_LABEL
+#define ANIMATION_PARTITION_LABEL "anim"
+#endif
+#ifndef ANIMATION_MAX_COUNT
+#define ANIMATION_MAX_COUNT 16
+#endif
+
+// Pack layout (all integers little-endian):
+//   PackHeader, then animationCount x PackEntry
+//   each entry points at: AnimationHeader, then frameCount x (FrameHeader + RLE payload)
+// RLE control byte: bit 7 set = repeat next byte (n & 0x7F) + 1 times,
+//                   bit 7 clear = copy next n + 1 bytes literally
+#define ANIMATION_PACK_MAGIC 0x50414C42   // "LBAP"
+#define ANIMATION_MAGIC 0x31414C42        // "LBA1"
+#define ANIMATION_PACK_VERSION 1
+#define ANIMATION_NAME_LENGTH 16
+
+// Largest frame record: header plus a frame of 128-byte literal runs
+#define ANIMATION_FRAME_RECORD_MAX (4 + NUM_LEDS * 3 + (NUM_LEDS * 3 + 127) / 128)
+
+enum AnimationFrameType {
+  ANIMATION_FRAME_KEY = 0,     // RLE of the whole frame
+  ANIMATION_FRAME_DELTA = 1    // RLE of (frame XOR previous frame)
+};
+
+struct __attribute__((packed)) AnimationPackHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t animationCount;
+};
+
+struct __attribute__((packed)) AnimationPackEntry {
+  char name[ANIMATION_NAME_LENGTH];
+  uint32_t offset;    // From start of partition
+  uint32_t length;
+};
+
+struct __attribute__((packed)) AnimationHeader {
+  uint32_t magic;
+  uint8_t width;
+  uint8_t height;
+  uint16_t frameCount;
+  uint16_t frameDelayMs;
+  uint16_t reserved;
+};
+
+struct __attribute__((packed)) AnimationFrameHeader {
+  uint8_t type;
+  uint8_t reserved;
+  uint16_t payloadLength;
+};
+
+// Playback cursor - lives in the pattern arena, so RAM use is constant
+struct AnimationPlayback {
+  uint8_t animation;
+  bool started;
+  bool failed;                // Corrupt frame seen - shows black until reselected
+  uint16_t frameIndex;        // Frame currently on screen
+  uint32_t nextOffset;        // Offset of the following frame record
+  uint16_t keyframeIndex;     // Most recent keyframe at or before frameIndex
+  uint32_t keyframeOffset;
+  unsigned long nextFrameTime;
+  const CRGB* lastTarget;     // Buffer that holds frameIndex
+};
+
+// Function declarations
+void initializeAnimationPlayer();
+uint8_t getAnimationCount();
+const char* getAnimationName(uint8_t index);
+void selectAnimation(uint8_t index);
+uint8_t getSelectedAnimation();
+
+// Frame check: plays a pack built in RAM instead of the mapped partition until released
+bool pinAnimationPack(const uint8_t* pack, uint32_t size);
+void releaseAnimationPack();
+
+// Decodes the frame due at 'now' into target, keeping target's previous contents for deltas
+void stepAnimation(AnimationPlayback& playback, CRGB* target, unsigned long now);
+
+// Encoding side, used for on-device previews: writes one frame record (header + RLE
+// payload), as a delta against 'previous' when that is smaller. Returns 0 if it does not fit.
+size_t encodeAnimationFrame(const CRGB* frame, const CRGB* previous, uint8_t* out, size_t capacity);
+uint32_t getAnimationPackFingerprint();
+
+#endif // ANIM_PLAYER_H
@@ -5,13 +5,40 @@
 
 #include "battery_manager.h"
 #include "led_control.h"
-#include <Wire.h>
+#include "i2c_bus.h"
+
+// Fuel gauge registers
+#define MAX17048_REG_VCELL 0x02
+#define MAX17048_REG_SOC 0x04
+#define MAX17048_REG_MODE 0x06
+#define MAX17048_REG_VERSION 0x08
+#define MAX17048_REG_HIBRT 0x0A
+#define MAX17048_REG_CONFIG 0x0C
+#define MAX17048_REG_CRATE 0x16
+#define MAX17048_REG_STATUS 0x1A
+#define FUEL_GAUGE_READ_TIMEOUT_MS 1000
+
+// CONFIG: RCOMP in the high byte, then SLEEP, ALSC (1% SOC change alert), ALRT, ATHD
+#define MAX17048_CONFIG_ALSC 0x0040
+#define MAX17048_CONFIG_ALRT 0x0020
+#define MAX17048_CONFIG_ATHD_MASK 0x001F
+#define MAX17048_RCOMP_DEFAULT 0x97
+// STATUS alert bits (cleared by writing 0), EnVR must be preserved
+#define MAX17048_STATUS_SC 0x2000    // SOC changed by 1%
+#define MAX17048_STATUS_HD 0x1000    // SOC below ATHD
+#define MAX17048_STATUS_ENVR 0x4000
+#define MAX17048_MODE_HIBSTAT 0x1000
+
+// One burst covers VCELL through STATUS - registers are parsed from their offset
+#define FUEL_GAUGE_BURST_FIRST MAX17048_REG_VCELL
+#define FUEL_GAUGE_BURST_BYTES (MAX17048_REG_STATUS + 2 - MAX17048_REG_VCELL)
 
 // Battery state variables - initialize to reasonable defaults to avoid showing 0% on startup
-float batteryVoltage = 3.7;
-float batteryPercentage = 75.0;  // Start with reasonable estimate instead of 50% to be safer
-bool isCharging = false;
-bool lowBatteryWarning = false;
+static float batteryVoltage = 3.7;
+static float batteryPercentage = 75.0;  // Start with reasonable estimate instead of 50% to be safer
+static bool isCharging = false;
+static bool lowBatteryWarning = false;
+Seqlock<BatteryState> batterySnapshot(BatteryState{3.7, 75.0, 0.0, false, false, false, false});
 
 // Internal state
 bool fuelGaugeInitialized = false;
@@ -25,6 +52,33 @@ bool alertPinTriggered = false;
 // Alert interrupt flag
 volatile bool fuelGaugeAlertFlag = false;
 
+// Readings are one burst queued on the I2C bus task and collected on a later call
+static I2cTransaction fuelGaugeBurstRead;
+static I2cTransaction alertStatusClear;
+static I2cTransaction alertConfigClear;
+static bool fuelGaugeReadsPending = false;
+static bool lastFuelGaugeBurstFailed = false;
+static int consecutiveFuelGaugeErrors = 0;
+
+// Alert configuration written by setLowBatteryThreshold (rewritten with ALRT clear)
+static uint16_t fuelGaugeConfig = (MAX17048_RCOMP_DEFAULT << 8) | MAX17048_CONFIG_ALSC;
+static float batteryChargeRate = 0.0;      // %/hr from CRATE, positive while charging
+static bool fuelGaugeHibernating = false;
+static uint32_t fuelGaugeBursts = 0;
+static uint32_t fuelGaugeAlerts = 0;
+
+static void publishBatteryState() {
+  BatteryState state;
+  state.voltage = batteryVoltage;
+  state.percentage = batteryPercentage;
+  state.chargeRate = batteryChargeRate;
+  state.charging = isCharging;
+  state.lowBattery = lowBatteryWarning;
+  state.fuelGaugeWorking = fuelGaugeInitialized;
+  state.fuelGaugeHibernating = fuelGaugeHibernating;
+  publishSnapshot(batterySnapshot, state);
+}
+
 void initializeBatteryManager() {
   DEBUG_INFO("Initializing Battery Manager...");
   
@@ -43,6 +97,7 @@ void initializeBatteryManager() {
   
   // Initialize fuel gauge
   initializeFuelGauge();
+  publishBatteryState();
   
   // DON'T call updateBatteryManager() during init - it can overwrite our safe defaults
   // The main loop will call it after a few seconds, allowing the fuel gauge to stabilize
@@ -75,8 +130,13 @@ void initializeFuelGauge() {
     fuelGaugeInitialized = true;
     DEBUG_INFO("Max17048 detected (version: 0x" + String(version, HEX) + ")");
     
-    // Set alert threshold to 10% (configurable)
-    setLowBatteryThreshold(10.0);
+    // Set alert threshold to 10% (configurable) - also enables the 1% SOC change alert
+    setLowBatteryThreshold(LOW_BATTERY_THRESHOLD);
+    
+    // Hibernate (ADC sampling every 45s instead of 250ms) while the charge rate stays low
+    uint8_t hibernateRate = (uint8_t)constrain(FUEL_GAUGE_HIBERNATE_RATE / 0.208, 0, 255);
+    uint8_t activeThreshold = (uint8_t)constrain(FUEL_GAUGE_ACTIVE_THRESHOLD_MV / 1.25, 0, 255);
+    writeFuelGaugeRegister(MAX17048_REG_HIBRT, (hibernateRate << 8) | activeThreshold);
     
     // Max17048 preserves learned battery characteristics in internal EEPROM
     // Quick start is ONLY needed if the chip is completely unresponsive or has corrupted data
@@ -104,19 +164,91 @@ void initializeFuelGauge() {
   }
 }
 
-void updateBatteryManager() {
-  if (millis() - lastBatteryUpdate < BATTERY_UPDATE_MS) {
+static void noteFuelGaugeResult(bool success) {
+  if (success) {
+    consecutiveFuelGaugeErrors = 0;
     return;
   }
+  consecutiveFuelGaugeErrors++;
+  // If too many consecutive errors, fall back to ADC
+  if (consecutiveFuelGaugeErrors > 10 && fuelGaugeInitialized) {
+    DEBUG_ERROR("Too many fuel gauge errors (" + String(consecutiveFuelGaugeErrors) + ") - switching to ADC fallback");
+    fuelGaugeInitialized = false;
+  }
+}
+
+// Register value from the burst, 0xFFFF on failure (same convention as readFuelGaugeRegister)
+static uint16_t burstFuelGaugeWord(uint8_t reg) {
+  if (lastFuelGaugeBurstFailed) {
+    return 0xFFFF;
+  }
+  int offset = reg - FUEL_GAUGE_BURST_FIRST;
+  return (fuelGaugeBurstRead.readData[offset] << 8) | fuelGaugeBurstRead.readData[offset + 1];
+}
+
+static void requestFuelGaugeReadings() {
+  if (isI2cPending(&fuelGaugeBurstRead)) {
+    return;  // Previous burst still queued behind a busy bus
+  }
+  prepareI2cRead(&fuelGaugeBurstRead, I2C_DEVICE_FUEL_GAUGE, MAX17048_I2C_ADDRESS,
+                 FUEL_GAUGE_BURST_FIRST, FUEL_GAUGE_BURST_BYTES);
+  // A burst that could not be queued is collected as a failure like any other
+  fuelGaugeReadsPending = submitI2cTransaction(&fuelGaugeBurstRead, I2C_PRIORITY_NORMAL, FUEL_GAUGE_READ_TIMEOUT_MS);
+  fuelGaugeAlertFlag = false;
+  if (!fuelGaugeReadsPending) {
+    lastFuelGaugeBurstFailed = true;
+    noteFuelGaugeResult(false);
+  }
+}
+
+// Time until the next unprompted burst - the ALRT pin covers every 1% SOC step in between
+static unsigned long fuelGaugeInterval() {
+  if (!fuelGaugeInitialized || lastFuelGaugeBurstFailed || millis() < STARTUP_GRACE_PERIOD) {
+    return BATTERY_UPDATE_MS;  // ADC fallback, retries and startup validation keep the fast cadence
+  }
+  return fuelGaugeHibernating ? FUEL_GAUGE_HEARTBEAT_MS * 4 : FUEL_GAUGE_HEARTBEAT_MS;
+}
+
+static void finishBatteryUpdate() {
+  // Update charging status as part of battery management
+  updateChargingStatus();
   
-  if (fuelGaugeInitialized) {
+  checkBatteryWarnings();
+  publishBatteryState();
+}
+
+void updateBatteryManager() {
+  // Burst queued last call - nothing to do until the bus task has answered
+  if (fuelGaugeReadsPending) {
+    if (isI2cPending(&fuelGaugeBurstRead)) {
+      return;
+    }
+    fuelGaugeReadsPending = false;
+    lastFuelGaugeBurstFailed = (fuelGaugeBurstRead.status != I2C_DONE);
+    fuelGaugeBurstRead.status = I2C_IDLE;
+    noteFuelGaugeResult(!lastFuelGaugeBurstFailed);
+    fuelGaugeBursts++;
     updateFuelGauge();
     // Periodic status reporting every 60 seconds (reduced from 30 to reduce I2C traffic)
     static unsigned long lastStatusReport = 0;
     if (millis() - lastStatusReport > 60000) {
-      DEBUG_INFO("Battery Status: " + String(batteryPercentage, 1) + "% (" + String(batteryVoltage, 2) + "V) - Fuel Gauge");
+      DEBUG_INFO("Battery Status: " + String(batteryPercentage, 1) + "% (" + String(batteryVoltage, 2) + "V, " + String(batteryChargeRate, 1) + "%/hr" + String(fuelGaugeHibernating ? ", hibernating" : "") + ") - Fuel Gauge");
       lastStatusReport = millis();
     }
+    finishBatteryUpdate();
+    return;
+  }
+  
+  // The fuel gauge alert (1% SOC change or low SOC) reads immediately, otherwise wait for the heartbeat
+  bool alertPending = fuelGaugeInitialized && fuelGaugeAlertFlag;
+  if (!alertPending && millis() - lastBatteryUpdate < fuelGaugeInterval()) {
+    return;
+  }
+  lastBatteryUpdate = millis();
+  
+  if (fuelGaugeInitialized) {
+    // Results are applied once the bus task has run the burst
+    requestFuelGaugeReadings();
   } else {
     updateBatteryVoltageADC();
     // Periodic status reporting every 60 seconds
@@ -125,26 +257,24 @@ void updateBatteryManager() {
       DEBUG_WARN("Battery Status: " + String(batteryPercentage, 1) + "% (" + String(batteryVoltage, 2) + "V) - ADC FALLBACK");
       lastADCStatusReport = millis();
     }
+    finishBatteryUpdate();
   }
-  
-  // Update charging status as part of battery management
-  updateChargingStatus();
-  
-  checkBatteryWarnings();
-  lastBatteryUpdate = millis();
 }
 
 void updateFuelGauge() {
-  // Read battery percentage from Max17048
-  float newSOC = readFuelGaugeSOC();
-  
-  // Read battery voltage from Max17048
-  float newVoltage = readFuelGaugeVoltage();
-  
-  // Handle alert flag
-  if (fuelGaugeAlertFlag) {
-    handleFuelGaugeAlert();
-    fuelGaugeAlertFlag = false;
+  // Battery percentage and voltage from the Max17048 burst queued last call
+  float newSOC = fuelGaugeSOCFromRegister(burstFuelGaugeWord(MAX17048_REG_SOC));
+  float newVoltage = fuelGaugeVoltageFromRegister(burstFuelGaugeWord(MAX17048_REG_VCELL));
+  
+  if (!lastFuelGaugeBurstFailed) {
+    // CRATE is signed, 0.208%/hr per bit
+    batteryChargeRate = (int16_t)burstFuelGaugeWord(MAX17048_REG_CRATE) * 0.208;
+    fuelGaugeHibernating = (burstFuelGaugeWord(MAX17048_REG_MODE) & MAX17048_MODE_HIBSTAT) != 0;
+    
+    // Handle the alert even if the pin edge was missed - ALRT stays set until cleared
+    if (burstFuelGaugeWord(MAX17048_REG_CONFIG) & MAX17048_CONFIG_ALRT) {
+      handleFuelGaugeAlert(burstFuelGaugeWord(MAX17048_REG_STATUS));
+    }
   }
   
   // Validate readings - be very strict during startup to prevent garbage readings
@@ -241,7 +371,8 @@ void updateChargingStatus() {
   
   // Improved charging detection logic
   bool definitelyCharging = (batteryVoltage > 4.15); // High voltage = definitely charging
-  bool likelyCharging = (batteryVoltage > 4.05 && voltageRising); // Voltage rising = starting to charge
+  bool chargeRateRising = (fuelGaugeInitialized && batteryChargeRate > FUEL_GAUGE_HIBERNATE_RATE);
+  bool likelyCharging = (batteryVoltage > 4.05 && (voltageRising || chargeRateRising)); // Voltage rising = starting to charge
   bool lowVoltage = (batteryVoltage < 3.9); // Clearly not charging
   
   // State machine approach: easier to start charging, harder to stop
@@ -271,7 +402,8 @@ void checkBatteryWarnings() {
   
   // Check for low battery conditions (only when not charging)
   bool wasLowBattery = lowBatteryWarning;
-  lowBatteryWarning = (batteryPercentage < 15.0);
+  // Same threshold the fuel gauge alerts on, so the HD alert and this check agree
+  lowBatteryWarning = (batteryPercentage < LOW_BATTERY_THRESHOLD);
   
   // Alert on new low battery condition
   if (lowBatteryWarning && !wasLowBattery) {
@@ -292,29 +424,27 @@ void handleLowBatteryWarning() {
   // This prevents constant battery overlay but still notifies via serial
 }
 
-void handleFuelGaugeAlert() {
-  DEBUG_WARN("Fuel gauge alert triggered!");
-  
-  // Read alert status register
-  uint16_t alertFlags = readFuelGaugeRegister(0x1A); // STATUS register
+void handleFuelGaugeAlert(uint16_t alertFlags) {
+  if (alertFlags == 0xFFFF) {
+    return;  // STATUS read failed - ALRT stays set and the next burst retries
+  }
+  fuelGaugeAlerts++;
   
-  if (alertFlags & 0x0020) { // SOC change alert
-    DEBUG_INFO("Battery SOC changed");
+  if (alertFlags & MAX17048_STATUS_SC) { // SOC change alert - the burst already carries the new SOC
+    DEBUG_DEBUG("Battery SOC changed");
   }
   
-  if (alertFlags & 0x0010) { // Low SOC alert
+  if (alertFlags & MAX17048_STATUS_HD) { // Low SOC alert
     DEBUG_WARN("Low battery SOC alert");
     lowBatteryWarning = true;
   }
   
   // Clear alert flags
-  clearFuelGaugeAlert();
+  clearFuelGaugeAlert(alertFlags);
 }
 
 // Fuel gauge I2C communication functions
-float readFuelGaugeSOC() {
-  uint16_t soc = readFuelGaugeRegister(0x04); // SOC register
-  
+float fuelGaugeSOCFromRegister(uint16_t soc) {
   // Check for I2C communication error
   if (soc == 0xFFFF) {
     DEBUG_WARN("Fuel gauge SOC read failed (I2C error)");
@@ -324,9 +454,7 @@ float readFuelGaugeSOC() {
   return (float)soc / 256.0; // Convert to percentage
 }
 
-float readFuelGaugeVoltage() {
-  uint16_t voltage = readFuelGaugeRegister(0x02); // VCELL register
-  
+float fuelGaugeVoltageFromRegister(uint16_t voltage) {
   // Check for I2C communication error
   if (voltage == 0xFFFF) {
     DEBUG_WARN("Fuel gauge voltage read failed (I2C error)");
@@ -336,82 +464,36 @@ float readFuelGaugeVoltage() {
   return (float)voltage * 78.125 / 1000000.0; // Convert to volts
 }
 
+float readFuelGaugeSOC() {
+  return fuelGaugeSOCFromRegister(readFuelGaugeRegister(MAX17048_REG_SOC));
+}
+
+float readFuelGaugeVoltage() {
+  return fuelGaugeVoltageFromRegister(readFuelGaugeRegister(MAX17048_REG_VCELL));
+}
+
 uint16_t readFuelGaugeVersion() {
-  return readFuelGaugeRegister(0x08); // VERSION register
+  return readFuelGaugeRegister(MAX17048_REG_VERSION);
 }
 
+// Blocking register access - initialization and maintenance only; the bus task retries
 uint16_t readFuelGaugeRegister(uint8_t reg) {
-  static unsigned long lastI2CAccess = 0;
-  static int consecutiveErrors = 0;
-  
-  // Signal to gyroscope to pause during fuel gauge operations
-  extern volatile bool pauseGyroscopeReads;
-  pauseGyroscopeReads = true;
-  
-  // Increase spacing between I2C operations to prevent NACK errors and bus conflicts
-  // Fuel gauge needs more time due to shared I2C bus with gyroscope
-  if (millis() - lastI2CAccess < 100) { // Increased from 50ms to 100ms for better reliability
-    delay(100 - (millis() - lastI2CAccess));
+  I2cTransaction transaction = {};
+  prepareI2cRead(&transaction, I2C_DEVICE_FUEL_GAUGE, MAX17048_I2C_ADDRESS, reg, 2);
+  bool success = transferI2cBlocking(&transaction, I2C_PRIORITY_NORMAL, FUEL_GAUGE_READ_TIMEOUT_MS);
+  noteFuelGaugeResult(success);
+  if (!success) {
+    DEBUG_WARN("Fuel gauge I2C error " + String(transaction.error) + " reading register 0x" + String(reg, HEX));
+    return 0xFFFF; // Return error value after all retries failed
   }
-  
-  // Retry mechanism for I2C communication
-  for (int attempt = 0; attempt < 3; attempt++) {
-    Wire.beginTransmission(MAX17048_I2C_ADDRESS);
-    Wire.write(reg);
-    uint8_t error = Wire.endTransmission(false);
-    
-    if (error != 0) {
-      consecutiveErrors++;
-      DEBUG_WARN("Fuel gauge I2C error " + String(error) + " on attempt " + String(attempt + 1) + "/3 (consecutive errors: " + String(consecutiveErrors) + ")");
-      
-      if (attempt == 2) { // Last attempt
-        DEBUG_ERROR("Fuel gauge I2C failed after 3 attempts - this suggests I2C bus contention with gyroscope");
-        
-        // If too many consecutive errors, fall back to ADC
-        if (consecutiveErrors > 10) {
-          DEBUG_ERROR("Too many fuel gauge errors (" + String(consecutiveErrors) + ") - switching to ADC fallback");
-          fuelGaugeInitialized = false;
-        }
-        
-        lastI2CAccess = millis();
-        return 0xFFFF;
-      }
-      delay(50); // Increased delay before retry to reduce I2C bus conflicts
-      continue;
-    }
-    
-    // Request data with timeout
-    Wire.requestFrom(MAX17048_I2C_ADDRESS, 2);
-    unsigned long timeout = millis() + 100; // 100ms timeout
-    while (Wire.available() < 2 && millis() < timeout) {
-      delay(1);
-    }
-    
-    if (Wire.available() >= 2) {
-      uint16_t result = (Wire.read() << 8) | Wire.read();
-      consecutiveErrors = 0; // Reset error count on success
-      lastI2CAccess = millis();
-      pauseGyroscopeReads = false; // Re-enable gyroscope reads on success
-      return result;
-    }
-    
-    if (attempt == 2) {
-      DEBUG_WARN("Fuel gauge I2C timeout after 3 attempts");
-    }
-    delay(25); // Increased delay before retry for I2C stability
-  }
-  
-  lastI2CAccess = millis();
-  pauseGyroscopeReads = false; // Re-enable gyroscope reads
-  return 0xFFFF; // Return error value after all retries failed
+  return (transaction.readData[0] << 8) | transaction.readData[1];
 }
 
 void writeFuelGaugeRegister(uint8_t reg, uint16_t value) {
-  Wire.beginTransmission(MAX17048_I2C_ADDRESS);
-  Wire.write(reg);
-  Wire.write((value >> 8) & 0xFF);
-  Wire.write(value & 0xFF);
-  Wire.endTransmission();
+  uint8_t data[2] = {(uint8_t)(value >> 8), (uint8_t)(value & 0xFF)};
+  I2cTransaction transaction = {};
+  prepareI2cWrite(&transaction, I2C_DEVICE_FUEL_GAUGE, MAX17048_I2C_ADDRESS, reg, data, 2);
+  transferI2cBlocking(&transaction, I2C_PRIORITY_NORMAL, FUEL_GAUGE_READ_TIMEOUT_MS);
 }
 
 void resetFuelGaugeHardware() {
@@ -444,19 +526,31 @@ void quickStartFuelGauge() {
 }
 
 void setLowBatteryThreshold(float percentage) {
-  // Convert percentage to register value
-  uint16_t threshold = (uint16_t)(percentage * 256.0 / 100.0);
+  // ATHD counts down from 32%: threshold = 32% - ATHD, so 1-32% are representable
+  uint8_t threshold = (uint8_t)constrain(32 - (int)(percentage + 0.5), 0, 31);
   
-  // Set RCOMP and alert threshold
-  uint16_t config = 0x9700 | (threshold & 0x1F); // RCOMP=0x97, threshold in lower bits
-  writeFuelGaugeRegister(0x0C, config); // CONFIG register
+  // Keep the chip's RCOMP, enable the 1% SOC change alert and start with ALRT clear
+  uint16_t current = readFuelGaugeRegister(MAX17048_REG_CONFIG);
+  uint8_t rcomp = (current == 0xFFFF) ? MAX17048_RCOMP_DEFAULT : (current >> 8);
+  fuelGaugeConfig = (rcomp << 8) | MAX17048_CONFIG_ALSC | (threshold & MAX17048_CONFIG_ATHD_MASK);
+  writeFuelGaugeRegister(MAX17048_REG_CONFIG, fuelGaugeConfig);
   
   DEBUG_INFO("Low battery threshold set to " + String(percentage, 1) + "%");
 }
 
-void clearFuelGaugeAlert() {
-  // Clear alert by reading STATUS register
-  readFuelGaugeRegister(0x1A);
+void clearFuelGaugeAlert(uint16_t alertFlags) {
+  if (isI2cPending(&alertStatusClear) || isI2cPending(&alertConfigClear)) {
+    return;  // Previous clear still queued - ALRT is re-checked on the next burst
+  }
+  // Alert bits in STATUS are cleared by writing 0, then ALRT in CONFIG releases the pin
+  // (queued - nothing waits on the result)
+  uint16_t status = alertFlags & MAX17048_STATUS_ENVR;
+  uint8_t statusData[2] = {(uint8_t)(status >> 8), (uint8_t)(status & 0xFF)};
+  uint8_t configData[2] = {(uint8_t)(fuelGaugeConfig >> 8), (uint8_t)(fuelGaugeConfig & 0xFF)};
+  prepareI2cWrite(&alertStatusClear, I2C_DEVICE_FUEL_GAUGE, MAX17048_I2C_ADDRESS, MAX17048_REG_STATUS, statusData, 2);
+  prepareI2cWrite(&alertConfigClear, I2C_DEVICE_FUEL_GAUGE, MAX17048_I2C_ADDRESS, MAX17048_REG_CONFIG, configData, 2);
+  submitI2cTransaction(&alertStatusClear, I2C_PRIORITY_NORMAL, FUEL_GAUGE_READ_TIMEOUT_MS);
+  submitI2cTransaction(&alertConfigClear, I2C_PRIORITY_NORMAL, FUEL_GAUGE_READ_TIMEOUT_MS);
 }
 
 // Interrupt service routine
@@ -466,23 +560,39 @@ void IRAM_ATTR fuelGaugeAlertISR() {
 
 // Public interface functions
 float getBatteryVoltage() {
-  return batteryVoltage;
+  return readSnapshot(batterySnapshot).voltage;
 }
 
 float getBatteryPercentage() {
-  return batteryPercentage;
+  return readSnapshot(batterySnapshot).percentage;
 }
 
 bool getChargingStatus() {
-  return isCharging;
+  return readSnapshot(batterySnapshot).charging;
+}
+
+float getBatteryChargeRate() {
+  return readSnapshot(batterySnapshot).chargeRate;
+}
+
+bool isFuelGaugeHibernating() {
+  return readSnapshot(batterySnapshot).fuelGaugeHibernating;
+}
+
+uint32_t getFuelGaugeBurstCount() {
+  return fuelGaugeBursts;
+}
+
+uint32_t getFuelGaugeAlertCount() {
+  return fuelGaugeAlerts;
 }
 
 bool isLowBattery() {
-  return lowBatteryWarning;
+  return readSnapshot(batterySnapshot).lowBattery;
 }
 
 bool isCriticalBattery() {
-  return (batteryVoltage < BATTERY_EMERGENCY_VOLTAGE);
+  return (readSnapshot(batterySnapshot).voltage < BATTERY_EMERGENCY_VOLTAGE);
 }
 
 void enableCharging() {
@@ -502,5 +612,5 @@ bool canOperateWhileCharging() {
 }
 
 bool isFuelGaugeWorking() {
-  return fuelGaugeInitialized;
+  return readSnapshot(batterySnapshot).fuelGaugeWorking;
 } 
\ No newline at end of file
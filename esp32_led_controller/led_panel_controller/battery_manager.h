@@ -7,12 +7,29 @@
 #define BATTERY_MANAGER_H
 
 #include "config.h"
+#include "seqlock.h"
 
-// Battery state variables
-extern float batteryVoltage;
-extern float batteryPercentage;
-extern bool isCharging;
-extern bool lowBatteryWarning;
+#ifndef FUEL_GAUGE_HEARTBEAT_MS
+#define FUEL_GAUGE_HEARTBEAT_MS 60000
+#endif
+#ifndef FUEL_GAUGE_HIBERNATE_RATE
+#define FUEL_GAUGE_HIBERNATE_RATE 4.0
+#endif
+#ifndef FUEL_GAUGE_ACTIVE_THRESHOLD_MV
+#define FUEL_GAUGE_ACTIVE_THRESHOLD_MV 60
+#endif
+
+// Battery state, published after every update (the getters below read it too)
+struct BatteryState {
+  float voltage;
+  float percentage;
+  float chargeRate;         // %/hr from the fuel gauge, positive while charging
+  bool charging;
+  bool lowBattery;
+  bool fuelGaugeWorking;    // false while running on the ADC fallback
+  bool fuelGaugeHibernating;
+};
+extern Seqlock<BatteryState> batterySnapshot;
 
 // Function declarations
 void initializeBatteryManager();
@@ -22,6 +39,10 @@ void updateBatteryManager();
 float getBatteryVoltage();
 float getBatteryPercentage();
 bool getChargingStatus();
+float getBatteryChargeRate();       // %/hr from the fuel gauge, positive while charging
+bool isFuelGaugeHibernating();
+uint32_t getFuelGaugeBurstCount();
+uint32_t getFuelGaugeAlertCount();
 bool isLowBattery();
 bool isCriticalBattery();
 
@@ -45,14 +66,16 @@ bool canOperateWhileCharging();
 void initializeFuelGauge();
 float readFuelGaugeSOC();
 float readFuelGaugeVoltage();
+float fuelGaugeSOCFromRegister(uint16_t soc);
+float fuelGaugeVoltageFromRegister(uint16_t voltage);
 uint16_t readFuelGaugeVersion();
 uint16_t readFuelGaugeRegister(uint8_t reg);
 void writeFuelGaugeRegister(uint8_t reg, uint16_t value);
 void resetFuelGaugeHardware();
 void quickStartFuelGauge();
 void setLowBatteryThreshold(float percentage);
-void clearFuelGaugeAlert();
-void handleFuelGaugeAlert();
+void clearFuelGaugeAlert(uint16_t alertFlags);
+void handleFuelGaugeAlert(uint16_t alertFlags);
 
 // Charging status
 void updateChargingStatus();
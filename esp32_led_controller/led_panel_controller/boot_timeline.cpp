@@ -0,0 +1,50 @@
+/*
+ * Boot Timeline Module Implementation
+ * Milestones of the boot (setup steps, first frame, WiFi, web server) stamped
+ * once each, for time-to-first-frame and network bring-up reporting
+ */
+
+#include "boot_timeline.h"
+
+static BootPhase bootPhases[BOOT_TIMELINE_MAX];
+static volatile uint8_t bootPhaseCount = 0;
+static portMUX_TYPE bootTimelineMux = portMUX_INITIALIZER_UNLOCKED;
+
+static int findBootPhase(const char* name) {
+  for (int i = 0; i < bootPhaseCount; i++) {
+    if (strcmp(bootPhases[i].name, name) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void markBootPhase(const char* name) {
+  uint32_t now = millis();
+  bool added = false;
+  portENTER_CRITICAL(&bootTimelineMux);
+  if (bootPhaseCount < BOOT_TIMELINE_MAX && findBootPhase(name) < 0) {
+    bootPhases[bootPhaseCount].name = name;
+    bootPhases[bootPhaseCount].atMs = now;
+    bootPhaseCount++;
+    added = true;
+  }
+  portEXIT_CRITICAL(&bootTimelineMux);
+  
+  if (added) {
+    Serial.printf("⏱️ Boot: %s at %lu ms\n", name, (unsigned long)now);
+  }
+}
+
+uint8_t getBootPhaseCount() {
+  return bootPhaseCount;
+}
+
+const BootPhase* getBootPhase(uint8_t index) {
+  return (index < bootPhaseCount) ? &bootPhases[index] : NULL;
+}
+
+uint32_t getBootPhaseTime(const char* name) {
+  int index = findBootPhase(name);
+  return (index < 0) ? 0 : bootPhases[index].atMs;
+}
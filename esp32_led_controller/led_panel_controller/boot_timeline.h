@@ -0,0 +1,27 @@
+/*
+ * Boot Timeline Module
+ * Milestones of the boot (setup steps, first frame, WiFi, web server) stamped
+ * once each, for time-to-first-frame and network bring-up reporting
+ */
+
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include "config.h"
+
+#ifndef BOOT_TIMELINE_MAX
+#define BOOT_TIMELINE_MAX 16
+#endif
+
+struct BootPhase {
+  const char* name;             // String literal
+  uint32_t atMs;                // millis() when reached
+};
+
+// Function declarations - safe from any task; repeated names are ignored
+void markBootPhase(const char* name);
+uint8_t getBootPhaseCount();
+const BootPhase* getBootPhase(uint8_t index);
+uint32_t getBootPhaseTime(const char* name);  // 0 if not reached yet
+
+#endif // BOOT_TIMELINE_H
@@ -0,0 +1,263 @@
+/*
+ * Button Handler Module Implementation
+ * Runs every loop pass under the allocation guard, so logging goes through printfNoAlloc
+ */
+
+#include "button_handler.h"
+#include "alloc_guard.h"
+#include "anim_player.h"
+#include "github_client.h"
+#include "led_control.h"
+#include "pattern_engine.h"
+#include "pixel_vm.h"
+#include "power_manager.h"
+#include "web_server.h"
+
+ButtonState button1, button2, button3;
+static bool lastButton1State = false;
+static bool lastButton2State = false;
+static bool lastButton3State = false;
+
+bool manualBatteryDisplay = false;
+unsigned long batteryDisplayStartTime = 0;
+
+void initializeButtons() {
+  pinMode(BUTTON_PIN_1, INPUT_PULLUP);
+  pinMode(BUTTON_PIN_2, INPUT_PULLUP);
+  pinMode(BUTTON_PIN_3, INPUT_PULLUP);
+  
+  // Initialize charging status pin for hardware-based detection (if available)
+  #ifdef CHARGING_STATUS_PIN
+  pinMode(CHARGING_STATUS_PIN, INPUT_PULLUP); // BQ25606 charging status
+  #endif
+  
+  button1.pressed = false;
+  button1.lastPressed = false;
+  button1.longPressTriggered = false;
+  
+  button2.pressed = false;
+  button2.lastPressed = false;
+  button2.longPressTriggered = false;
+  
+  button3.pressed = false;
+  button3.lastPressed = false;
+  button3.longPressTriggered = false;
+  
+  // Initialize simple state tracking
+  lastButton1State = false;
+  lastButton2State = false;
+  lastButton3State = false;
+  
+  Serial.println("Buttons initialized");
+}
+
+void updateButton(ButtonState* btn, int pin) {
+  bool reading = !digitalRead(pin); // Inverted because of pull-up
+  
+  // Store previous pressed state for release detection
+  bool prevPressed = btn->pressed;
+  
+  // Debouncing
+  if (reading != btn->lastPressed) {
+    btn->lastDebounceTime = millis();
+  }
+  
+  if ((millis() - btn->lastDebounceTime) > BUTTON_DEBOUNCE_MS) {
+    if (reading != btn->pressed) {
+      btn->pressed = reading;
+      
+      if (btn->pressed) {
+        btn->pressTime = millis();
+        btn->longPressTriggered = false;
+      }
+    }
+    
+    // Check for long press
+    if (btn->pressed && !btn->longPressTriggered && 
+        (millis() - btn->pressTime) > BUTTON_LONG_PRESS_MS) {
+      btn->longPressTriggered = true;
+    }
+  }
+  
+  btn->lastPressed = reading;
+}
+
+void handleButtons() {
+  // Store previous states for edge detection BEFORE reading new states
+  bool prevButton1 = lastButton1State;
+  bool prevButton2 = lastButton2State;
+  bool prevButton3 = lastButton3State;
+  
+  // Read current button states
+  button1.pressed = digitalRead(BUTTON_PIN_1) == LOW;
+  button2.pressed = digitalRead(BUTTON_PIN_2) == LOW;
+  button3.pressed = digitalRead(BUTTON_PIN_3) == LOW;
+  
+  if (button1.pressed || button2.pressed || button3.pressed) {
+    noteUserActivity();
+  }
+  
+  // Update last states for next iteration
+  lastButton1State = button1.pressed;
+  lastButton2State = button2.pressed;
+  lastButton3State = button3.pressed;
+  
+  // Debug button states (only when they change to reduce spam)
+  static bool debugButton1 = false, debugButton2 = false, debugButton3 = false;
+  static unsigned long lastButtonDebug = 0;
+  
+  // Limit button debug messages to prevent serial overflow
+  if (millis() - lastButtonDebug > 100) { // Max one debug message per 100ms
+    if (button1.pressed != debugButton1) {
+      printfNoAlloc("🔘 Button 1: %s (Pin %d)\n", button1.pressed ? "PRESSED" : "RELEASED", BUTTON_PIN_1);
+      debugButton1 = button1.pressed;
+      lastButtonDebug = millis();
+    } else if (button2.pressed != debugButton2) {
+      printfNoAlloc("🔘 Button 2: %s (Pin %d)\n", button2.pressed ? "PRESSED" : "RELEASED", BUTTON_PIN_2);
+      debugButton2 = button2.pressed;
+      lastButtonDebug = millis();
+    } else if (button3.pressed != debugButton3) {
+      printfNoAlloc("🔘 Button 3: %s (Pin %d)\n", button3.pressed ? "PRESSED" : "RELEASED", BUTTON_PIN_3);
+      debugButton3 = button3.pressed;
+      lastButtonDebug = millis();
+    }
+  }
+
+  // Button 1 - Pattern cycling - FIXED RELEASE DETECTION
+  if (!button1.pressed && prevButton1) {
+    Serial.println("🎨 Button 1 released - processing pattern change");
+  
+  if (painterMode) {
+    // Exit painter mode
+    painterMode = false;
+    Serial.println("Exited Painter Mode - Back to Patterns");
+  } else {
+    // In pattern mode: cycle patterns (safer approach)
+    static unsigned long lastPatternChange = 0;
+    if (millis() - lastPatternChange > BUTTON_COOLDOWN_MS) {
+      // Safer pattern cycling without modulo on enums
+      switch (currentPattern) {
+        case PATTERN_PLASMA_BLOB: currentPattern = PATTERN_RAIN_MATRIX; break;
+        case PATTERN_RAIN_MATRIX: currentPattern = PATTERN_RAINBOW_WAVE; break;
+        case PATTERN_RAINBOW_WAVE: currentPattern = PATTERN_STARFIELD; break;
+        case PATTERN_STARFIELD: currentPattern = PATTERN_RIPPLES; break;
+        case PATTERN_RIPPLES: currentPattern = PATTERN_GITHUB_ACTIVITY; break;
+        case PATTERN_GITHUB_ACTIVITY:
+          // Animation and custom slots are skipped when nothing has been loaded
+          if (getAnimationCount() > 0) currentPattern = PATTERN_ANIMATION;
+          else currentPattern = isPixelVmLoaded() ? PATTERN_CUSTOM : PATTERN_OFF;
+          break;
+        case PATTERN_ANIMATION:
+          currentPattern = isPixelVmLoaded() ? PATTERN_CUSTOM : PATTERN_OFF;
+          break;
+        case PATTERN_CUSTOM: currentPattern = PATTERN_OFF; break;
+        case PATTERN_OFF: 
+        default: currentPattern = PATTERN_PLASMA_BLOB; break;
+      }
+      
+      // Pattern name lookup for better debugging with bounds checking
+      const char* patternNames[] = {
+        "Plasma Blob", "Rain Matrix", "Rainbow Wave", "Starfield", 
+        "Ripples", "GitHub Activity", "Off", "Animation", "Custom", "Unknown"
+      };
+      
+      // Bounds check for safety
+      int patternIndex = (currentPattern >= 0 && currentPattern <= 8) ? currentPattern : 9;
+      
+      printfNoAlloc("✅ Pattern changed to: %s (%d) (%.1fs since last)\n", 
+                    patternNames[patternIndex], currentPattern, 
+                    (millis() - lastPatternChange) / 1000.0);
+      
+      // Notify GitHub client if switching to/from GitHub pattern (with safety)
+      yield(); // Yield before calling external function
+      setGitHubPatternActive(currentPattern == PATTERN_GITHUB_ACTIVITY);
+      yield(); // Yield after calling external function
+      
+      // Reset pattern state timestamp (removed initializePatterns() to prevent crashes)
+      lastPatternUpdate = millis();
+      lastPatternChange = millis();
+      yield(); // Allow ESP32 to handle background tasks
+    } else {
+      // Provide feedback for ignored rapid clicks
+      printfNoAlloc("⏱️ Button click ignored - too fast (%.0fms remaining)\n", 
+                    (float)(BUTTON_COOLDOWN_MS - (long)(millis() - lastPatternChange)));
+    }
+  }
+  }
+  
+  // Button 2 - Battery display toggle - FIXED RELEASE DETECTION
+  if (!button2.pressed && prevButton2) {
+    Serial.println("🔋 Button 2 released - processing battery toggle");
+    
+    static unsigned long lastBatteryButton = 0;
+    if (millis() - lastBatteryButton > BUTTON_DEBOUNCE_MS) {
+      
+      if (painterMode) {
+        // Exit painter mode
+        painterMode = false;
+        Serial.println("Exited Painter Mode - Back to Patterns");
+      } else if (manualBatteryDisplay) {
+        // Turn battery display OFF
+        Serial.println("🔋 Manual battery display OFF");
+        manualBatteryDisplay = false;
+      } else {
+        // Turn battery display ON
+        Serial.println("🔋 Manual battery display ON");
+        manualBatteryDisplay = true;
+        batteryDisplayStartTime = millis();
+      }
+      
+      yield(); // Prevent watchdog timeout
+      lastBatteryButton = millis();
+    }
+  }
+  
+  // Button 3 - Brightness control - FIXED RELEASE DETECTION
+  if (!button3.pressed && prevButton3) {
+    Serial.println("🔆 Button 3 released - processing brightness change");
+    static unsigned long lastBrightnessButton = 0;
+    unsigned long timeSinceLastPress = millis() - lastBrightnessButton;
+    printfNoAlloc("🔆 Time since last brightness button: %lu ms (debounce: %d ms)\n", 
+                  timeSinceLastPress, BUTTON_DEBOUNCE_MS);
+    
+    if (timeSinceLastPress > BUTTON_DEBOUNCE_MS) {
+      
+      if (painterMode) {
+        // Exit painter mode
+        painterMode = false;
+        Serial.println("Exited Painter Mode - Back to Patterns");
+      } else {
+        // Cycle through brightness levels (auto -> low -> med -> high -> max -> auto)
+        printfNoAlloc("🔆 Current brightness level: %d, cycling to next...\n", manualBrightnessLevel);
+        manualBrightnessLevel = (manualBrightnessLevel + 1) % BRIGHTNESS_LEVEL_COUNT;
+        printfNoAlloc("🔆 New brightness level: %d\n", manualBrightnessLevel);
+        
+        if (manualBrightnessLevel == 0) {
+          // Auto brightness mode
+          Serial.println("💡 Brightness: AUTO (battery controlled)");
+          updateAutoDimming(); // Apply current auto-brightness
+        } else {
+          // Manual brightness mode - respect battery limits
+          float batteryPercentage = getBatteryPercentage();
+          uint8_t maxAllowedBrightness = getBatteryLimitedMaxBrightness(batteryPercentage);
+          uint8_t targetBrightness = brightnessLevels[manualBrightnessLevel];
+          
+          // Don't exceed battery-safe limits
+          if (targetBrightness > maxAllowedBrightness) {
+            targetBrightness = maxAllowedBrightness;
+          }
+          
+          setBrightness(targetBrightness);
+          yield(); // Prevent watchdog timeout
+          
+          const char* levelNames[] = {"AUTO", "LOW", "MEDIUM", "HIGH", "MAX"};
+          printfNoAlloc("💡 Brightness: %s (%d) - Battery Limited to %d (%.1f%%)\n", 
+                       levelNames[manualBrightnessLevel], targetBrightness, 
+                       maxAllowedBrightness, batteryPercentage);
+        }
+      }
+      
+      lastBrightnessButton = millis();
+    }
+  }
+}
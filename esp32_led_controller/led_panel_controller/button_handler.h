@@ -1,6 +1,7 @@
 /*
  * Button Handler Module
- * Manages button input, debouncing, and callback functions
+ * Reads the three panel buttons and acts on releases: pattern cycling,
+ * battery display toggle and brightness levels
  */
 
 #ifndef BUTTON_HANDLER_H
@@ -8,45 +9,26 @@
 
 #include "config.h"
 
-// Button states
-enum ButtonState {
-  BUTTON_RELEASED,
-  BUTTON_PRESSED,
-  BUTTON_LONG_PRESSED
-};
-
-// Button structure for tracking state
-struct Button {
-  int pin;
-  ButtonState state;
-  ButtonState lastState;
+// Button state tracking
+struct ButtonState {
+  bool pressed;
+  bool lastPressed;
   unsigned long pressTime;
   unsigned long lastDebounceTime;
   bool longPressTriggered;
 };
 
-// Button instances
-extern Button button1;  // Pattern/Mode cycling
-extern Button button2;  // Battery display toggle
-extern Button button3;  // Game mode toggle
+extern ButtonState button1;  // Pattern cycling
+extern ButtonState button2;  // Battery display toggle
+extern ButtonState button3;  // Brightness control
+
+// Battery display toggled by button 2 (timed out by the main loop)
+extern bool manualBatteryDisplay;
+extern unsigned long batteryDisplayStartTime;
 
 // Function declarations
-void initializeButtonHandler();
+void initializeButtons();
+void updateButton(ButtonState* btn, int pin);
 void handleButtons();
-void updateButton(Button* btn);
-bool isButtonPressed(int pin);
-
-// Button callback functions (implemented in main file)
-extern void onButton1ShortPress();
-extern void onButton1LongPress();
-extern void onButton2ShortPress();
-extern void onButton2LongPress();
-extern void onButton3ShortPress();
-extern void onButton3LongPress();
-
-// Interrupt handlers
-void IRAM_ATTR button1ISR();
-void IRAM_ATTR button2ISR();
-void IRAM_ATTR button3ISR();
 
-#endif // BUTTON_HANDLER_H 
\ No newline at end of file
+#endif // BUTTON_HANDLER_H
@@ -0,0 +1,188 @@
+/*
+ * Compositor Module Implementation
+ * Blends the pattern layer (displayBuffer) with overlay layers into leds[],
+ * recompositing only the regions that changed since the last frame
+ */
+
+#include "compositor.h"
+#include "led_control.h"
+
+static OverlayLayer overlayLayers[OVERLAY_LAYER_COUNT];
+static bool baseLayerVisible = true;
+static const CRGB* baseLayerSource = displayBuffer;
+static DirtyRect frameDirty;
+static uint16_t lastComposedPixels = 0;
+
+static inline void clearRect(DirtyRect& rect) {
+  rect.x0 = MATRIX_WIDTH;
+  rect.y0 = MATRIX_HEIGHT;
+  rect.x1 = -1;
+  rect.y1 = -1;
+}
+
+static inline bool isRectEmpty(const DirtyRect& rect) {
+  return rect.x0 > rect.x1 || rect.y0 > rect.y1;
+}
+
+static inline void growRect(DirtyRect& rect, int x, int y) {
+  if (x < rect.x0) rect.x0 = x;
+  if (y < rect.y0) rect.y0 = y;
+  if (x > rect.x1) rect.x1 = x;
+  if (y > rect.y1) rect.y1 = y;
+}
+
+static inline void mergeRect(DirtyRect& rect, const DirtyRect& other) {
+  if (isRectEmpty(other)) return;
+  growRect(rect, other.x0, other.y0);
+  growRect(rect, other.x1, other.y1);
+}
+
+static inline void fillRect(DirtyRect& rect) {
+  rect.x0 = 0;
+  rect.y0 = 0;
+  rect.x1 = MATRIX_WIDTH - 1;
+  rect.y1 = MATRIX_HEIGHT - 1;
+}
+
+void initializeCompositor() {
+  for (int i = 0; i < OVERLAY_LAYER_COUNT; i++) {
+    fill_solid(overlayLayers[i].pixels, NUM_LEDS, CRGB::Black);
+    overlayLayers[i].alpha = 255;
+    overlayLayers[i].visible = false;
+    clearRect(overlayLayers[i].dirty);
+    clearRect(overlayLayers[i].bounds);
+  }
+  baseLayerVisible = true;
+  fillRect(frameDirty);
+}
+
+void invalidateCompositor() {
+  fillRect(frameDirty);
+}
+
+void markBaseLayerDirty() {
+  // Patterns redraw the whole frame, so a hidden base layer has nothing to contribute
+  if (baseLayerVisible) {
+    fillRect(frameDirty);
+  }
+}
+
+void setBaseLayerVisible(bool visible) {
+  if (visible != baseLayerVisible) {
+    baseLayerVisible = visible;
+    fillRect(frameDirty);
+  }
+}
+
+void setBaseLayerSource(const CRGB* source) {
+  // Crossfades composite from a blend buffer instead of displayBuffer
+  const CRGB* newSource = (source != NULL) ? source : displayBuffer;
+  if (newSource != baseLayerSource) {
+    baseLayerSource = newSource;
+    markBaseLayerDirty();
+  }
+}
+
+void setOverlayPixel(OverlayLayerId layer, int x, int y, CRGB color) {
+  if (!isValidCoordinate(x, y)) {
+    return;
+  }
+  
+  OverlayLayer& overlay = overlayLayers[layer];
+  uint16_t index = xyToIndex(x, y);
+  
+  // Redrawing an unchanged pixel costs nothing at composite time
+  if (overlay.pixels[index] == color) {
+    return;
+  }
+  
+  overlay.pixels[index] = color;
+  growRect(overlay.dirty, x, y);
+  if (color != CRGB(CRGB::Black)) {
+    growRect(overlay.bounds, x, y);
+  }
+}
+
+void copyCanvasToOverlay(OverlayLayerId layer, const CRGB* canvas, const DirtyRect& rect) {
+  // Canvas is logical row-major (display list output); unchanged pixels stay clean
+  for (int y = max((int)rect.y0, 0); y <= min((int)rect.y1, MATRIX_HEIGHT - 1); y++) {
+    for (int x = max((int)rect.x0, 0); x <= min((int)rect.x1, MATRIX_WIDTH - 1); x++) {
+      setOverlayPixel(layer, x, y, canvas[y * MATRIX_WIDTH + x]);
+    }
+  }
+}
+
+void clearOverlay(OverlayLayerId layer) {
+  OverlayLayer& overlay = overlayLayers[layer];
+  if (isRectEmpty(overlay.bounds)) {
+    return;
+  }
+  
+  for (int y = overlay.bounds.y0; y <= overlay.bounds.y1; y++) {
+    for (int x = overlay.bounds.x0; x <= overlay.bounds.x1; x++) {
+      overlay.pixels[xyToIndex(x, y)] = CRGB::Black;
+    }
+  }
+  mergeRect(overlay.dirty, overlay.bounds);
+  clearRect(overlay.bounds);
+}
+
+void setOverlayAlpha(OverlayLayerId layer, uint8_t alpha) {
+  OverlayLayer& overlay = overlayLayers[layer];
+  if (alpha != overlay.alpha) {
+    overlay.alpha = alpha;
+    mergeRect(overlay.dirty, overlay.bounds);
+  }
+}
+
+void setOverlayVisible(OverlayLayerId layer, bool visible) {
+  OverlayLayer& overlay = overlayLayers[layer];
+  if (visible != overlay.visible) {
+    overlay.visible = visible;
+    mergeRect(overlay.dirty, overlay.bounds);
+  }
+}
+
+void composeLayers() {
+  // Union of everything that changed this frame
+  DirtyRect rect = frameDirty;
+  for (int i = 0; i < OVERLAY_LAYER_COUNT; i++) {
+    mergeRect(rect, overlayLayers[i].dirty);
+    clearRect(overlayLayers[i].dirty);
+  }
+  clearRect(frameDirty);
+  
+  if (isRectEmpty(rect)) {
+    lastComposedPixels = 0;
+    return;
+  }
+  
+  for (int y = rect.y0; y <= rect.y1; y++) {
+    for (int x = rect.x0; x <= rect.x1; x++) {
+      uint16_t index = xyToIndex(x, y);
+      CRGB color = baseLayerVisible ? baseLayerSource[index] : CRGB(CRGB::Black);
+      
+      for (int i = 0; i < OVERLAY_LAYER_COUNT; i++) {
+        const OverlayLayer& overlay = overlayLayers[i];
+        if (!overlay.visible || overlay.alpha == 0) continue;
+        
+        const CRGB& pixel = overlay.pixels[index];
+        if (!pixel) continue; // Transparent
+        
+        if (overlay.alpha == 255) {
+          color = pixel;
+        } else {
+          nblend(color, pixel, overlay.alpha);
+        }
+      }
+      
+      leds[index] = color;
+    }
+  }
+  
+  lastComposedPixels = (rect.x1 - rect.x0 + 1) * (rect.y1 - rect.y0 + 1);
+}
+
+uint16_t getLastComposedPixels() {
+  return lastComposedPixels;
+}
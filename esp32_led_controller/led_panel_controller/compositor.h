@@ -0,0 +1,54 @@
+/*
+ * Compositor Module
+ * Blends the pattern layer (displayBuffer) with overlay layers into leds[],
+ * recompositing only the regions that changed since the last frame
+ */
+
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include "config.h"
+#include <FastLED.h>
+
+// Overlay layers, bottom to top
+enum OverlayLayerId {
+  LAYER_STATUS,     // Battery icon / full-screen battery display
+  LAYER_ALERT,      // Low battery perimeter flash
+  OVERLAY_LAYER_COUNT
+};
+
+// Inclusive pixel rectangle - empty when x0 > x1
+struct DirtyRect {
+  int8_t x0, y0, x1, y1;
+};
+
+// Overlay layer - black pixels are transparent
+struct OverlayLayer {
+  CRGB pixels[NUM_LEDS];
+  uint8_t alpha;
+  bool visible;
+  DirtyRect dirty;    // Pixels changed since last composite
+  DirtyRect bounds;   // Pixels holding content (recomposited on alpha/visibility change)
+};
+
+// Function declarations
+void initializeCompositor();
+void composeLayers();
+void invalidateCompositor();
+
+// Base (pattern) layer
+void markBaseLayerDirty();
+void setBaseLayerVisible(bool visible);
+void setBaseLayerSource(const CRGB* source);
+
+// Overlay layers
+void setOverlayPixel(OverlayLayerId layer, int x, int y, CRGB color);
+void copyCanvasToOverlay(OverlayLayerId layer, const CRGB* canvas, const DirtyRect& rect);
+void clearOverlay(OverlayLayerId layer);
+void setOverlayAlpha(OverlayLayerId layer, uint8_t alpha);
+void setOverlayVisible(OverlayLayerId layer, bool visible);
+
+// Statistics
+uint16_t getLastComposedPixels();
+
+#endif // COMPOSITOR_H
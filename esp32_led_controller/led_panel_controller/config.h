@@ -36,12 +36,22 @@
 // I2C Configuration
 #define I2C_SDA_PIN 22          // I2C Data line (swapped from 21)
 #define I2C_SCL_PIN 21          // I2C Clock line (swapped from 22)
-#define I2C_FREQUENCY 100000    // 100kHz I2C frequency (reduced for better reliability)
+#define I2C_FREQUENCY 400000    // 400kHz fast mode (one bus task owns Wire, with bus recovery)
 
 // Sensor I2C Addresses
 #define MPU6050_I2C_ADDRESS 0x68
 #define MAX17048_I2C_ADDRESS 0x36
 
+// MPU6050 Sampling (on-chip FIFO, read in bursts aligned to the frame tick)
+#define MPU6050_INT_PIN 19          // MPU6050 INT → GPIO 19 data-ready (-1 = not wired, poll FIFO count)
+#define MPU6050_DLPF_CFG 3          // Digital low-pass filter: 44 Hz accel bandwidth
+#define MPU6050_SAMPLE_RATE_HZ 100  // FIFO sample rate (1 kHz / (1 + SMPLRT_DIV))
+#define MPU6050_FIFO_BATCH 6        // Samples per burst read (~16 bursts/s)
+#define MOTION_FUSION_KP 1.0        // Mahony accelerometer correction gain (higher = less gyro drift, more jitter)
+#define MOTION_FUSION_KI 0.02       // Mahony gyro bias learning gain
+#define MOTION_PREDICTION_LEAD_MS 8 // Pattern render + WS2812 transfer after the gravity read
+#define MOTION_WAKE_THRESHOLD_MG 40 // Accelerometer change that wakes the panel from idle sleep
+
 // ==================== POWER MANAGEMENT ====================
 
 // Battery Configuration
@@ -63,6 +73,21 @@
 #define BRIGHTNESS_25_PERCENT  140  // 25-10% battery (increased from 100)
 #define BRIGHTNESS_LOW_BATTERY 80   // <10% battery (increased from 50)
 
+// Idle power stages (no buttons, web requests or motion) - a bump or tilt wakes the panel
+#define ENABLE_AUTO_SLEEP 1
+#define IDLE_DIM_MS 120000UL        // Dim to IDLE_DIM_BRIGHTNESS after 2 minutes
+#define IDLE_LIGHT_SLEEP_MS 600000UL  // LEDs off, CPU in light sleep after 10 minutes
+#define IDLE_DEEP_SLEEP_MS 3600000UL  // Deep sleep after an hour (needs ENABLE_DEEP_SLEEP)
+#define IDLE_DIM_BRIGHTNESS 40
+
+// Runtime governor - set a target with /runtime-target?hours=N and brightness is
+// capped to what the measured discharge rate allows for what the panel is showing
+#define GOVERNOR_UPDATE_MS 30000
+#define GOVERNOR_BASE_DRAIN_PCT_HR 1.2  // ESP32 + WiFi with the LEDs dark (~120 mA)
+#define GOVERNOR_MIN_BRIGHTNESS 40      // Brightness floor (a target needing less is missed)
+#define GOVERNOR_CONTENT_SAMPLE_MS 500  // How often the shown frame's pixel load is sampled
+#define GOVERNOR_MAX_STEP 16            // Largest brightness change per update
+
 // Power limits
 #define MAX_POWER_MW 25000          // 25W maximum power draw
 #define POWER_LEVEL_MIN 30          // Minimum brightness for visibility
@@ -75,7 +100,10 @@
 #define FRAME_TIME_MS (1000/TARGET_FPS)
 #define PATTERN_UPDATE_MS 20        // Pattern update interval
 #define SENSOR_UPDATE_MS 15         // Sensor reading interval (balanced for responsiveness and stability)
-#define BATTERY_UPDATE_MS 5000      // Battery monitoring interval (reduced to 5s to minimize I2C conflicts)
+#define BATTERY_UPDATE_MS 5000      // Battery monitoring interval (startup, retries and ADC fallback)
+#define FUEL_GAUGE_HEARTBEAT_MS 60000 // Fuel gauge burst between SOC change alerts (x4 while hibernating)
+#define FUEL_GAUGE_HIBERNATE_RATE 4.0 // Fuel gauge hibernates below this charge rate (%/hr)
+#define FUEL_GAUGE_ACTIVE_THRESHOLD_MV 60 // ...and wakes when the cell voltage jumps this far
 
 // Button debouncing
 #define BUTTON_DEBOUNCE_MS 150      // Button debounce time (increased for stability)
@@ -106,6 +134,36 @@
 #define MAX_STARS 40
 #define MAX_FIRE_PARTICLES 64
 
+// Crossfade between patterns (0 = hard cut, changeable at runtime via /transition)
+#define PATTERN_TRANSITION_MS 600
+
+// Keyframe interpolation - smooth patterns render every Nth tick and the frames
+// in between are blended (1 = render every tick, changeable at runtime via /interpolation)
+#define PATTERN_KEYFRAME_INTERVAL 3
+#define PATTERN_KEYFRAME_INTERVAL_MAX 6
+
+// Render-ahead ring for patterns that ignore gravity (frames of stall cover:
+// 12 x 20 ms = 240 ms, 9 KB of RAM - not enough for a multi-second HTTP fetch)
+#define FRAME_QUEUE_DEPTH 12
+
+// Flash animation pack ("anim" data partition in partitions.csv)
+#define ANIMATION_PARTITION_LABEL "anim"
+#define ANIMATION_MAX_COUNT 16
+
+// Custom pattern pixel VM (uploaded via /custom-pattern, see pattern_compiler.py)
+#define PIXEL_VM_MAX_CODE 512
+
+// Adaptive resolution - plasma, rainbow and ripples render at half resolution and
+// upscale when the smoothed frame interval runs long or the battery is low
+#define ENABLE_ADAPTIVE_RENDER 1
+#define ADAPTIVE_RENDER_ENTER_MS 30          // Smoothed frame interval that drops to half resolution
+#define ADAPTIVE_RENDER_EXIT_MS 23           // Must fall below this to return to full resolution
+#define ADAPTIVE_RENDER_HOLD_MS 3000         // Minimum time between resolution switches
+#define ADAPTIVE_RENDER_BATTERY_MARGIN 5.0   // Battery must recover this far above LOW_BATTERY_THRESHOLD
+
+// Seed for pattern random generators (same seed = same animation every boot)
+#define PATTERN_RANDOM_SEED 0x4C424F58
+
 // ==================== WIFI CONFIGURATION ====================
 
 // WiFi Settings
@@ -187,6 +245,8 @@
 // Performance monitoring
 #define ENABLE_PERFORMANCE_MONITORING 1
 #define ENABLE_MEMORY_MONITORING 1
+#define ENABLE_ALLOC_GUARD 1        // Count heap allocations in render/control hot path
+#define ALLOC_GUARD_STRICT 0        // Test builds: set to 1 to halt on any hot-path allocation
 
 // ==================== UTILITY MACROS ====================
 
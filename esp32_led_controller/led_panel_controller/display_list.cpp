@@ -0,0 +1,364 @@
+/*
+ * Display List Module Implementation
+ * Compact binary drawing commands executed on the device (web /draw and
+ * built-in overlays such as the full-screen battery display)
+ */
+
+#include "display_list.h"
+
+// 3x5 glyphs, 3 bits per row top to bottom (bit 2 = left column)
+static const char fontChars[] = " !%+-./0123456789:?ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+static const uint16_t fontGlyphs[] = {
+  0x0000, 0x2482, 0x52A5, 0x05D0, 0x01C0, 0x0002, 0x12A4, 0x7B6F,
+  0x2C97, 0x73E7, 0x73CF, 0x5BC9, 0x79CF, 0x79EF, 0x7249, 0x7BEF,
+  0x7BCF, 0x0410, 0x6282, 0x2BED, 0x6BAE, 0x3923, 0x6B6E, 0x79A7,
+  0x79A4, 0x396B, 0x5BED, 0x7497, 0x126A, 0x5BAD, 0x4927, 0x5FED,
+  0x6B6D, 0x2B6A, 0x6BA4, 0x2B73, 0x6BAD, 0x388E, 0x7492, 0x5B6F,
+  0x5B6A, 0x5BFD, 0x5AAD, 0x5A92, 0x72A7
+};
+static_assert(sizeof(fontGlyphs) / sizeof(fontGlyphs[0]) == sizeof(fontChars) - 1,
+              "one glyph per font character");
+
+// Operand bytes following each opcode (variable-length tails handled separately)
+static const uint8_t operandLength[] = {
+  0,   // DL_END
+  3,   // DL_CLEAR
+  5,   // DL_PIXEL
+  7,   // DL_LINE
+  7,   // DL_RECT
+  7,   // DL_FILL_RECT
+  6,   // DL_CIRCLE
+  6,   // DL_FILL_CIRCLE
+  5,   // DL_FLOOD_FILL
+  11,  // DL_GRADIENT
+  5,   // DL_BLIT (+ w*h*3)
+  6    // DL_TEXT (+ length)
+};
+
+struct DrawContext {
+  CRGB* canvas;
+  DirtyRect touched;
+};
+
+static inline void touch(DrawContext& ctx, int x, int y) {
+  if (x < ctx.touched.x0) ctx.touched.x0 = x;
+  if (y < ctx.touched.y0) ctx.touched.y0 = y;
+  if (x > ctx.touched.x1) ctx.touched.x1 = x;
+  if (y > ctx.touched.y1) ctx.touched.y1 = y;
+}
+
+static inline void plot(DrawContext& ctx, int x, int y, const CRGB& color) {
+  if (x < 0 || x >= MATRIX_WIDTH || y < 0 || y >= MATRIX_HEIGHT) {
+    return;
+  }
+  ctx.canvas[y * MATRIX_WIDTH + x] = color;
+  touch(ctx, x, y);
+}
+
+static void horizontalSpan(DrawContext& ctx, int x0, int x1, int y, const CRGB& color) {
+  if (y < 0 || y >= MATRIX_HEIGHT) {
+    return;
+  }
+  x0 = max(x0, 0);
+  x1 = min(x1, MATRIX_WIDTH - 1);
+  if (x0 > x1) {
+    return;
+  }
+  // Rows are contiguous in the canvas, so a span is one fill
+  fill_solid(&ctx.canvas[y * MATRIX_WIDTH + x0], x1 - x0 + 1, color);
+  touch(ctx, x0, y);
+  touch(ctx, x1, y);
+}
+
+static void drawLine(DrawContext& ctx, int x0, int y0, int x1, int y1, const CRGB& color) {
+  // Bresenham
+  int dx = abs(x1 - x0);
+  int dy = -abs(y1 - y0);
+  int stepX = (x0 < x1) ? 1 : -1;
+  int stepY = (y0 < y1) ? 1 : -1;
+  int error = dx + dy;
+
+  for (;;) {
+    plot(ctx, x0, y0, color);
+    if (x0 == x1 && y0 == y1) {
+      break;
+    }
+    int doubled = 2 * error;
+    if (doubled >= dy) {
+      error += dy;
+      x0 += stepX;
+    }
+    if (doubled <= dx) {
+      error += dx;
+      y0 += stepY;
+    }
+  }
+}
+
+static void drawRect(DrawContext& ctx, int x, int y, int w, int h, const CRGB& color, bool filled) {
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  for (int row = y; row < y + h; row++) {
+    if (filled || row == y || row == y + h - 1) {
+      horizontalSpan(ctx, x, x + w - 1, row, color);
+    } else {
+      plot(ctx, x, row, color);
+      plot(ctx, x + w - 1, row, color);
+    }
+  }
+}
+
+static void drawCircle(DrawContext& ctx, int cx, int cy, int radius, const CRGB& color, bool filled) {
+  if (radius < 0) {
+    return;
+  }
+  // Midpoint circle, one octant mirrored eight ways
+  int x = radius;
+  int y = 0;
+  int error = 1 - radius;
+
+  while (x >= y) {
+    if (filled) {
+      horizontalSpan(ctx, cx - x, cx + x, cy + y, color);
+      horizontalSpan(ctx, cx - x, cx + x, cy - y, color);
+      horizontalSpan(ctx, cx - y, cx + y, cy + x, color);
+      horizontalSpan(ctx, cx - y, cx + y, cy - x, color);
+    } else {
+      plot(ctx, cx + x, cy + y, color);
+      plot(ctx, cx - x, cy + y, color);
+      plot(ctx, cx + x, cy - y, color);
+      plot(ctx, cx - x, cy - y, color);
+      plot(ctx, cx + y, cy + x, color);
+      plot(ctx, cx - y, cy + x, color);
+      plot(ctx, cx + y, cy - x, color);
+      plot(ctx, cx - y, cy - x, color);
+    }
+    y++;
+    if (error < 0) {
+      error += 2 * y + 1;
+    } else {
+      x--;
+      error += 2 * (y - x) + 1;
+    }
+  }
+}
+
+static void floodFill(DrawContext& ctx, int x, int y, const CRGB& color) {
+  if (x < 0 || x >= MATRIX_WIDTH || y < 0 || y >= MATRIX_HEIGHT) {
+    return;
+  }
+  CRGB seed = ctx.canvas[y * MATRIX_WIDTH + x];
+  if (seed == color) {
+    return;
+  }
+
+  // Each pixel is recoloured when queued, so it can be queued at most once
+  static uint16_t queue[NUM_LEDS];
+  uint16_t head = 0;
+  uint16_t tail = 0;
+  queue[tail++] = y * MATRIX_WIDTH + x;
+  plot(ctx, x, y, color);
+
+  while (head < tail) {
+    uint16_t index = queue[head++];
+    int px = index % MATRIX_WIDTH;
+    int py = index / MATRIX_WIDTH;
+    const int8_t neighbours[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+    for (int n = 0; n < 4; n++) {
+      int nx = px + neighbours[n][0];
+      int ny = py + neighbours[n][1];
+      if (nx < 0 || nx >= MATRIX_WIDTH || ny < 0 || ny >= MATRIX_HEIGHT) {
+        continue;
+      }
+      uint16_t neighbour = ny * MATRIX_WIDTH + nx;
+      if (ctx.canvas[neighbour] == seed) {
+        plot(ctx, nx, ny, color);
+        queue[tail++] = neighbour;
+      }
+    }
+  }
+}
+
+static void drawGradient(DrawContext& ctx, int x, int y, int w, int h,
+                         const CRGB& from, const CRGB& to, bool vertical) {
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  int steps = vertical ? h : w;
+  for (int i = 0; i < steps; i++) {
+    uint8_t amount = (steps > 1) ? (uint8_t)(i * 255 / (steps - 1)) : 0;
+    CRGB color = blend(from, to, amount);
+    if (vertical) {
+      horizontalSpan(ctx, x, x + w - 1, y + i, color);
+    } else {
+      for (int row = y; row < y + h; row++) {
+        plot(ctx, x + i, row, color);
+      }
+    }
+  }
+}
+
+static void drawText(DrawContext& ctx, int x, int y, const CRGB& color, const uint8_t* text, uint8_t length) {
+  for (uint8_t i = 0; i < length; i++, x += 4) {
+    char c = toupper(text[i]);
+    const char* found = (c != '\0') ? strchr(fontChars, c) : NULL;
+    if (found == NULL) {
+      continue;  // Unknown characters render as blanks
+    }
+    uint16_t glyph = fontGlyphs[found - fontChars];
+    for (int row = 0; row < 5; row++) {
+      for (int column = 0; column < 3; column++) {
+        if (glyph & (1 << (14 - row * 3 - column))) {
+          plot(ctx, x + column, y + row, color);
+        }
+      }
+    }
+  }
+}
+
+static inline CRGB readColor(const uint8_t* bytes) {
+  return CRGB(bytes[0], bytes[1], bytes[2]);
+}
+
+bool executeDisplayList(const uint8_t* commands, size_t length, CRGB* canvas, DirtyRect* touched) {
+  DrawContext ctx;
+  ctx.canvas = canvas;
+  ctx.touched.x0 = MATRIX_WIDTH;
+  ctx.touched.y0 = MATRIX_HEIGHT;
+  ctx.touched.x1 = -1;
+  ctx.touched.y1 = -1;
+
+  size_t pos = 0;
+  bool valid = true;
+
+  while (pos < length) {
+    uint8_t op = commands[pos++];
+    if (op == DL_END) {
+      break;
+    }
+    if (op >= sizeof(operandLength) || pos + operandLength[op] > length) {
+      valid = false;
+      break;
+    }
+
+    const uint8_t* args = commands + pos;
+    pos += operandLength[op];
+    int8_t a0 = (int8_t)args[0];
+    int8_t a1 = (int8_t)args[1];
+
+    switch (op) {
+      case DL_CLEAR:
+        fill_solid(canvas, NUM_LEDS, readColor(args));
+        ctx.touched.x0 = 0;
+        ctx.touched.y0 = 0;
+        ctx.touched.x1 = MATRIX_WIDTH - 1;
+        ctx.touched.y1 = MATRIX_HEIGHT - 1;
+        break;
+      case DL_PIXEL:
+        plot(ctx, a0, a1, readColor(args + 2));
+        break;
+      case DL_LINE:
+        drawLine(ctx, a0, a1, (int8_t)args[2], (int8_t)args[3], readColor(args + 4));
+        break;
+      case DL_RECT:
+      case DL_FILL_RECT:
+        drawRect(ctx, a0, a1, (int8_t)args[2], (int8_t)args[3], readColor(args + 4), op == DL_FILL_RECT);
+        break;
+      case DL_CIRCLE:
+      case DL_FILL_CIRCLE:
+        drawCircle(ctx, a0, a1, (int8_t)args[2], readColor(args + 3), op == DL_FILL_CIRCLE);
+        break;
+      case DL_FLOOD_FILL:
+        floodFill(ctx, a0, a1, readColor(args + 2));
+        break;
+      case DL_GRADIENT:
+        drawGradient(ctx, a0, a1, (int8_t)args[2], (int8_t)args[3],
+                     readColor(args + 4), readColor(args + 7), args[10] != 0);
+        break;
+      case DL_BLIT: {
+        int w = (int8_t)args[2];
+        int h = (int8_t)args[3];
+        bool transparentBlack = args[4] != 0;
+        size_t pixelBytes = (w > 0 && h > 0) ? (size_t)w * h * 3 : 0;
+        if (pos + pixelBytes > length) {
+          valid = false;
+          break;
+        }
+        const uint8_t* pixels = commands + pos;
+        pos += pixelBytes;
+        for (int row = 0; row < h; row++) {
+          for (int column = 0; column < w; column++) {
+            CRGB color = readColor(pixels + (row * w + column) * 3);
+            if (!transparentBlack || color) {
+              plot(ctx, a0 + column, a1 + row, color);
+            }
+          }
+        }
+        break;
+      }
+      case DL_TEXT: {
+        uint8_t textLength = args[5];
+        if (pos + textLength > length) {
+          valid = false;
+          break;
+        }
+        drawText(ctx, a0, a1, readColor(args + 2), commands + pos, textLength);
+        pos += textLength;
+        break;
+      }
+    }
+    if (!valid) {
+      break;
+    }
+  }
+
+  if (touched != NULL) {
+    *touched = ctx.touched;
+  }
+  return valid;
+}
+
+void beginDisplayList(DisplayListBuilder& builder, uint8_t* buffer, uint16_t capacity) {
+  builder.buffer = buffer;
+  builder.capacity = capacity;
+  builder.length = 0;
+  builder.overflow = false;
+}
+
+static void appendBytes(DisplayListBuilder& builder, const uint8_t* bytes, uint16_t count) {
+  if (builder.overflow || builder.length + count > builder.capacity) {
+    builder.overflow = true;
+    return;
+  }
+  memcpy(builder.buffer + builder.length, bytes, count);
+  builder.length += count;
+}
+
+static void appendShape(DisplayListBuilder& builder, uint8_t op, int8_t a, int8_t b, int8_t c, int8_t d,
+                        const CRGB& color) {
+  uint8_t command[8] = {op, (uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)d, color.r, color.g, color.b};
+  appendBytes(builder, command, sizeof(command));
+}
+
+void dlFillRect(DisplayListBuilder& builder, int8_t x, int8_t y, int8_t w, int8_t h, const CRGB& color) {
+  appendShape(builder, DL_FILL_RECT, x, y, w, h, color);
+}
+
+void dlRect(DisplayListBuilder& builder, int8_t x, int8_t y, int8_t w, int8_t h, const CRGB& color) {
+  appendShape(builder, DL_RECT, x, y, w, h, color);
+}
+
+void dlLine(DisplayListBuilder& builder, int8_t x0, int8_t y0, int8_t x1, int8_t y1, const CRGB& color) {
+  appendShape(builder, DL_LINE, x0, y0, x1, y1, color);
+}
+
+void dlBlit(DisplayListBuilder& builder, int8_t x, int8_t y, int8_t w, int8_t h,
+            bool transparentBlack, const uint8_t* rgb) {
+  uint8_t command[6] = {DL_BLIT, (uint8_t)x, (uint8_t)y, (uint8_t)w, (uint8_t)h, (uint8_t)(transparentBlack ? 1 : 0)};
+  appendBytes(builder, command, sizeof(command));
+  if (w > 0 && h > 0) {
+    appendBytes(builder, rgb, (uint16_t)(w * h * 3));
+  }
+}
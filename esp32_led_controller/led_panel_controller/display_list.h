@@ -0,0 +1,50 @@
+/*
+ * Display List Module
+ * Compact binary drawing commands executed on the device (web /draw and
+ * built-in overlays such as the full-screen battery display)
+ */
+
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include "config.h"
+#include <FastLED.h>
+#include "compositor.h"
+
+// Command opcodes - coordinates are int8 (may lie off the panel), colours are r,g,b bytes
+enum DisplayListOp {
+  DL_END = 0x00,          // (stop early)
+  DL_CLEAR = 0x01,        // rgb
+  DL_PIXEL = 0x02,        // x y rgb
+  DL_LINE = 0x03,         // x0 y0 x1 y1 rgb
+  DL_RECT = 0x04,         // x y w h rgb (outline)
+  DL_FILL_RECT = 0x05,    // x y w h rgb
+  DL_CIRCLE = 0x06,       // cx cy r rgb (outline)
+  DL_FILL_CIRCLE = 0x07,  // cx cy r rgb
+  DL_FLOOD_FILL = 0x08,   // x y rgb (4-connected region of the seed colour)
+  DL_GRADIENT = 0x09,     // x y w h rgb rgb vertical(0/1)
+  DL_BLIT = 0x0A,         // x y w h transparentBlack(0/1) then w*h rgb
+  DL_TEXT = 0x0B          // x y rgb length then characters (3x5 font, 4 px advance)
+};
+
+// Builder for display lists assembled on the device
+struct DisplayListBuilder {
+  uint8_t* buffer;
+  uint16_t capacity;
+  uint16_t length;
+  bool overflow;
+};
+
+// Function declarations
+// Canvas is logical row-major (x + y * MATRIX_WIDTH), not LED order.
+// Returns false on a malformed list; 'touched' (optional) receives the drawn bounds.
+bool executeDisplayList(const uint8_t* commands, size_t length, CRGB* canvas, DirtyRect* touched);
+
+void beginDisplayList(DisplayListBuilder& builder, uint8_t* buffer, uint16_t capacity);
+void dlFillRect(DisplayListBuilder& builder, int8_t x, int8_t y, int8_t w, int8_t h, const CRGB& color);
+void dlRect(DisplayListBuilder& builder, int8_t x, int8_t y, int8_t w, int8_t h, const CRGB& color);
+void dlLine(DisplayListBuilder& builder, int8_t x0, int8_t y0, int8_t x1, int8_t y1, const CRGB& color);
+void dlBlit(DisplayListBuilder& builder, int8_t x, int8_t y, int8_t w, int8_t h,
+            bool transparentBlack, const uint8_t* rgb);
+
+#endif // DISPLAY_LIST_H
@@ -0,0 +1,52 @@
+/*
+ * Fast Random Module
+ * Seedable xorshift32 generator for deterministic, replayable patterns
+ */
+
+#ifndef FAST_RANDOM_H
+#define FAST_RANDOM_H
+
+#include <Arduino.h>
+
+// Generator state - must never be zero (seedFastRandom() guarantees this)
+struct FastRandom {
+  uint32_t state;
+};
+
+inline void seedFastRandom(FastRandom& rng, uint32_t seed) {
+  // Scramble the seed so nearby seeds give unrelated sequences
+  seed ^= seed >> 16;
+  seed *= 0x7FEB352D;
+  seed ^= seed >> 15;
+  seed *= 0x846CA68B;
+  seed ^= seed >> 16;
+  rng.state = (seed != 0) ? seed : 0x9E3779B9;
+}
+
+inline uint32_t fastRandomNext(FastRandom& rng) {
+  uint32_t x = rng.state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rng.state = x;
+  return x;
+}
+
+// Same contract as Arduino random(max): returns [0, max)
+inline long fastRandom(FastRandom& rng, long maxValue) {
+  if (maxValue <= 0) {
+    return 0;
+  }
+  // Multiply-shift range reduction avoids a division in hot loops
+  return (long)(((uint64_t)fastRandomNext(rng) * (uint32_t)maxValue) >> 32);
+}
+
+// Same contract as Arduino random(min, max): returns [min, max)
+inline long fastRandom(FastRandom& rng, long minValue, long maxValue) {
+  if (minValue >= maxValue) {
+    return minValue;
+  }
+  return minValue + fastRandom(rng, maxValue - minValue);
+}
+
+#endif // FAST_RANDOM_H
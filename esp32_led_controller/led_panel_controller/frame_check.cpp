@@ -0,0 +1,287 @@
+/*
+ * Frame Check Module Implementation
+ * Golden-frame regression for pattern_engine.cpp and led_control.cpp refactors
+ */
+
+#include "frame_check.h"
+#include "frame_golden.h"
+#include "led_control.h"
+#include "github_client.h"
+#include "frame_queue.h"
+#include "alloc_guard.h"
+#include "compositor.h"
+
+static const char* frameCheckPatternNames[FRAME_CHECK_PATTERN_COUNT] = {
+  "Plasma Blob", "Rain Matrix", "Rainbow Wave", "Starfield",
+  "Ripples", "GitHub Activity", "Off", "Animation", "Custom"
+};
+
+// Q16.16 immediate for the test program
+#define VM_CONST(value) VM_PUSH, (uint8_t)(value), (uint8_t)((value) >> 8), \
+                        (uint8_t)((value) >> 16), (uint8_t)((value) >> 24)
+
+// Pinned Custom program: rings out from the centre, drifting with t and gravity x.
+// Covers registers, sqrt, sin, folding and frame hoisting; battery is live, so unused.
+static const uint8_t frameCheckProgram[] = {
+  VM_X, VM_CONST(0x78000), VM_SUB, VM_STORE, 0,                   // dx = x - 7.5
+  VM_Y, VM_CONST(0x78000), VM_SUB, VM_STORE, 1,                   // dy = y - 7.5
+  VM_LOAD, 0, VM_LOAD, 0, VM_MUL, VM_LOAD, 1, VM_LOAD, 1, VM_MUL,
+  VM_ADD, VM_SQRT, VM_STORE, 2,                                   // d = sqrt(dx^2 + dy^2)
+  VM_LOAD, 2, VM_CONST(0x1000), VM_MUL, VM_T, VM_CONST(0x4000), VM_MUL, VM_SUB,
+  VM_GRAVITY_X, VM_CONST(0x8000), VM_MUL, VM_ADD,                 // h = d/16 - t/4 + gx/2
+  VM_CONST(0x8000), VM_CONST(0x8000), VM_ADD,                     // s = 0.5 + 0.5
+  VM_LOAD, 2, VM_CONST(0xCCCD), VM_MUL, VM_T, VM_CONST(0x30000), VM_MUL, VM_SUB,
+  VM_SIN, VM_CONST(0x8000), VM_MUL, VM_CONST(0x8000), VM_ADD      // v = sin(0.8d - 3t)/2 + 1/2
+};
+
+static uint8_t frameCheckClip[FRAME_CHECK_CLIP_BYTES];
+
+static void drawClipFrame(CRGB* frame, int index) {
+  // A hue ramp on the top row (literal runs, changes every frame) over a grey
+  // fill that grows two rows per frame (repeat runs, small deltas)
+  fill_solid(frame, NUM_LEDS, CRGB::Black);
+  for (int x = 0; x < MATRIX_WIDTH; x++) {
+    frame[xyToIndex(x, 0)] = CHSV(x * 16 + index * 4, 255, 255);
+  }
+  for (int y = 1; y < MATRIX_HEIGHT && y <= 1 + index * 2; y++) {
+    uint8_t level = y * 12;
+    for (int x = 0; x < MATRIX_WIDTH; x++) {
+      frame[xyToIndex(x, y)] = CRGB(level, level, level);
+    }
+  }
+}
+
+static uint32_t buildFrameCheckClip() {
+  // One-animation pack laid out like animation_converter.py output, encoded by the
+  // player's own encoder so the check covers keyframes, deltas and the loop
+  static CRGB frames[2][NUM_LEDS];
+  AnimationPackHeader pack = {ANIMATION_PACK_MAGIC, ANIMATION_PACK_VERSION, 1};
+  AnimationPackEntry entry;
+  memset(&entry, 0, sizeof(entry));
+  strncpy(entry.name, "frame-check", ANIMATION_NAME_LENGTH);
+  entry.offset = sizeof(pack) + sizeof(entry);
+  AnimationHeader header = {ANIMATION_MAGIC, MATRIX_WIDTH, MATRIX_HEIGHT,
+                            FRAME_CHECK_CLIP_FRAMES, FRAME_CHECK_CLIP_DELAY_MS, 0};
+
+  uint32_t used = entry.offset + sizeof(header);
+  for (int i = 0; i < FRAME_CHECK_CLIP_FRAMES; i++) {
+    CRGB* frame = frames[i & 1];
+    drawClipFrame(frame, i);
+    size_t length = encodeAnimationFrame(frame, i == 0 ? NULL : frames[(i - 1) & 1],
+                                         frameCheckClip + used, sizeof(frameCheckClip) - used);
+    if (length == 0) {
+      return 0;
+    }
+    used += length;
+  }
+
+  entry.length = used - entry.offset;
+  memcpy(frameCheckClip, &pack, sizeof(pack));
+  memcpy(frameCheckClip + sizeof(pack), &entry, sizeof(entry));
+  memcpy(frameCheckClip + entry.offset, &header, sizeof(header));
+  return used;
+}
+
+bool loadFrameCheckProgram() {
+  static uint8_t program[sizeof(PixelVmHeader) + sizeof(frameCheckProgram)];
+  PixelVmHeader header = {PIXEL_VM_MAGIC, PIXEL_VM_OUTPUT_HSV, 0, sizeof(frameCheckProgram)};
+  memcpy(program, &header, sizeof(header));
+  memcpy(program + sizeof(header), frameCheckProgram, sizeof(frameCheckProgram));
+  return loadPixelVmProgram(program, sizeof(program), NULL);
+}
+
+#define FNV_OFFSET_BASIS 2166136261UL
+#define FNV_PRIME 16777619UL
+
+uint32_t hashDisplayBuffer() {
+  // Pixel-exact: any channel of any pixel changing changes the hash
+  uint32_t hash = FNV_OFFSET_BASIS;
+  for (int y = 0; y < MATRIX_HEIGHT; y++) {
+    for (int x = 0; x < MATRIX_WIDTH; x++) {
+      CRGB pixel = getLED(x, y);
+      for (int channel = 0; channel < 3; channel++) {
+        hash = (hash ^ pixel[channel]) * FNV_PRIME;
+      }
+    }
+  }
+  return hash;
+}
+
+void dumpDisplayBuffer(const char* label) {
+  // One row per line in RRGGBB hex, logical (x, y) order - diff two dumps to see changed pixels
+  Serial.printf("🖼️ Frame dump: %s\n", label);
+  for (int y = 0; y < MATRIX_HEIGHT; y++) {
+    for (int x = 0; x < MATRIX_WIDTH; x++) {
+      CRGB pixel = getLED(x, y);
+      Serial.printf("%02X%02X%02X ", pixel.r, pixel.g, pixel.b);
+    }
+    Serial.println();
+  }
+}
+
+static void printGoldenTable(const uint32_t* recorded, const bool* patternRecorded) {
+  // Printed after the whole replay so pattern log lines never land inside the table
+  Serial.println("const FrameGolden frameGolden[FRAME_CHECK_PATTERN_COUNT] = {");
+  for (int p = 0; p < FRAME_CHECK_PATTERN_COUNT; p++) {
+    if (!patternRecorded[p]) {
+      Serial.printf("  {false, {0}},  // %s\n", frameCheckPatternNames[p]);
+      continue;
+    }
+    Serial.printf("  {true, {  // %s\n", frameCheckPatternNames[p]);
+    for (int frame = 0; frame < FRAME_CHECK_FRAMES; frame++) {
+      Serial.printf("%s0x%08lX,%s", frame % 8 == 0 ? "    " : " ",
+                    (unsigned long)recorded[p * FRAME_CHECK_FRAMES + frame], frame % 8 == 7 ? "\n" : "");
+    }
+    Serial.println("  }},");
+  }
+  Serial.println("};");
+}
+
+int runFrameCheck(String& report, bool recordGolden) {
+  // Queued frames were rendered from state the replay is about to reset
+  flushFrameQueue();
+
+  // Every frame hash of every pattern (~4 KB) is held until the table is printed
+  uint32_t* recorded = NULL;
+  bool patternRecorded[FRAME_CHECK_PATTERN_COUNT] = {false};
+  if (recordGolden) {
+    recorded = (uint32_t*)malloc(FRAME_CHECK_PATTERN_COUNT * FRAME_CHECK_FRAMES * sizeof(uint32_t));
+    if (recorded == NULL) {
+      report += "FAIL - not enough heap to record the golden table\n";
+      return 1;
+    }
+  }
+
+  // Save live state so the check does not disturb the running animation
+  PatternType savedPattern = currentPattern;
+  float savedGravityX = gravityX;
+  float savedGravityY = gravityY;
+  bool savedLoading = showGitHubLoading;
+  bool savedAdaptiveRender = adaptiveRenderEnabled;
+  uint8_t savedKeyframeInterval = keyframeInterval;
+  unsigned long savedGitHubUpdate = githubActivity.lastUpdate;
+  uint8_t savedContributions[MATRIX_HEIGHT][MATRIX_WIDTH];
+  memcpy(savedContributions, githubActivity.contributionData, sizeof(savedContributions));
+  static uint8_t savedProgram[PIXEL_VM_MAX_CODE];
+  size_t savedProgramLength = copyPixelVmProgram(savedProgram, sizeof(savedProgram));
+
+  // Golden frames are recorded at full resolution with every frame rendered
+  adaptiveRenderEnabled = false;
+  setKeyframeInterval(1);
+
+  // Animation and Custom play built-in inputs, not whatever the user flashed or uploaded
+  uint32_t clipSize = buildFrameCheckClip();
+  bool clipReady = clipSize > 0 && pinAnimationPack(frameCheckClip, clipSize);
+  bool programReady = loadFrameCheckProgram();
+
+  int failures = 0;
+  
+  // Render and composite run armed exactly as in the main loop - any count is a failure
+  uint32_t patternAllocsBefore = getAllocCount(ALLOC_STAGE_PATTERN);
+  uint32_t showAllocsBefore = getAllocCount(ALLOC_STAGE_SHOW);
+
+  for (int p = 0; p < FRAME_CHECK_PATTERN_COUNT; p++) {
+    const FrameGolden& golden = frameGolden[p];
+    int failedFrame = -1;
+    int framesDiffering = 0;
+
+    if ((p == PATTERN_ANIMATION && !clipReady) || (p == PATTERN_CUSTOM && !programReady)) {
+      failures++;
+      report += String(frameCheckPatternNames[p]) + ": FAIL - built-in test input did not load\n";
+      continue;
+    }
+
+    // Pin every input the pattern can observe
+    seedPatterns(FRAME_CHECK_SEED);
+    initializePatterns();
+    setGitHubData("");
+    showGitHubLoading = false;
+    gravityX = FRAME_CHECK_GRAVITY_X;
+    gravityY = FRAME_CHECK_GRAVITY_Y;
+    currentPattern = (PatternType)p;
+    clearLEDs();
+
+    for (int frame = 0; frame < FRAME_CHECK_FRAMES; frame++) {
+      pinPatternClock(FRAME_CHECK_START_MS + (unsigned long)frame * PATTERN_UPDATE_MS);
+      armAllocGuard(ALLOC_STAGE_PATTERN);
+      updateCurrentPattern();
+      disarmAllocGuard();
+      markBaseLayerDirty();
+      armAllocGuard(ALLOC_STAGE_SHOW);
+      composeLayers();
+      disarmAllocGuard();
+
+      uint32_t hash = hashDisplayBuffer();
+      if (recordGolden) {
+        recorded[p * FRAME_CHECK_FRAMES + frame] = hash;
+      } else if (golden.recorded && hash != golden.frameHashes[frame]) {
+        framesDiffering++;
+
+        // Dump the first frame that diverges - a dump from a good build diffs against it
+        if (failedFrame < 0) {
+          failedFrame = frame;
+          String label = String(frameCheckPatternNames[p]) + " frame " + String(frame);
+          dumpDisplayBuffer(label.c_str());
+        }
+      }
+
+      if (frame % 16 == 0) {
+        yield(); // Prevent watchdog timeout during long replays
+      }
+    }
+
+    if (recordGolden) {
+      patternRecorded[p] = true;
+    } else if (!golden.recorded) {
+      failures++;
+      report += String(frameCheckPatternNames[p]) + ": FAIL - not recorded (GET /frame-check?record=1)\n";
+    } else if (failedFrame >= 0) {
+      failures++;
+      report += String(frameCheckPatternNames[p]) + ": FAIL at frame " + String(failedFrame) +
+                " - " + String(framesDiffering) + " of " + String(FRAME_CHECK_FRAMES) +
+                " frames differ (first one dumped to serial)\n";
+    } else {
+      report += String(frameCheckPatternNames[p]) + ": PASS (" + String(FRAME_CHECK_FRAMES) + " frames)\n";
+    }
+  }
+
+  uint32_t patternAllocs = getAllocCount(ALLOC_STAGE_PATTERN) - patternAllocsBefore;
+  uint32_t showAllocs = getAllocCount(ALLOC_STAGE_SHOW) - showAllocsBefore;
+  if (patternAllocs > 0 || showAllocs > 0) {
+    failures++;
+    report += "Heap: FAIL - " + String(patternAllocs) + " allocation(s) in updateCurrentPattern(), " +
+              String(showAllocs) + " in composeLayers()\n";
+  } else {
+    report += String("Heap: PASS (no allocations while rendering") +
+              (isAllocGuardExact() ? ")\n" : ", operator new only)\n");
+  }
+
+  // Restore live state
+  releasePatternClock();
+  releaseAnimationPack();
+  if (savedProgramLength > 0) {
+    loadPixelVmProgram(savedProgram, savedProgramLength, NULL);
+  } else {
+    unloadPixelVmProgram();
+  }
+  memcpy(githubActivity.contributionData, savedContributions, sizeof(savedContributions));
+  githubActivity.lastUpdate = savedGitHubUpdate;
+  showGitHubLoading = savedLoading;
+  adaptiveRenderEnabled = savedAdaptiveRender;
+  setKeyframeInterval(savedKeyframeInterval);
+  gravityX = savedGravityX;
+  gravityY = savedGravityY;
+  currentPattern = savedPattern;
+  seedPatterns(PATTERN_RANDOM_SEED);
+  initializePatterns();
+
+  if (recordGolden) {
+    // A full table is ~14 KB of text, more than a String should hold
+    printGoldenTable(recorded, patternRecorded);
+    free(recorded);
+    report += "Golden table written to serial - paste it over frame_golden.h\n";
+  }
+
+  Serial.printf("🧪 Frame check complete: %d failure(s)\n", failures);
+  return failures;
+}
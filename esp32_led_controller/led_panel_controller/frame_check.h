@@ -0,0 +1,37 @@
+/*
+ * Frame Check Module
+ * Golden-frame regression: replays every pattern with a pinned seed, clock,
+ * gravity, animation clip and VM program, and compares a hash of every frame of
+ * displayBuffer against frame_golden.h
+ */
+
+#ifndef FRAME_CHECK_H
+#define FRAME_CHECK_H
+
+#include "config.h"
+#include "pattern_engine.h"
+
+// Replay settings - changing any of these invalidates frame_golden.h
+#define FRAME_CHECK_FRAMES 120          // Frames rendered (and hashed) per pattern
+#define FRAME_CHECK_SEED 0x5EED1234     // Pinned random seed
+#define FRAME_CHECK_START_MS 100000     // Pinned clock at frame 0
+#define FRAME_CHECK_GRAVITY_X 0.25f     // Pinned tilt (slightly right, mostly down)
+#define FRAME_CHECK_GRAVITY_Y 0.75f
+#define FRAME_CHECK_CLIP_FRAMES 8       // Built-in animation clip played by the Animation entry
+#define FRAME_CHECK_CLIP_DELAY_MS 60
+#define FRAME_CHECK_CLIP_BYTES 1024
+#define FRAME_CHECK_PATTERN_COUNT (PATTERN_CUSTOM + 1)
+
+// Golden entry for one pattern - FNV-1a of each frame's RGB bytes in logical (x, y) order
+struct FrameGolden {
+  bool recorded;                                  // false = not recorded (reported as a failure)
+  uint32_t frameHashes[FRAME_CHECK_FRAMES];
+};
+
+// Function declarations
+uint32_t hashDisplayBuffer();
+int runFrameCheck(String& report, bool recordGolden);
+bool loadFrameCheckProgram();         // The pinned Custom program (replaces any uploaded one)
+void dumpDisplayBuffer(const char* label);
+
+#endif // FRAME_CHECK_H
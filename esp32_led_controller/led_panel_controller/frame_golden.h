@@ -0,0 +1,170 @@
+/*
+ * Golden Frames
+ * Per-frame hashes for frame_check.cpp. Print a new table with
+ * GET /frame-check?record=1 (or `make record` in test/frame_check) and paste it
+ * over this one after an intentional visual change.
+ * An entry with recorded = false has not been recorded and fails the check.
+ */
+
+#ifndef FRAME_GOLDEN_H
+#define FRAME_GOLDEN_H
+
+#include "frame_check.h"
+
+const FrameGolden frameGolden[FRAME_CHECK_PATTERN_COUNT] = {
+  {true, {  // Plasma Blob
+    0x27A54518, 0x000D2142, 0xB7A1A728, 0xB556514E, 0x5A3EACA8, 0x4C2DB519, 0xFE9A6697, 0xF7ABE651,
+    0xD240485C, 0x6AE729C8, 0x29441281, 0x0654DB17, 0x3E96E1A1, 0xF1DA0A50, 0xAEF16E70, 0x52357605,
+    0x53C9D888, 0xC4D27BD8, 0xCD479DC1, 0x1CB46DAC, 0x4B5946AE, 0xF3C8BADC, 0xF3C2E6FE, 0x293246F7,
+    0xBEBA197A, 0xF1D6BC88, 0x71E17B9A, 0x743D8B7E, 0x84733AA1, 0x60E23871, 0xE3E1B2FF, 0xE935F849,
+    0x93134B9A, 0x5EE171DA, 0xA1D18D80, 0x76BD2848, 0xB185BF52, 0x4351F07B, 0x7F38DC63, 0x444B6044,
+    0x8D4699CD, 0x83E8EA50, 0x76AF2B3F, 0x6CA71237, 0xFDA1DE90, 0x90ECD53A, 0xAA11825B, 0x3690F61B,
+    0x90ECD53A, 0x645C3A0D, 0x702FDAD6, 0x283F1705, 0x283F1705, 0x702FDAD6, 0x702FDAD6, 0xBDD2D410,
+    0xBDD2D410, 0xBDD2D410, 0xBDD2D410, 0xBDD2D410, 0x06AAEB97, 0x06AAEB97, 0x06AAEB97, 0x06AAEB97,
+    0x06AAEB97, 0xDEED603C, 0xDEED603C, 0xDEED603C, 0xDEED603C, 0xDEED603C, 0xFD1B3AF9, 0xFD1B3AF9,
+    0xFD1B3AF9, 0xFD1B3AF9, 0xFD1B3AF9, 0x2CED4F57, 0x2CED4F57, 0x2CED4F57, 0x2CED4F57, 0x2CED4F57,
+    0x8537C187, 0x8537C187, 0x8537C187, 0x8537C187, 0x8537C187, 0x43E56E81, 0x43E56E81, 0x43E56E81,
+    0x43E56E81, 0x43E56E81, 0x37645008, 0x37645008, 0x37645008, 0x37645008, 0x37645008, 0xCC9FC2D2,
+    0xCC9FC2D2, 0xCC9FC2D2, 0xCC9FC2D2, 0xCC9FC2D2, 0xEFC62AFB, 0xEFC62AFB, 0xEFC62AFB, 0xEFC62AFB,
+    0xEFC62AFB, 0x3138BE40, 0x3138BE40, 0x3138BE40, 0x3138BE40, 0x3138BE40, 0x6D728C04, 0x6D728C04,
+    0x6D728C04, 0x6D728C04, 0x6D728C04, 0xBA12DF28, 0xBA12DF28, 0xBA12DF28, 0xBA12DF28, 0xBA12DF28,
+  }},
+  {true, {  // Rain Matrix
+    0xF8323183, 0xA27912E5, 0xC58C7A50, 0xC944EF28, 0xF5577BEE, 0xBF595C3D, 0x6C3049B7, 0x856990E9,
+    0x34183BFC, 0x5B30BC28, 0xE0B2A96F, 0x23D912E7, 0xF297F3CE, 0x4ABF3F4A, 0xF0FD203C, 0xF6AF2695,
+    0x10BAC40B, 0xFD0E3DBB, 0x15BD2830, 0x73FC623F, 0x95183C46, 0x309D4E27, 0x38248235, 0x56B0A1F2,
+    0x11656FCE, 0x1EAABFC7, 0x4AB8A7FC, 0xF5D4EE87, 0x5EB9C2A3, 0xF672E969, 0x5FB2B149, 0x64C8A379,
+    0x76C9574F, 0x4E17E990, 0xDB9ACDB4, 0x14A68F6E, 0x013908BA, 0x0B9BF8B8, 0xE9AB91D0, 0xF88BBCD3,
+    0xA497962A, 0x7CB0C657, 0xE36B34D0, 0xB9FE44A0, 0x3F079259, 0x27F222E7, 0xED456C88, 0xB55A1901,
+    0x3BB39DA5, 0x055E531B, 0x06EC7135, 0x901D708B, 0xA4A2E9B8, 0x3178363E, 0x02BF6380, 0x7B188DD7,
+    0x46E36A43, 0x95C7C157, 0x016BC3DA, 0x71B7D9C5, 0x64CF8AA9, 0x63597C33, 0xD99E440C, 0x1DE35F54,
+    0x08978ECB, 0x74EF85BB, 0xD0E053B8, 0x6FB46E1C, 0x24421726, 0x829C958F, 0xA6F88D41, 0x40DFD161,
+    0x4280504A, 0xEF22D7D3, 0x0373760F, 0x352BF1C3, 0xBBE1CC94, 0xBF97E6FD, 0x1C4A38BA, 0x952B9266,
+    0xFD9D4039, 0x5F06D8F8, 0x274D51BD, 0x6EEFAED9, 0xF43BF4FF, 0x14B48452, 0x382EEAF0, 0x6919AE45,
+    0x6B61B0A6, 0x3A716F4A, 0xE15BF179, 0xF3AD190D, 0x5F66FFCE, 0x73C98702, 0xD5BAA73E, 0x40B1FC5B,
+    0x232F20E3, 0x7E2877EC, 0xA54088DE, 0xA8D251F7, 0x8F9BA18B, 0xBCA19EB8, 0xA76F65E3, 0xCD541EDF,
+    0x36A028FF, 0xAE26156A, 0x1620530E, 0xF4345212, 0x3E196888, 0x2A25BF95, 0xC1BA791D, 0x8841F4C8,
+    0x3258916F, 0x132DD239, 0x0D17B1F8, 0x2FD3DA20, 0xE0E86CD3, 0x6B0AA09E, 0xB6DF0911, 0x94D0E6A6,
+  }},
+  {true, {  // Rainbow Wave
+    0x6969F8F7, 0xC7774C84, 0x9F993139, 0xF167D21A, 0x682C82DB, 0x65D9B039, 0xAD8E3312, 0x181B8DC0,
+    0xC9D6CD9E, 0x69DDE07A, 0x4F7B5D7B, 0x45502DE0, 0xBDEEB294, 0x83C77DCC, 0x7366A9ED, 0x9BB2AF1F,
+    0x61868C39, 0xDC1DF072, 0x6FB62570, 0xC86F377D, 0x28E35550, 0xA6DE84D5, 0x3E180F2B, 0x58505C5E,
+    0xABAD9968, 0xF9CFE590, 0x247B1E17, 0x02A7F4EC, 0x4A07BD2D, 0x2CCC4757, 0x32B55069, 0xCEE1BC86,
+    0x7BBD1FE8, 0xA90CFDBF, 0xD1578937, 0xC107DEEE, 0xCD7C9E31, 0x9C6DBC19, 0xEE32E68B, 0x47D03DC5,
+    0x17FA96B2, 0x1B6FD585, 0xE2CB2768, 0xCEEF058E, 0x0562340D, 0x1B7A56EF, 0x4BADFD2E, 0x6211391A,
+    0xACD4BCE4, 0x79CEF6ED, 0x151B4FD7, 0x7129B82E, 0xF0B51A03, 0x2C93273A, 0x2F203530, 0x7FF4D7C0,
+    0x917BE72B, 0xF7E69762, 0x7C2F59E8, 0x045F9B71, 0xC40EA5DB, 0x927C91AC, 0x0DA1BB02, 0x75FF3E8B,
+    0x6B572271, 0xB9BC5878, 0xE7608AC2, 0xA5450983, 0xCB215977, 0xC1E2F5E7, 0x55FBAC6E, 0x2CFA2D5D,
+    0x8AA940AC, 0xD53B372B, 0xAC662B58, 0x66CDE507, 0x00F207FF, 0x42793B26, 0x50230A4E, 0x53B36B27,
+    0x9210CA3E, 0xC5B84B42, 0xE8CE6F37, 0x4B5A3A36, 0x3D15C658, 0x24224552, 0x2C9F9E70, 0x9C6961C8,
+    0xBD3B48D5, 0x59F05B56, 0x3B41A1B7, 0x41BF676D, 0x8046440C, 0x4DD1369F, 0xB64B1524, 0x1AA2FDF9,
+    0x02A33CB4, 0x56F1CABA, 0x6221029D, 0x6858E15C, 0x2B68B611, 0x6A182365, 0xCEEC9254, 0xC0C67702,
+    0x61362CE4, 0xA2B40B21, 0xF9EADBC0, 0x41DA6E61, 0x745CE7A2, 0x561E3056, 0x3A8A68C2, 0x6C0D916B,
+    0x20F4F49E, 0x6B2E9941, 0x1C10E25A, 0x5D26CE7A, 0x7A3CACE8, 0x8556654E, 0xD47C1A7B, 0xA73E54D9,
+  }},
+  {true, {  // Starfield
+    0x6992C26E, 0x1B52E8A6, 0xC0AAA493, 0xF2DD3886, 0xDBDA3BF1, 0x253C6C35, 0xC889BBE2, 0xCB5F0C07,
+    0x4F6915B1, 0x1538550B, 0xDD27C141, 0x5E575655, 0x971D0161, 0xB5788DDA, 0x9FBF1B00, 0x3DB2A53A,
+    0xB542AC97, 0xBBDAD9E3, 0x35E37A5C, 0x0CEF0F68, 0xB86F7871, 0x6ED01624, 0xA8B9BFFA, 0xFC6F7F92,
+    0x22F3E3A8, 0x969C75C1, 0x322156A8, 0xD1DC68A3, 0xA842B420, 0x5D18CA9B, 0xB1D3E96E, 0x7CAC0E51,
+    0xE6513319, 0xA9E09A6F, 0x40D54279, 0xAAE549F6, 0xDCF377BF, 0xF4F155CD, 0x2E6FC4F7, 0x01987622,
+    0x27747BBB, 0xCFA17BBD, 0xE7CA51DC, 0xDA28B6E3, 0x4A876299, 0x1AD78910, 0x71C3F8A7, 0x36817136,
+    0x75AC3AE8, 0x223C2717, 0xFF27457B, 0x8C255BB8, 0x5908BFA6, 0xE5BC4079, 0x629B4AA9, 0xFB3DC28A,
+    0x862D3506, 0x8FD3FEE5, 0xAAC1E3AC, 0x1FA47292, 0xFB8AE0E8, 0x521BAB3B, 0x64C897A0, 0x8CE729C3,
+    0x2DAC2A5F, 0x2F4E25C4, 0x9EAEB7A7, 0x5BF2D579, 0x1218D108, 0xC20A96F3, 0xAD923442, 0x6BB4CB5B,
+    0xD9C3FF07, 0x1A437FFB, 0xDE6FA971, 0x9F46FCDE, 0xF1AF766F, 0x3CB6D5D0, 0x70AB1930, 0x6F71ADA0,
+    0x9136C5DA, 0x054D7C00, 0xBEBBB471, 0x191CC758, 0x36A09FF7, 0x33151E86, 0xAC3BFA2C, 0x72C35ABD,
+    0x756B46EE, 0xCB9996F8, 0x2ECA8600, 0xED492E6A, 0xE38917B6, 0x52A74590, 0x015802AF, 0x1F2D243B,
+    0x65B46BAB, 0x757E0E71, 0x382C8AD1, 0xA5F9445D, 0x85ED83D3, 0x8A065C7C, 0x43871B3F, 0xB6C9126B,
+    0xBEE23836, 0xBB00A830, 0x1835F6F8, 0xD8F28D23, 0xE1FD20E3, 0x2E7FBE70, 0x380B7D8B, 0xB49EB33B,
+    0xE6FA8361, 0x519544A8, 0xA57CDFF6, 0xA4DE8B67, 0xBD3C26F3, 0x6EE0DA5A, 0x6E483C72, 0x992161D3,
+  }},
+  {true, {  // Ripples
+    0x116AAC84, 0x5D8472E7, 0x71D762AE, 0x0EC8DA40, 0x8C9185CD, 0xF74BF781, 0x7DFBE7DF, 0x36D6E98B,
+    0xAE74C953, 0xD747BF95, 0x9726DF5F, 0x4B9A229A, 0xC8357C53, 0x60558FC7, 0x240CB962, 0x771BDA27,
+    0xBFE60425, 0x77C80666, 0x039DC4A0, 0xC6A0F3AC, 0xB24EB82C, 0x45109D0F, 0x9C737339, 0x6F967CB1,
+    0x9AD9DE65, 0xED66FDE8, 0xAFC5EF92, 0x112755AF, 0xE6E2F80F, 0xA63F0E68, 0xB66551DF, 0x943663FE,
+    0x293BF3A9, 0x59EC6726, 0xC0AB99B4, 0x2C7234E7, 0xB3F149A0, 0x579B7CB3, 0x1066DC4F, 0xC93F11C5,
+    0xC645DC77, 0x7A2F145A, 0xBEEE0D2F, 0xAAA3E5F2, 0x067C09C6, 0xB99CFD21, 0x4DA2D36E, 0xF111F2B6,
+    0xDDE4B99B, 0xBD1DCEDF, 0x8627F3BB, 0x2177AD22, 0xCD426900, 0x39C63CFF, 0xC1CB90A6, 0x74316AC8,
+    0xCEC9A241, 0xFA964A25, 0x98F7D638, 0xF9C508C0, 0x9942D046, 0xFF3ECC09, 0x0F316936, 0xD870D099,
+    0x7E9589A5, 0x136B0763, 0xC87B9C9E, 0xD0C9B945, 0x34D60E04, 0xEA4CA4DD, 0x9466BB88, 0xA9304DA9,
+    0x01AD9827, 0x5FAEF1FD, 0xDB3EC08F, 0x813FC603, 0x1F0FB0F1, 0xB2205D56, 0x15D7E49F, 0x98EFF748,
+    0xAA1A12F6, 0xF4FBB2F8, 0xBAC464B4, 0x3065D120, 0x03237239, 0xD09A8D20, 0x6D18ABE6, 0x8DF9F37F,
+    0x3E77C8DC, 0xA76E4284, 0x52EE9375, 0x9E2DA13C, 0x20DC6909, 0x31F98965, 0xCCADF9FA, 0x0BFD300D,
+    0x66C3B583, 0x064799B9, 0xBFC64215, 0x5D81DBAD, 0xFD0A84D8, 0x1FD79F0D, 0xC25E7FDC, 0x66273193,
+    0x5C015119, 0x536EB80C, 0x56F331BC, 0x1A2E77F1, 0x84D3928F, 0x4B3A7224, 0x54D67775, 0x539D9FF6,
+    0xE1FE96B2, 0x4B06D94F, 0x45EBB819, 0x421D8967, 0x80CE43AA, 0x7A0C05BB, 0x3AFEAC12, 0x2A3E4AEC,
+  }},
+  {true, {  // GitHub Activity
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+    0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B, 0xF0EFF19B,
+  }},
+  {true, {  // Off
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+    0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5, 0xF59C39C5,
+  }},
+  {true, {  // Animation
+    0x5B394008, 0x5B394008, 0x5B394008, 0x21CAED58, 0x21CAED58, 0x21CAED58, 0x164FFA69, 0x164FFA69,
+    0x164FFA69, 0x27250388, 0x27250388, 0x27250388, 0x9577E656, 0x9577E656, 0x9577E656, 0x556B4CCA,
+    0x556B4CCA, 0x556B4CCA, 0x106B00B5, 0x106B00B5, 0x106B00B5, 0x6F465416, 0x6F465416, 0x6F465416,
+    0x5B394008, 0x5B394008, 0x5B394008, 0x21CAED58, 0x21CAED58, 0x21CAED58, 0x164FFA69, 0x164FFA69,
+    0x164FFA69, 0x27250388, 0x27250388, 0x27250388, 0x9577E656, 0x9577E656, 0x9577E656, 0x556B4CCA,
+    0x556B4CCA, 0x556B4CCA, 0x106B00B5, 0x106B00B5, 0x106B00B5, 0x6F465416, 0x6F465416, 0x6F465416,
+    0x5B394008, 0x5B394008, 0x5B394008, 0x21CAED58, 0x21CAED58, 0x21CAED58, 0x164FFA69, 0x164FFA69,
+    0x164FFA69, 0x27250388, 0x27250388, 0x27250388, 0x9577E656, 0x9577E656, 0x9577E656, 0x556B4CCA,
+    0x556B4CCA, 0x556B4CCA, 0x106B00B5, 0x106B00B5, 0x106B00B5, 0x6F465416, 0x6F465416, 0x6F465416,
+    0x5B394008, 0x5B394008, 0x5B394008, 0x21CAED58, 0x21CAED58, 0x21CAED58, 0x164FFA69, 0x164FFA69,
+    0x164FFA69, 0x27250388, 0x27250388, 0x27250388, 0x9577E656, 0x9577E656, 0x9577E656, 0x556B4CCA,
+    0x556B4CCA, 0x556B4CCA, 0x106B00B5, 0x106B00B5, 0x106B00B5, 0x6F465416, 0x6F465416, 0x6F465416,
+    0x5B394008, 0x5B394008, 0x5B394008, 0x21CAED58, 0x21CAED58, 0x21CAED58, 0x164FFA69, 0x164FFA69,
+    0x164FFA69, 0x27250388, 0x27250388, 0x27250388, 0x9577E656, 0x9577E656, 0x9577E656, 0x556B4CCA,
+    0x556B4CCA, 0x556B4CCA, 0x106B00B5, 0x106B00B5, 0x106B00B5, 0x6F465416, 0x6F465416, 0x6F465416,
+  }},
+  {true, {  // Custom
+    0xD6433DD1, 0xA3B153F5, 0xD151CB21, 0x0D8CEF65, 0x94515891, 0x12E76509, 0x22E7C805, 0xD99AAB75,
+    0x085DDA4D, 0x6FCF79C5, 0xF4E34569, 0xB3D622B1, 0x16A68E09, 0x7BB3FE79, 0xD45431ED, 0xE36266C5,
+    0x54B057D5, 0x3077E8C1, 0x1732C32D, 0xDF347B19, 0x779E0F81, 0xCAF9DF01, 0xCC3134D9, 0xF3CB8405,
+    0xB678D731, 0x6726038D, 0xD5AFAE39, 0x573C43F5, 0xB86E2E49, 0x503638D1, 0x3D617BF1, 0xC22230ED,
+    0x3A14229D, 0x0760D885, 0xFFE7F72D, 0xD42F9625, 0x224D78CD, 0xB1E0FF2D, 0x89257C31, 0xD6A2870D,
+    0x49BFEE8D, 0x9BB2F941, 0xD0D1351D, 0x3D55BF39, 0x270B7CE9, 0xBAF7E271, 0x8686B549, 0x03BEC955,
+    0x0F136FCD, 0x8B66D3A9, 0x6430F171, 0x4FFDD651, 0xDA1CAAED, 0x7F1223DD, 0xD8C9A8A1, 0x5CCF0969,
+    0xD02D831D, 0x0CE414C1, 0xD89AB0A9, 0x93188AD5, 0x4AC2D711, 0x5CFB59CD, 0x423D30C5, 0xED9FA709,
+    0x16A68D89, 0xA969BA55, 0x1A715BFD, 0x1FD53859, 0xF3FCB1F5, 0x88CC5EE9, 0xBFE014F1, 0x9ED889B9,
+    0x8CBB295D, 0x55EB6101, 0x2F6A6A3D, 0xA9F1C4CD, 0x1B2978AD, 0x133662FD, 0xA940F07D, 0xA82AB49D,
+    0xF7D98E61, 0x01F0257D, 0x057C9CF9, 0x12B30E89, 0x42A722B1, 0xB536E69D, 0x365CEC45, 0x34B388C5,
+    0xD524AF15, 0x7BB71861, 0xF9D69A0D, 0x6074CC21, 0x0B298FD1, 0xA7B52709, 0x05E033F9, 0x191DEE75,
+    0x9E0995A1, 0x1A9AF795, 0x61D9DFD5, 0xFE2DC711, 0x63A7FFB1, 0x59EC8705, 0x86A1CA65, 0xEE7B8E19,
+    0x68855C9D, 0xE0BD2C9D, 0xF007388D, 0x23740E31, 0xC20E5B81, 0x0F19754D, 0xF014133D, 0xB4D1717D,
+    0x126044E1, 0x9EC62FD1, 0x243DE015, 0x79CC0505, 0x2CCE829D, 0x4ACB3AA5, 0x511C64B5, 0x7DD7E1E1,
+  }},
+};
+
+#endif // FRAME_GOLDEN_H
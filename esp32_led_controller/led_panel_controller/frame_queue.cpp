@@ -0,0 +1,138 @@
+/*
+ * Frame Queue Module Implementation
+ * Render-ahead ring for input-independent patterns, drained by a pump task
+ * whenever the main loop stalls (fuel-gauge retries, WiFi bursts, slow handlers)
+ */
+
+#include "frame_queue.h"
+#include "led_control.h"
+#include "compositor.h"
+#include "pattern_engine.h"
+#include "web_server.h"
+
+// Loop is considered stalled once it misses this many milliseconds of ticks
+#define FRAME_QUEUE_STALL_MS (PATTERN_UPDATE_MS * 3)
+
+static CRGB frameRing[FRAME_QUEUE_DEPTH][NUM_LEDS] __attribute__((aligned(4)));
+static uint8_t frameHead = 0;
+static volatile uint8_t frameCount = 0;
+static unsigned long lastQueuedTime = 0;
+static PatternType queuedPattern = PATTERN_OFF;
+
+// Set while the loop is feeding the ring; cleared once it drains or is flushed
+static volatile bool frameQueueLive = false;
+static volatile unsigned long lastLoopTick = 0;
+
+static SemaphoreHandle_t frameOutputMutex = NULL;
+static uint32_t stallFrames = 0;
+static uint32_t underruns = 0;
+
+static void popFrame() {
+  memcpy(displayBuffer, frameRing[frameHead], sizeof(frameRing[0]));
+  frameHead = (frameHead + 1) % FRAME_QUEUE_DEPTH;
+  frameCount--;
+}
+
+static void frameQueuePumpTask(void* parameter) {
+  TickType_t lastWake = xTaskGetTickCount();
+
+  for (;;) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(PATTERN_UPDATE_MS));
+
+    if (!frameQueueLive || painterMode || millis() - lastLoopTick < FRAME_QUEUE_STALL_MS) {
+      continue;
+    }
+
+    // Never wait - if the loop holds the lock it is not stalled
+    if (xSemaphoreTake(frameOutputMutex, 0) != pdTRUE) {
+      continue;
+    }
+    if (frameQueueLive && frameCount > 0) {
+      popFrame();
+      markBaseLayerDirty();
+      showLEDs();
+      stallFrames++;
+    }
+    xSemaphoreGive(frameOutputMutex);
+  }
+}
+
+void initializeFrameQueue() {
+  frameOutputMutex = xSemaphoreCreateMutex();
+  lastLoopTick = millis();
+
+  // Core 0 - the Arduino loop (and therefore the stall) lives on core 1
+  xTaskCreatePinnedToCore(frameQueuePumpTask, "framePump", 3072, NULL, 1, NULL, 0);
+
+  Serial.printf("🎞️ Frame queue initialized (%d frames render-ahead)\n", FRAME_QUEUE_DEPTH);
+}
+
+void lockFrameOutput() {
+  if (frameOutputMutex != NULL) {
+    xSemaphoreTake(frameOutputMutex, portMAX_DELAY);
+  }
+}
+
+void unlockFrameOutput() {
+  if (frameOutputMutex != NULL) {
+    xSemaphoreGive(frameOutputMutex);
+  }
+}
+
+void noteMainLoopTick() {
+  lastLoopTick = millis();
+}
+
+bool presentQueuedFrame(bool renderingAhead) {
+  // Frames of the pattern being switched away from are dropped so the switch
+  // (and its crossfade) starts on this tick instead of after the ring drains
+  if (frameCount > 0 && queuedPattern != currentPattern) {
+    flushFrameQueue();
+  }
+  if (frameCount == 0) {
+    if (frameQueueLive && renderingAhead) {
+      underruns++;
+    }
+    frameQueueLive = false;
+    return false;
+  }
+  popFrame();
+  return true;
+}
+
+void fillFrameQueue() {
+  if (frameCount >= FRAME_QUEUE_DEPTH) {
+    return;
+  }
+
+  // Stamped with the clock time the frame will be shown at (one tick per frame
+  // already queued), so the pattern keeps wall-clock time however late the ticks run
+  unsigned long frameTime = patternMillis() + (unsigned long)(frameCount + 1) * PATTERN_UPDATE_MS;
+  if (frameCount > 0 && (long)(frameTime - lastQueuedTime) <= 0) {
+    frameTime = lastQueuedTime + 1;
+  }
+  uint8_t tail = (frameHead + frameCount) % FRAME_QUEUE_DEPTH;
+  renderFrameAt(frameRing[tail], frameTime);
+  lastQueuedTime = frameTime;
+  queuedPattern = currentPattern;
+  frameCount++;
+  frameQueueLive = true;
+}
+
+void flushFrameQueue() {
+  frameQueueLive = false;
+  frameCount = 0;
+  frameHead = 0;
+}
+
+uint8_t getFrameQueueDepth() {
+  return frameCount;
+}
+
+uint32_t getFrameQueueStallFrames() {
+  return stallFrames;
+}
+
+uint32_t getFrameQueueUnderruns() {
+  return underruns;
+}
@@ -0,0 +1,43 @@
+/*
+ * Frame Queue Module
+ * Render-ahead ring for input-independent patterns, drained by a pump task
+ * whenever the main loop stalls. Covers FRAME_QUEUE_DEPTH ticks (~240 ms):
+ * fuel-gauge retries, WiFi bursts, slow web handlers. Multi-second work (the
+ * GitHub fetch) runs on its own task and never stalls the loop.
+ */
+
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+#include "config.h"
+#include <FastLED.h>
+
+#ifndef FRAME_QUEUE_DEPTH
+#define FRAME_QUEUE_DEPTH 12
+#endif
+
+// Function declarations
+void initializeFrameQueue();
+
+// Main loop holds the output lock while it renders, shows or runs web handlers
+// (which draw, preview and replay patterns); the pump only draws when it can
+// take the lock and the loop has missed its ticks
+void lockFrameOutput();
+void unlockFrameOutput();
+void noteMainLoopTick();
+
+// Pop the next queued frame into displayBuffer. False once the ring is empty -
+// counted as an underrun if the loop was still rendering ahead. A pattern
+// switch flushes the ring first, so the new pattern starts immediately.
+bool presentQueuedFrame(bool renderingAhead);
+// Render one future frame into the ring if there is room
+void fillFrameQueue();
+// Drop queued frames - the pattern resumes ahead of what was shown, so only
+// for mode switches that hide the pattern (battery screen, painter, frame check)
+void flushFrameQueue();
+
+uint8_t getFrameQueueDepth();
+uint32_t getFrameQueueStallFrames();
+uint32_t getFrameQueueUnderruns();
+
+#endif // FRAME_QUEUE_H
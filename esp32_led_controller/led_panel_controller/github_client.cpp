@@ -5,6 +5,7 @@
 
 #include "github_client.h"
 #include "pattern_engine.h"
+#include "frame_queue.h"
 #include <WiFi.h>
 #include <HTTPClient.h>
 
@@ -15,6 +16,41 @@ bool gitHubPatternActive = false;
 bool gitHubDataLoaded = false;
 bool showGitHubLoading = false;
 
+static TaskHandle_t gitHubTask = NULL;
+
+// Parsed off to the side, then swapped in under the frame output lock so no
+// frame renders half a calendar
+static uint8_t fetchedContributions[16][16];
+
+static void commitContributions() {
+  lockFrameOutput();
+  memcpy(githubActivity.contributionData, fetchedContributions, sizeof(fetchedContributions));
+  githubActivity.username = GITHUB_USERNAME;
+  githubActivity.lastUpdate = millis();
+  unlockFrameOutput();
+}
+
+static void gitHubFetchTask(void* parameter) {
+  for (;;) {
+    // Woken by updateGitHubData() once the data is stale
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    
+    Serial.printf("🔄 Updating GitHub data for user: %s\n", GITHUB_USERNAME);
+    
+    bool success = fetchGitHubContributions(GITHUB_USERNAME);
+    
+    if (success) {
+      Serial.println("✅ GitHub data updated successfully");
+      gitHubDataLoaded = true;
+      showGitHubLoading = false; // Turn off loading animation after successful data fetch
+    } else {
+      Serial.println("❌ GitHub data update failed");
+    }
+    
+    gitHubUpdateInProgress = false;
+  }
+}
+
 void initializeGitHubClient() {
   Serial.println("[INFO] Initializing GitHub Client...");
   
@@ -28,6 +64,10 @@ void initializeGitHubClient() {
   githubActivity.username = GITHUB_USERNAME;
   githubActivity.lastUpdate = 0;
   
+  // Core 0 with WiFi - a slow or failing request never holds up rendering
+  xTaskCreatePinnedToCore(gitHubFetchTask, "github", GITHUB_TASK_STACK_SIZE, NULL,
+                          GITHUB_TASK_PRIORITY, &gitHubTask, 0);
+  
   Serial.println("[INFO] GitHub Client initialized successfully");
 }
 
@@ -46,20 +86,7 @@ void updateGitHubData() {
   }
   
   gitHubUpdateInProgress = true;
-  
-  Serial.printf("🔄 Updating GitHub data for user: %s\n", GITHUB_USERNAME);
-  
-  bool success = fetchGitHubContributions(GITHUB_USERNAME);
-  
-  if (success) {
-    Serial.println("✅ GitHub data updated successfully");
-    gitHubDataLoaded = true;
-    showGitHubLoading = false; // Turn off loading animation after successful data fetch
-  } else {
-    Serial.println("❌ GitHub data update failed");
-  }
-  
-  gitHubUpdateInProgress = false;
+  xTaskNotifyGive(gitHubTask);
 }
 
 void setGitHubPatternActive(bool active) {
@@ -73,14 +100,12 @@ void setGitHubPatternActive(bool active) {
       showGitHubLoading = true;
     }
     
-    // Trigger immediate update if data is stale
-    if (isGitHubDataStale()) {
-      updateGitHubData();
-    }
+    // Data refresh is left to the main loop's updateGitHubData() poll so that
+    // pattern switches (button handler, web handler) never block on HTTP
   } else {
     Serial.println("🎯 GitHub pattern deactivated - stopping all GitHub activity");
     showGitHubLoading = false;
-    gitHubUpdateInProgress = false; // Stop any ongoing updates
+    // A fetch already in flight finishes on its own task; no new one starts
   }
 }
 
@@ -89,7 +114,7 @@ void drawGitHubLoadingAnimation() {
   static unsigned long lastUpdate = 0;
   static int loadingStep = 0;
   
-  if (millis() - lastUpdate > 200) {
+  if (patternMillis() - lastUpdate > 200) {
     // Clear grid
     for (int y = 0; y < 16; y++) {
       for (int x = 0; x < 16; x++) {
@@ -112,7 +137,7 @@ void drawGitHubLoadingAnimation() {
     }
     
     loadingStep++;
-    lastUpdate = millis();
+    lastUpdate = patternMillis();
   }
 }
 
@@ -201,13 +226,8 @@ bool fetchGitHubContributions(const String& username) {
 bool processProxyResponse(const String& jsonResponse) {
   Serial.printf("🔍 Processing proxy response (%d bytes)...\n", jsonResponse.length());
   
-  // Clear existing GitHub activity data first to prevent stale data
-  Serial.printf("🧹 Clearing existing GitHub data before processing new response\n");
-  for (int y = 0; y < 16; y++) {
-    for (int x = 0; x < 16; x++) {
-      githubActivity.contributionData[y][x] = 0;
-    }
-  }
+  // Start from an empty grid to prevent stale data
+  memset(fetchedContributions, 0, sizeof(fetchedContributions));
   
   // Parse JSON array: [0,1,2,0,3,1,0,0,2,1,3,0,1,2,0,0...]
   // Remove brackets and split by commas
@@ -230,7 +250,7 @@ bool processProxyResponse(const String& jsonResponse) {
     int x = arrayIndex % 16;  // Column (0-15)
     int y = arrayIndex / 16;  // Row (0-11)
     
-    githubActivity.contributionData[y][x] = intensity;
+    fetchedContributions[y][x] = intensity;
     
     arrayIndex++;
     position = commaPos + 1;
@@ -240,19 +260,17 @@ bool processProxyResponse(const String& jsonResponse) {
   while (arrayIndex < 256) {
     int x = arrayIndex % 16;
     int y = arrayIndex / 16;
-    githubActivity.contributionData[y][x] = 0;
+    fetchedContributions[y][x] = 0;
     arrayIndex++;
   }
   
-  githubActivity.username = GITHUB_USERNAME;
-  githubActivity.lastUpdate = millis();
-  
   int activeDays = 0;
   for (int i = 0; i < 256; i++) {
     int x = i % 16;
     int y = i / 16;
-    if (githubActivity.contributionData[y][x] > 0) activeDays++;
+    if (fetchedContributions[y][x] > 0) activeDays++;
   }
+  commitContributions();
   
   Serial.printf("📊 Processed 256-day calendar: %d active days\n", activeDays);
   return true;
@@ -260,13 +278,8 @@ bool processProxyResponse(const String& jsonResponse) {
 
 void clearGitHubGrid() {
   Serial.printf("🧹 Clearing GitHub activity grid\n");
-  for (int y = 0; y < 16; y++) {
-    for (int x = 0; x < 16; x++) {
-      githubActivity.contributionData[y][x] = 0;
-    }
-  }
-  githubActivity.username = GITHUB_USERNAME;
-  githubActivity.lastUpdate = millis();
+  memset(fetchedContributions, 0, sizeof(fetchedContributions));
+  commitContributions();
 }
 
 unsigned long getLastGitHubUpdate() {
@@ -1,6 +1,7 @@
 /*
  * GitHub Client Module
- * Handles fetching GitHub activity data via HTTP API
+ * Handles fetching GitHub activity data via HTTP API. The fetch runs on its own
+ * task - an HTTP request takes seconds, far longer than the frame queue covers.
  */
 
 #ifndef GITHUB_CLIENT_H
@@ -16,6 +17,13 @@
 #define GITHUB_UPDATE_INTERVAL_MS (15 * 1000)  // 15 seconds in milliseconds
 #define GITHUB_USERNAME "chalabi2"
 
+#ifndef GITHUB_TASK_STACK_SIZE
+#define GITHUB_TASK_STACK_SIZE 8192     // HTTPClient plus the response String handling
+#endif
+#ifndef GITHUB_TASK_PRIORITY
+#define GITHUB_TASK_PRIORITY 1          // Below WiFi; core 0, so never in the main loop's way
+#endif
+
 // GitHub activity data structure
 struct GitHubContribution {
   String date;
@@ -24,7 +32,7 @@ struct GitHubContribution {
 
 // Function declarations
 void initializeGitHubClient();
-void updateGitHubData();
+void updateGitHubData();            // Main loop poll - wakes the fetch task, never blocks
 void setGitHubPatternActive(bool active);
 void drawGitHubLoadingAnimation();
 bool fetchGitHubContributions(const String& username);
@@ -0,0 +1,349 @@
+/*
+ * I2C Bus Module Implementation
+ * Single task owns Wire and runs queued transactions by priority and deadline,
+ * with fast-mode clocking, SCL-toggle bus recovery and per-device counters
+ */
+
+#include "i2c_bus.h"
+#include "alloc_guard.h"
+#include <Wire.h>
+
+// Wire error codes (ESP32 core: 2/3 = NACK, 4 = other bus error such as lost
+// arbitration, 5 = timeout), plus one of our own for a read that came back short
+#define I2C_ERROR_ADDRESS_NACK 2
+#define I2C_ERROR_DATA_NACK 3
+#define I2C_ERROR_BUS 4
+#define I2C_ERROR_TIMEOUT 5
+#define I2C_ERROR_SHORT_READ 6
+
+// 7-bit addresses covered by inventory sweeps
+#define I2C_FIRST_ADDRESS 1
+#define I2C_LAST_ADDRESS 126
+
+static QueueHandle_t transactionQueues[I2C_PRIORITY_COUNT] = {NULL};
+static SemaphoreHandle_t queuedTransactions = NULL;
+static portMUX_TYPE transactionMux = portMUX_INITIALIZER_UNLOCKED;
+
+static I2cDeviceStats deviceStats[I2C_DEVICE_COUNT];
+static const char* deviceNames[I2C_DEVICE_COUNT] = {"mpu6050", "max17048", "other"};
+static uint32_t busRecoveries = 0;
+static int consecutiveBusFaults = 0;   // Failed transactions in a row that saw a bus fault
+
+// Device inventory - written by the bus task, copied out by readers under the mux
+static I2cInventoryEntry inventory[I2C_INVENTORY_SIZE];
+static uint8_t inventoryCount = 0;
+static uint32_t inventorySweeps = 0;
+static portMUX_TYPE inventoryMux = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t sweepAddress = 0;                // Next address to probe, 0 between sweeps
+static unsigned long lastSweepStart = 0;
+
+// Entry for an address, added on first sight (NULL if unknown and not adding, or full)
+static I2cInventoryEntry* findInventoryEntry(uint8_t address, bool add) {
+  for (uint8_t i = 0; i < inventoryCount; i++) {
+    if (inventory[i].address == address) {
+      return &inventory[i];
+    }
+  }
+  if (!add || inventoryCount >= I2C_INVENTORY_SIZE) {
+    return NULL;
+  }
+  I2cInventoryEntry* entry = &inventory[inventoryCount++];
+  memset(entry, 0, sizeof(*entry));
+  entry->address = address;
+  return entry;
+}
+
+static void noteInventoryResult(uint8_t address, bool acknowledged) {
+  portENTER_CRITICAL(&inventoryMux);
+  I2cInventoryEntry* entry = findInventoryEntry(address, acknowledged);
+  if (entry != NULL) {
+    if (acknowledged) {
+      entry->lastSeenMs = millis();
+    } else if (entry->present) {
+      entry->missedProbes++;
+    }
+    entry->present = acknowledged;
+  }
+  portEXIT_CRITICAL(&inventoryMux);
+}
+
+static void noteInventoryError(uint8_t address) {
+  portENTER_CRITICAL(&inventoryMux);
+  I2cInventoryEntry* entry = findInventoryEntry(address, false);
+  if (entry != NULL) {
+    entry->errors++;
+  }
+  portEXIT_CRITICAL(&inventoryMux);
+}
+
+static void recoverI2cBus() {
+  // A slave stuck mid-byte holds SDA low; up to nine clocks let it finish, then a STOP
+  Wire.end();
+  pinMode(I2C_SDA_PIN, INPUT_PULLUP);
+  pinMode(I2C_SCL_PIN, OUTPUT_OPEN_DRAIN);
+  digitalWrite(I2C_SCL_PIN, HIGH);
+  for (int clock = 0; clock < 9 && digitalRead(I2C_SDA_PIN) == LOW; clock++) {
+    digitalWrite(I2C_SCL_PIN, LOW);
+    delayMicroseconds(5);
+    digitalWrite(I2C_SCL_PIN, HIGH);
+    delayMicroseconds(5);
+  }
+  pinMode(I2C_SDA_PIN, OUTPUT_OPEN_DRAIN);
+  digitalWrite(I2C_SDA_PIN, LOW);
+  delayMicroseconds(5);
+  digitalWrite(I2C_SDA_PIN, HIGH);
+  delayMicroseconds(5);
+
+  Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN, I2C_FREQUENCY);
+  Wire.setTimeOut(I2C_WIRE_TIMEOUT_MS);
+  busRecoveries++;
+  consecutiveBusFaults = 0;
+  printfNoAlloc("⚠️ I2C bus recovered (%lu recoveries)\n", (unsigned long)busRecoveries);
+}
+
+// Returns the Wire error code (0 = success)
+static uint8_t runTransactionOnce(I2cTransaction* transaction) {
+  Wire.beginTransmission(transaction->address);
+  for (uint8_t i = 0; i < transaction->writeLength; i++) {
+    Wire.write(transaction->writeData[i]);
+  }
+  if (transaction->readLength == 0) {
+    return Wire.endTransmission(true);
+  }
+
+  // Repeated start between the register write and the read
+  uint8_t error = Wire.endTransmission(false);
+  if (error != 0) {
+    return error;
+  }
+  if (Wire.requestFrom(transaction->address, transaction->readLength) != transaction->readLength) {
+    while (Wire.available()) {
+      Wire.read();
+    }
+    return I2C_ERROR_SHORT_READ;
+  }
+  for (uint8_t i = 0; i < transaction->readLength; i++) {
+    transaction->readData[i] = Wire.read();
+  }
+  return 0;
+}
+
+static void completeTransaction(I2cTransaction* transaction, I2cStatus status) {
+  I2cDeviceStats& stats = deviceStats[transaction->device];
+  uint32_t latency = micros() - transaction->submitMicros;
+  stats.transactions++;
+  stats.averageLatencyUs = (stats.averageLatencyUs == 0) ? latency : (stats.averageLatencyUs * 7 + latency) / 8;
+  if (latency > stats.maxLatencyUs) {
+    stats.maxLatencyUs = latency;
+  }
+  if (status == I2C_EXPIRED) {
+    stats.expired++;
+  }
+
+  // Critical section orders the result data before the status the owner polls
+  portENTER_CRITICAL(&transactionMux);
+  transaction->status = status;
+  portEXIT_CRITICAL(&transactionMux);
+}
+
+static bool isBusFault(uint8_t error) {
+  // A NACK means the bus works and a device declined; only a hung or contested
+  // bus is worth clocking free
+  return error == I2C_ERROR_TIMEOUT || error == I2C_ERROR_BUS;
+}
+
+static void processTransaction(I2cTransaction* transaction) {
+  I2cDeviceStats& stats = deviceStats[transaction->device];
+  bool probe = (transaction->writeLength == 0 && transaction->readLength == 0);
+  I2cStatus status = I2C_FAILED;
+  bool sawBusFault = false;
+
+  for (int attempt = 0; attempt <= I2C_MAX_RETRIES; attempt++) {
+    if ((long)(millis() - transaction->deadline) > 0) {
+      status = I2C_EXPIRED;
+      break;
+    }
+    if (attempt > 0) {
+      stats.retries++;
+    }
+
+    transaction->error = runTransactionOnce(transaction);
+    if (transaction->error == 0) {
+      noteInventoryResult(transaction->address, true);
+      status = I2C_DONE;
+      break;
+    }
+
+    // An absent device answering a probe is the expected result, not a fault
+    if (probe && transaction->error == I2C_ERROR_ADDRESS_NACK) {
+      noteInventoryResult(transaction->address, false);
+      break;
+    }
+
+    stats.errors++;
+    noteInventoryError(transaction->address);
+    sawBusFault |= isBusFault(transaction->error);
+  }
+  completeTransaction(transaction, status);
+
+  // One count per transaction, however many of its retries hit the fault
+  if (status == I2C_DONE) {
+    consecutiveBusFaults = 0;
+  } else if (sawBusFault && ++consecutiveBusFaults >= I2C_RECOVERY_THRESHOLD) {
+    recoverI2cBus();
+  }
+}
+
+static I2cTransaction* nextTransaction() {
+  I2cTransaction* transaction = NULL;
+  for (int priority = 0; priority < I2C_PRIORITY_COUNT; priority++) {
+    if (xQueueReceive(transactionQueues[priority], &transaction, 0) == pdTRUE) {
+      return transaction;
+    }
+  }
+  return NULL;
+}
+
+// One address per call; unqueued, so it only ever runs while nothing else is waiting
+static void probeInventoryAddress(uint8_t address) {
+  static I2cTransaction probe;
+  prepareI2cProbe(&probe, address);
+  probe.deadline = millis() + I2C_WIRE_TIMEOUT_MS * (I2C_MAX_RETRIES + 1);
+  probe.submitMicros = micros();
+  probe.error = 0;
+  probe.status = I2C_PENDING;
+  processTransaction(&probe);
+}
+
+static void serviceInventorySweep() {
+  if (sweepAddress == 0) {
+    if (millis() - lastSweepStart < I2C_INVENTORY_REFRESH_MS) {
+      return;
+    }
+    sweepAddress = I2C_FIRST_ADDRESS;
+    lastSweepStart = millis();
+  }
+  probeInventoryAddress(sweepAddress);
+  if (++sweepAddress > I2C_LAST_ADDRESS) {
+    sweepAddress = 0;
+    inventorySweeps++;
+  }
+}
+
+static void i2cBusTask(void* parameter) {
+  for (;;) {
+    // One count per queued transaction, so a wakeup always finds work;
+    // a whole idle slot without any goes to the background inventory sweep
+    if (xSemaphoreTake(queuedTransactions, pdMS_TO_TICKS(I2C_INVENTORY_IDLE_MS)) != pdTRUE) {
+      serviceInventorySweep();
+      continue;
+    }
+    I2cTransaction* transaction = nextTransaction();
+    if (transaction != NULL) {
+      processTransaction(transaction);
+    }
+  }
+}
+
+void initializeI2cBus() {
+  Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN, I2C_FREQUENCY);
+  Wire.setTimeOut(I2C_WIRE_TIMEOUT_MS);
+
+  for (int priority = 0; priority < I2C_PRIORITY_COUNT; priority++) {
+    transactionQueues[priority] = xQueueCreate(I2C_QUEUE_DEPTH, sizeof(I2cTransaction*));
+  }
+  queuedTransactions = xSemaphoreCreateCounting(I2C_QUEUE_DEPTH * I2C_PRIORITY_COUNT, 0);
+
+  // Inventory starts empty - the first sweep runs in idle slots right away instead
+  // of holding up boot, and sensor transfers fill in their own addresses meanwhile
+  sweepAddress = I2C_FIRST_ADDRESS;
+  lastSweepStart = millis();
+
+  // Core 0 beside the frame pump, above it so sensor reads are never starved
+  xTaskCreatePinnedToCore(i2cBusTask, "i2cBus", 3072, NULL, 2, NULL, 0);
+
+  Serial.printf("🔌 I2C bus task started (%lu kHz, inventory sweep in background)\n",
+                (unsigned long)(I2C_FREQUENCY / 1000));
+}
+
+void prepareI2cRead(I2cTransaction* transaction, I2cDevice device, uint8_t address,
+                    uint8_t reg, uint8_t length) {
+  transaction->device = device;
+  transaction->address = address;
+  transaction->writeLength = 1;
+  transaction->writeData[0] = reg;
+  transaction->readLength = min((int)length, I2C_MAX_READ);
+}
+
+void prepareI2cWrite(I2cTransaction* transaction, I2cDevice device, uint8_t address,
+                     uint8_t reg, const uint8_t* data, uint8_t length) {
+  length = min((int)length, I2C_MAX_WRITE - 1);
+  transaction->device = device;
+  transaction->address = address;
+  transaction->writeLength = length + 1;
+  transaction->writeData[0] = reg;
+  memcpy(transaction->writeData + 1, data, length);
+  transaction->readLength = 0;
+}
+
+void prepareI2cProbe(I2cTransaction* transaction, uint8_t address) {
+  transaction->device = I2C_DEVICE_OTHER;
+  transaction->address = address;
+  transaction->writeLength = 0;
+  transaction->readLength = 0;
+}
+
+bool submitI2cTransaction(I2cTransaction* transaction, I2cPriority priority, uint16_t timeoutMs) {
+  if (queuedTransactions == NULL || transaction->status == I2C_PENDING) {
+    return false;
+  }
+  transaction->deadline = millis() + timeoutMs;
+  transaction->submitMicros = micros();
+  transaction->error = 0;
+  transaction->status = I2C_PENDING;
+
+  if (xQueueSend(transactionQueues[priority], &transaction, 0) != pdTRUE) {
+    transaction->status = I2C_IDLE;
+    return false;
+  }
+  xSemaphoreGive(queuedTransactions);
+  return true;
+}
+
+bool transferI2cBlocking(I2cTransaction* transaction, I2cPriority priority, uint16_t timeoutMs) {
+  while (!submitI2cTransaction(transaction, priority, timeoutMs)) {
+    if (queuedTransactions == NULL) {
+      return false;
+    }
+    vTaskDelay(1);  // Queue full
+  }
+  // The bus task always completes what it dequeues, so this cannot wait forever
+  while (transaction->status == I2C_PENDING) {
+    vTaskDelay(1);
+  }
+  return transaction->status == I2C_DONE;
+}
+
+const char* getI2cDeviceName(I2cDevice device) {
+  return deviceNames[device];
+}
+
+const I2cDeviceStats* getI2cDeviceStats(I2cDevice device) {
+  return &deviceStats[device];
+}
+
+uint32_t getI2cBusRecoveries() {
+  return busRecoveries;
+}
+
+uint8_t getI2cInventory(I2cInventoryEntry* entries, uint8_t maxEntries) {
+  portENTER_CRITICAL(&inventoryMux);
+  uint8_t count = min(inventoryCount, maxEntries);
+  memcpy(entries, inventory, count * sizeof(I2cInventoryEntry));
+  portEXIT_CRITICAL(&inventoryMux);
+  return count;
+}
+
+uint32_t getI2cInventorySweeps() {
+  return inventorySweeps;
+}
@@ -0,0 +1,123 @@
+/*
+ * I2C Bus Module
+ * Single task owns Wire and runs queued transactions by priority and deadline,
+ * with fast-mode clocking, SCL-toggle bus recovery and per-device counters
+ */
+
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include "config.h"
+
+#ifndef I2C_QUEUE_DEPTH
+#define I2C_QUEUE_DEPTH 8           // Per priority level
+#endif
+#ifndef I2C_MAX_WRITE
+#define I2C_MAX_WRITE 4             // Register plus payload
+#endif
+#ifndef I2C_MAX_READ
+#define I2C_MAX_READ 120            // MPU6050 FIFO burst (within the 128-byte Wire buffer)
+#endif
+#ifndef I2C_MAX_RETRIES
+#define I2C_MAX_RETRIES 2           // Immediate retries while the deadline allows
+#endif
+#ifndef I2C_RECOVERY_THRESHOLD
+#define I2C_RECOVERY_THRESHOLD 3    // Transactions in a row failing on timeout or lost arbitration before recovery
+#endif
+#ifndef I2C_WIRE_TIMEOUT_MS
+#define I2C_WIRE_TIMEOUT_MS 10
+#endif
+#ifndef I2C_INVENTORY_SIZE
+#define I2C_INVENTORY_SIZE 16       // Distinct addresses remembered
+#endif
+#ifndef I2C_INVENTORY_IDLE_MS
+#define I2C_INVENTORY_IDLE_MS 5     // Bus idle this long before one background probe
+#endif
+#ifndef I2C_INVENTORY_REFRESH_MS
+#define I2C_INVENTORY_REFRESH_MS 60000UL
+#endif
+
+enum I2cDevice : uint8_t {
+  I2C_DEVICE_MPU6050,
+  I2C_DEVICE_FUEL_GAUGE,
+  I2C_DEVICE_OTHER,             // Scans and anything unregistered
+  I2C_DEVICE_COUNT
+};
+
+enum I2cPriority : uint8_t {
+  I2C_PRIORITY_HIGH,            // Frame-critical (motion)
+  I2C_PRIORITY_NORMAL,          // Periodic housekeeping (fuel gauge)
+  I2C_PRIORITY_LOW,             // Diagnostics
+  I2C_PRIORITY_COUNT
+};
+
+enum I2cStatus : uint8_t {
+  I2C_IDLE,                     // Never submitted, or result consumed by the owner
+  I2C_PENDING,
+  I2C_DONE,
+  I2C_FAILED,
+  I2C_EXPIRED                   // Deadline passed before the bus got to it
+};
+
+// Owned by the caller (static, or a zero-initialized local) and untouched until it
+// leaves I2C_PENDING. No write and no read is an address probe.
+struct I2cTransaction {
+  uint8_t address;
+  I2cDevice device;
+  uint8_t writeLength;
+  uint8_t writeData[I2C_MAX_WRITE];
+  uint8_t readLength;
+  uint8_t readData[I2C_MAX_READ];
+  unsigned long deadline;
+  unsigned long submitMicros;
+  uint8_t error;                // Wire error code of the last attempt
+  volatile I2cStatus status;
+};
+
+struct I2cDeviceStats {
+  uint32_t transactions;
+  uint32_t errors;              // Failed attempts, retries included
+  uint32_t retries;
+  uint32_t expired;
+  uint32_t averageLatencyUs;    // Submit to completion, smoothed
+  uint32_t maxLatencyUs;
+};
+
+// Every address that has ever answered, kept current by live traffic and background sweeps
+struct I2cInventoryEntry {
+  uint8_t address;
+  bool present;                 // Answered its most recent probe or transaction
+  unsigned long lastSeenMs;     // millis() of the last acknowledged transfer
+  uint32_t errors;              // Failed attempts, retries included
+  uint32_t missedProbes;        // Sweeps it did not answer
+};
+
+// Function declarations
+void initializeI2cBus();        // Also sweeps every address once for the inventory
+
+// Transaction setup (leaves status alone so a pending transaction is never clobbered)
+void prepareI2cRead(I2cTransaction* transaction, I2cDevice device, uint8_t address,
+                    uint8_t reg, uint8_t length);
+void prepareI2cWrite(I2cTransaction* transaction, I2cDevice device, uint8_t address,
+                     uint8_t reg, const uint8_t* data, uint8_t length);
+void prepareI2cProbe(I2cTransaction* transaction, uint8_t address);
+
+// Queue without waiting - false if it is still pending or the queue is full
+bool submitI2cTransaction(I2cTransaction* transaction, I2cPriority priority, uint16_t timeoutMs);
+inline bool isI2cPending(const I2cTransaction* transaction) {
+  return transaction->status == I2C_PENDING;
+}
+
+// Submit and wait for the result - setup and diagnostics only, never the frame path
+bool transferI2cBlocking(I2cTransaction* transaction, I2cPriority priority, uint16_t timeoutMs);
+
+// Statistics
+const char* getI2cDeviceName(I2cDevice device);
+const I2cDeviceStats* getI2cDeviceStats(I2cDevice device);
+uint32_t getI2cBusRecoveries();
+
+// Inventory (copied out of the cache - never touches the bus)
+uint8_t getI2cInventory(I2cInventoryEntry* entries, uint8_t maxEntries);
+uint32_t getI2cInventorySweeps();
+
+#endif // I2C_BUS_H
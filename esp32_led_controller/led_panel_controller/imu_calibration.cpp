@@ -0,0 +1,73 @@
+/*
+ * IMU Calibration Module Implementation
+ * Persists MPU6050 accelerometer offsets and gyro bias in NVS so boot can skip
+ * recalibration; records are checksummed and stamped with version and temperature
+ */
+
+#include "imu_calibration.h"
+#include <Preferences.h>
+
+#define IMU_CALIBRATION_MAGIC 0x31434D49     // "IMC1"
+#define IMU_CALIBRATION_VERSION 1            // Bump when ImuCalibration changes meaning
+
+struct ImuCalibrationRecord {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;
+  ImuCalibration calibration;
+  uint32_t checksum;
+};
+
+// FNV-1a over everything before the checksum
+static uint32_t recordChecksum(const ImuCalibrationRecord& record) {
+  const uint8_t* bytes = (const uint8_t*)&record;
+  uint32_t hash = 0x811C9DC5;
+  for (size_t i = 0; i < offsetof(ImuCalibrationRecord, checksum); i++) {
+    hash ^= bytes[i];
+    hash *= 0x01000193;
+  }
+  return hash;
+}
+
+bool loadImuCalibration(ImuCalibration& calibration) {
+  Preferences preferences;
+  if (!preferences.begin("imu", true)) {
+    return false;
+  }
+  ImuCalibrationRecord record;
+  size_t length = preferences.getBytes("calibration", &record, sizeof(record));
+  preferences.end();
+
+  if (length != sizeof(record) || record.magic != IMU_CALIBRATION_MAGIC) {
+    return false;
+  }
+  if (record.version != IMU_CALIBRATION_VERSION || record.size != sizeof(ImuCalibration)) {
+    Serial.printf("⚠️ Stored IMU calibration is version %d - recalibrating\n", record.version);
+    return false;
+  }
+  if (record.checksum != recordChecksum(record)) {
+    Serial.println("⚠️ Stored IMU calibration failed its checksum - recalibrating");
+    return false;
+  }
+
+  calibration = record.calibration;
+  return true;
+}
+
+bool saveImuCalibration(const ImuCalibration& calibration) {
+  ImuCalibrationRecord record;
+  memset(&record, 0, sizeof(record));  // Padding is part of the checksum
+  record.magic = IMU_CALIBRATION_MAGIC;
+  record.version = IMU_CALIBRATION_VERSION;
+  record.size = sizeof(ImuCalibration);
+  record.calibration = calibration;
+  record.checksum = recordChecksum(record);
+
+  Preferences preferences;
+  if (!preferences.begin("imu", false)) {
+    return false;
+  }
+  bool saved = preferences.putBytes("calibration", &record, sizeof(record)) == sizeof(record);
+  preferences.end();
+  return saved;
+}
@@ -0,0 +1,22 @@
+/*
+ * IMU Calibration Module
+ * Persists MPU6050 accelerometer offsets and gyro bias in NVS so boot can skip
+ * recalibration; records are checksummed and stamped with version and temperature
+ */
+
+#ifndef IMU_CALIBRATION_H
+#define IMU_CALIBRATION_H
+
+#include "config.h"
+
+struct ImuCalibration {
+  float accelOffset[3];         // g, removed from each accelerometer axis
+  float gyroBias[3];            // Raw counts at zero rotation
+  float temperatureC;           // Die temperature when measured
+};
+
+// Function declarations - false if there is no record or it fails validation
+bool loadImuCalibration(ImuCalibration& calibration);
+bool saveImuCalibration(const ImuCalibration& calibration);
+
+#endif // IMU_CALIBRATION_H
@@ -6,15 +6,23 @@
 #include "led_control.h"
 #include "battery_manager.h"
 #include "config.h"
+#include "alloc_guard.h"
+#include "compositor.h"
+#include "runtime_governor.h"
 
-// LED arrays
-CRGB leds[NUM_LEDS];
-CRGB displayBuffer[NUM_LEDS];
+// LED arrays (word-aligned for the packed blend kernel)
+CRGB leds[NUM_LEDS] __attribute__((aligned(4)));
+CRGB displayBuffer[NUM_LEDS] __attribute__((aligned(4)));
+CRGB* renderTarget = displayBuffer;
 
 // State variables
 uint8_t currentBrightness = BRIGHTNESS_100_PERCENT;
 bool ledPowerEnabled = true;
 
+// Manual brightness control (button 3 and /brightness)
+uint8_t manualBrightnessLevel = 0; // 0 = auto, 1-4 = manual levels
+const uint8_t brightnessLevels[BRIGHTNESS_LEVEL_COUNT] = {0, 80, 140, 180, 220}; // 0=auto, then low to high
+
 void initializeLEDs() {
   DEBUG_INFO("Initializing LED panel...");
   
@@ -29,41 +37,98 @@ void initializeLEDs() {
   // enableLEDPower();
   ledPowerEnabled = true;
   
-  // Clear display buffer
+  // Clear display buffer and overlay layers
   clearLEDs();
+  initializeCompositor();
   
   DEBUG_INFO("LED panel initialized successfully (boost converter always on)");
 }
 
 void clearLEDs() {
-  fill_solid(displayBuffer, NUM_LEDS, CRGB::Black);
+  fill_solid(renderTarget, NUM_LEDS, CRGB::Black);
 }
 
 void setLED(int x, int y, CRGB color) {
   if (isValidCoordinate(x, y)) {
-    displayBuffer[xyToIndex(x, y)] = color;
+    renderTarget[xyToIndex(x, y)] = color;
   }
 }
 
 void addLED(int x, int y, CRGB color) {
   if (isValidCoordinate(x, y)) {
-    displayBuffer[xyToIndex(x, y)] += color;
+    renderTarget[xyToIndex(x, y)] += color;
+  }
+}
+
+static inline void addScaledLED(int x, int y, const CRGB& color, uint16_t weight) {
+  if (weight == 0) {
+    return;
+  }
+  addLED(x, y, CRGB((color.r * weight) >> 8, (color.g * weight) >> 8, (color.b * weight) >> 8));
+}
+
+void addLEDSubpixel(float x, float y, CRGB color) {
+  // Entirely off-panel (also keeps the fixed-point conversion in range)
+  if (x <= -1 || x >= MATRIX_WIDTH || y <= -1 || y >= MATRIX_HEIGHT) {
+    return;
   }
+  
+  // 8.8 fixed point: the integer part picks the top-left pixel and the fraction
+  // spreads the colour over a 2x2 footprint by area coverage (Wu-style)
+  int32_t fixedX = (int32_t)floorf(x * 256.0f);
+  int32_t fixedY = (int32_t)floorf(y * 256.0f);
+  int pixelX = fixedX >> 8;
+  int pixelY = fixedY >> 8;
+  uint16_t fracX = fixedX & 0xFF;
+  uint16_t fracY = fixedY & 0xFF;
+  
+  // Weights are out of 256 and sum to (at most) 256
+  addScaledLED(pixelX, pixelY, color, ((256 - fracX) * (256 - fracY)) >> 8);
+  addScaledLED(pixelX + 1, pixelY, color, (fracX * (256 - fracY)) >> 8);
+  addScaledLED(pixelX, pixelY + 1, color, ((256 - fracX) * fracY) >> 8);
+  addScaledLED(pixelX + 1, pixelY + 1, color, (fracX * fracY) >> 8);
 }
 
 CRGB getLED(int x, int y) {
   if (isValidCoordinate(x, y)) {
-    return displayBuffer[xyToIndex(x, y)];
+    return renderTarget[xyToIndex(x, y)];
   }
   return CRGB::Black;
 }
 
+void setRenderTarget(CRGB* buffer) {
+  renderTarget = (buffer != NULL) ? buffer : displayBuffer;
+}
+
+// Whole frame must be a whole number of 32-bit words
+static_assert((NUM_LEDS * sizeof(CRGB)) % 4 == 0, "frame size must be a multiple of 4 bytes");
+
+void blendBuffers(CRGB* out, const CRGB* from, const CRGB* to, uint16_t amount) {
+  // Channel bytes are independent, so pixels are treated as a flat byte stream
+  // and lerped four bytes per word: even and odd bytes are spread into 16-bit
+  // lanes so each product (max 255 * 256) stays inside its lane.
+  const uint32_t* a = (const uint32_t*)from;
+  const uint32_t* b = (const uint32_t*)to;
+  uint32_t* o = (uint32_t*)out;
+  uint32_t wb = (amount > 256) ? 256 : amount;
+  uint32_t wa = 256 - wb;
+  
+  for (int i = 0; i < (NUM_LEDS * 3) / 4; i++) {
+    uint32_t av = a[i];
+    uint32_t bv = b[i];
+    uint32_t even = (((av & 0x00FF00FF) * wa + (bv & 0x00FF00FF) * wb) >> 8) & 0x00FF00FF;
+    uint32_t odd = (((av >> 8) & 0x00FF00FF) * wa + ((bv >> 8) & 0x00FF00FF) * wb) & 0xFF00FF00;
+    o[i] = even | odd;
+  }
+}
+
 void copyBufferToLEDs() {
   memcpy(leds, displayBuffer, sizeof(CRGB) * NUM_LEDS);
 }
 
 void showLEDs() {
-  copyBufferToLEDs();
+  // Pattern layer plus overlays, recomposited only where something changed
+  composeLayers();
   if (ledPowerEnabled) {
     FastLED.show();
   }
@@ -72,24 +137,12 @@ void showLEDs() {
 void updateAutoDimming() {
   #if ENABLE_AUTO_DIMMING
   float batteryPercentage = getBatteryPercentage();
-  uint8_t newBrightness;
-  
-  if (batteryPercentage >= 75.0) {
-    newBrightness = BRIGHTNESS_100_PERCENT;
-  } else if (batteryPercentage >= 50.0) {
-    newBrightness = BRIGHTNESS_75_PERCENT;
-  } else if (batteryPercentage >= 25.0) {
-    newBrightness = BRIGHTNESS_50_PERCENT;
-  } else if (batteryPercentage >= 10.0) {
-    newBrightness = BRIGHTNESS_25_PERCENT;
-  } else {
-    newBrightness = BRIGHTNESS_LOW_BATTERY;
-  }
+  uint8_t newBrightness = getBatteryLimitedMaxBrightness(batteryPercentage);
   
   // Only update if brightness changed
   if (newBrightness != currentBrightness) {
     setBrightness(newBrightness);
-    DEBUG_INFO("Auto-dimming: Battery " + String(batteryPercentage, 1) + "% -> Brightness " + String(newBrightness));
+    printfNoAlloc("[INFO] Auto-dimming: Battery %.1f%% -> Brightness %d\n", batteryPercentage, newBrightness);
   }
   #endif
 }
@@ -120,43 +173,49 @@ uint8_t getCurrentBrightness() {
 }
 
 uint8_t getBatteryLimitedMaxBrightness(float batteryPercentage) {
+  uint8_t limit;
   if (batteryPercentage >= 75.0) {
-    return BRIGHTNESS_100_PERCENT;
+    limit = BRIGHTNESS_100_PERCENT;
   } else if (batteryPercentage >= 50.0) {
-    return BRIGHTNESS_75_PERCENT;
+    limit = BRIGHTNESS_75_PERCENT;
   } else if (batteryPercentage >= 25.0) {
-    return BRIGHTNESS_50_PERCENT;
+    limit = BRIGHTNESS_50_PERCENT;
   } else if (batteryPercentage >= 10.0) {
-    return BRIGHTNESS_25_PERCENT;
+    limit = BRIGHTNESS_25_PERCENT;
   } else {
-    return BRIGHTNESS_LOW_BATTERY;
+    limit = BRIGHTNESS_LOW_BATTERY;
   }
+  // A runtime target can hold it lower still
+  return min(limit, getGovernorBrightnessCeiling());
 }
 
 void overlayBatteryIndicator() {
-  // This function is now replaced by showFullScreenBatteryDisplay() in main file
-  // Keeping this for compatibility but functionality moved to main file
+  // Small battery icon over the running pattern while the battery is low
+  // (full-screen display is showFullScreenBatteryDisplay() in main file)
+  static bool indicatorShown = false;
+  bool showIndicator = isLowBattery() && !getChargingStatus();
+  
+  if (showIndicator) {
+    setOverlayAlpha(LAYER_STATUS, 192);
+    setOverlayVisible(LAYER_STATUS, true);
+    drawBatteryIcon(MATRIX_WIDTH - 3, 0, getBatteryPercentage());
+  } else if (indicatorShown) {
+    clearOverlay(LAYER_STATUS);
+  }
+  indicatorShown = showIndicator;
 }
 
 void drawBatteryIcon(int x, int y, float percentage) {
-  // Simple 3x2 battery icon
+  // Simple 3x2 battery icon on the status overlay - unchanged pixels cost nothing
   CRGB outlineColor = CRGB::White;
   CRGB fillColor = (percentage > 25.0) ? CRGB::Green : CRGB::Red;
   
-  // Battery outline
-  setLED(x, y, outlineColor);
-  setLED(x + 1, y, outlineColor);
-  setLED(x, y + 1, outlineColor);
-  setLED(x + 1, y + 1, outlineColor);
-  setLED(x + 2, y, outlineColor);     // Terminal
-  
-  // Battery fill based on percentage
-  if (percentage > 50.0) {
-    setLED(x, y, fillColor);
-  }
-  if (percentage > 0.0) {
-    setLED(x + 1, y, fillColor);
-  }
+  // Battery outline, with fill based on percentage
+  setOverlayPixel(LAYER_STATUS, x, y, (percentage > 50.0) ? fillColor : outlineColor);
+  setOverlayPixel(LAYER_STATUS, x + 1, y, (percentage > 0.0) ? fillColor : outlineColor);
+  setOverlayPixel(LAYER_STATUS, x, y + 1, outlineColor);
+  setOverlayPixel(LAYER_STATUS, x + 1, y + 1, outlineColor);
+  setOverlayPixel(LAYER_STATUS, x + 2, y, outlineColor);     // Terminal
 }
 
 uint16_t xyToIndex(uint8_t x, uint8_t y) {
@@ -177,6 +236,6 @@ bool isValidCoordinate(int x, int y) {
 
 void fadeToBlack(uint8_t fadeAmount) {
   for (int i = 0; i < NUM_LEDS; i++) {
-    displayBuffer[i].fadeToBlackBy(fadeAmount);
+    renderTarget[i].fadeToBlackBy(fadeAmount);
   }
 } 
\ No newline at end of file
@@ -13,18 +13,31 @@
 extern CRGB leds[NUM_LEDS];
 extern CRGB displayBuffer[NUM_LEDS];
 
+// Buffer that clearLEDs()/setLED()/addLED()/getLED() draw into (displayBuffer by default)
+extern CRGB* renderTarget;
+
 // Current brightness and power settings
 extern uint8_t currentBrightness;
 extern bool ledPowerEnabled;
 
+// Manual brightness levels cycled by button 3 and /brightness
+#define BRIGHTNESS_LEVEL_COUNT 5
+extern uint8_t manualBrightnessLevel;   // 0 = auto, 1-4 = index into brightnessLevels
+extern const uint8_t brightnessLevels[BRIGHTNESS_LEVEL_COUNT];
+
 // Function declarations
 void initializeLEDs();
 void clearLEDs();
 void setLED(int x, int y, CRGB color);
 void addLED(int x, int y, CRGB color);
+void addLEDSubpixel(float x, float y, CRGB color);
 CRGB getLED(int x, int y);
 void copyBufferToLEDs();
 void showLEDs();
+void setRenderTarget(CRGB* buffer);
+
+// Packed lerp of two 4-byte aligned frames: amount 0 = from, 256 = to
+void blendBuffers(CRGB* out, const CRGB* from, const CRGB* to, uint16_t amount);
 
 // Power management
 void updateAutoDimming();
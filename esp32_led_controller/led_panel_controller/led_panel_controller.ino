@@ -19,6 +19,19 @@
 #include "web_server.h"
 // Game engine removed - brightness control instead
 #include "github_client.h"
+#include "alloc_guard.h"
+#include "compositor.h"
+#include "frame_queue.h"
+#include "anim_player.h"
+#include "display_list.h"
+#include "pixel_vm.h"
+#include "i2c_bus.h"
+#include "power_manager.h"
+#include "resume_state.h"
+#include "boot_timeline.h"
+#include "runtime_governor.h"
+#include "button_handler.h"
+#include "pattern_preview.h"
 
 // ==================== HARDWARE CONFIGURATION ====================
 
@@ -38,39 +51,15 @@
 
 // ==================== GLOBAL VARIABLES ====================
 
-// LED Painter mode
-extern bool painterMode;
-extern CRGB painterGrid[MATRIX_HEIGHT][MATRIX_WIDTH];
-extern uint8_t painterBrightness;
-
-// Manual brightness control variables
-uint8_t manualBrightnessLevel = 0; // 0 = auto, 1-4 = manual levels
-const uint8_t brightnessLevels[5] = {0, 80, 140, 180, 220}; // 0=auto, then low to high
-
-// Button state tracking
-struct ButtonState {
-  bool pressed;
-  bool lastPressed;
-  unsigned long pressTime;
-  unsigned long lastDebounceTime;
-  bool longPressTriggered;
-};
-
-ButtonState button1, button2, button3;
-bool lastButton1State = false;
-bool lastButton2State = false; 
-bool lastButton3State = false;
-
 // Low battery automatic warning system
 bool lowBatteryAutoDisplay = false;
 unsigned long lastLowBatteryWarning = 0;
 unsigned long startupTime = 0;
 // All constants now defined in config.h
 
-// Battery display state
-bool manualBatteryDisplay = false;
-unsigned long batteryDisplayStartTime = 0;
+// Battery display state (the manual toggle lives with button 2 in button_handler.cpp)
 unsigned long lowBatteryDisplayStartTime = 0;
+bool batteryScreenActive = false;
 
 // Charging detection
 bool chargingDetected = false;
@@ -80,29 +69,6 @@ unsigned long lastChargingCheck = 0;
 // Timing variables
 unsigned long lastFrameTime = 0;
 
-// External declarations for LED arrays (defined in led_control.cpp)
-extern CRGB leds[NUM_LEDS];
-extern CRGB displayBuffer[NUM_LEDS];
-extern uint8_t currentBrightness;
-extern bool ledPowerEnabled;
-
-// MPU6050 variables now declared in sensor_manager.cpp
-extern float gravityX, gravityY, gravityZ;
-extern float calibrationOffsetX, calibrationOffsetY, calibrationOffsetZ;
-extern bool gyroCalibrated;
-
-// Pattern variables now declared in pattern_engine.cpp
-extern PatternType currentPattern;
-extern unsigned long lastPatternUpdate;
-
-// Battery and charging status (declared in battery_manager.cpp)
-extern float batteryVoltage;
-extern float batteryPercentage;
-extern bool isCharging;
-
-// Web server instance (declared in web_server.cpp)
-extern WebServer server;
-
 // ==================== UTILITY FUNCTIONS ====================
 
 void setPixel(int x, int y, CRGB color) {
@@ -121,31 +87,23 @@ void clearDisplay() {
   clearLEDs();
 }
 
-void displayPercentageDigits(float percentage) {
+void displayPercentageDigits(float percentage, bool visible) {
   // Simple 3x5 digit patterns (just show approximate percentage)
   // For simplicity, show dots representing tens digit
-  int tens = (int)(percentage / 10);
+  int tens = visible ? (int)(percentage / 10) : 0;
   
-  // Show tens as dots along the bottom edge
-  for (int i = 0; i < tens && i < 10; i++) {
+  CRGB dotColor = CRGB::White;
+  if (percentage >= 50.0) dotColor = CRGB::Green;
+  else if (percentage >= 25.0) dotColor = CRGB::Yellow;
+  else dotColor = CRGB::Red;
+  
+  // Show tens as dots along the bottom edge (unlit dots are transparent)
+  for (int i = 0; i < 10; i++) {
     int x = 1 + i;
     if (x < MATRIX_WIDTH - 1) {
-      CRGB dotColor = CRGB::White;
-      if (percentage >= 50.0) dotColor = CRGB::Green;
-      else if (percentage >= 25.0) dotColor = CRGB::Yellow;
-      else dotColor = CRGB::Red;
-      
-      setPixel(x, MATRIX_HEIGHT - 1, dotColor);
+      setOverlayPixel(LAYER_STATUS, x, MATRIX_HEIGHT - 1, (i < tens) ? dotColor : CRGB(CRGB::Black));
     }
   }
-  
-  // Show percentage as blinking if charging (if we can detect it)
-  // This would need charging status from battery manager
-  static unsigned long lastBlink = 0;
-  if (millis() - lastBlink > 500) {
-    // Could add charging animation here
-    lastBlink = millis();
-  }
 }
 
 void checkAutomaticLowBatteryWarning() {
@@ -181,7 +139,7 @@ void checkChargingStatus() {
   chargingDetected = getChargingStatus();
 }
 
-// scanI2CDevices() now in web_server.cpp
+// countI2CDevices() now in web_server.cpp
 
 // getI2CDeviceList() now in web_server.cpp
 
@@ -212,19 +170,32 @@ void renderPainterMode() {
   }
 }
 
+// Charging lightning bolt, 3x5 centred on the battery (black is transparent)
+#define BOLT_ON 255, 255, 0
+#define BOLT_OFF 0, 0, 0
+static const uint8_t lightningBoltBitmap[5 * 3 * 3] = {
+  BOLT_OFF, BOLT_ON,  BOLT_OFF,
+  BOLT_ON,  BOLT_ON,  BOLT_ON,
+  BOLT_ON,  BOLT_ON,  BOLT_ON,
+  BOLT_OFF, BOLT_ON,  BOLT_ON,
+  BOLT_OFF, BOLT_ON,  BOLT_OFF
+};
+
 void showFullScreenBatteryDisplay() {
-  // Add safety checks and yields to prevent crashes
-  yield(); // Allow other tasks
-  
-  // Clear entire display first with bounds checking
-  for (int i = 0; i < NUM_LEDS && i < 256; i++) {
-    leds[i] = CRGB::Black;
-  }
-  
-  yield(); // Allow other tasks
-  
-  // Get battery percentage with safety check
-  float batteryPercentage = getBatteryPercentage();
+  // Battery screen replaces the pattern: hide the base layer and draw into overlays.
+  // Every pixel is written once with its final colour each frame, so the compositor
+  // only recomposites pixels that actually changed (blinks, fill level, bolt).
+  if (!batteryScreenActive) {
+    clearOverlay(LAYER_STATUS);
+    batteryScreenActive = true;
+  }
+  setBaseLayerVisible(false);
+  setOverlayAlpha(LAYER_STATUS, 255);
+  setOverlayVisible(LAYER_STATUS, true);
+  
+  // One snapshot so the gauge and the charging bolt agree
+  BatteryState battery = readSnapshot(batterySnapshot);
+  float batteryPercentage = battery.percentage;
   if (batteryPercentage < 0.0f) batteryPercentage = 0.0f;
   if (batteryPercentage > 100.0f) batteryPercentage = 100.0f;
   
@@ -237,28 +208,10 @@ void showFullScreenBatteryDisplay() {
     outlineColor = (millis() % 1000 < 500) ? CRGB::Red : CRGB(50, 0, 0);
   }
   
-  // Draw battery outline (6x10 rectangle centered)
+  // Battery outline (6x10 rectangle centered)
   int batteryX = 5, batteryY = 3;
   int batteryWidth = 6, batteryHeight = 10;
   
-  // Battery body outline - USE SAFE COORDINATE FUNCTIONS
-  yield(); // Prevent watchdog timeout
-  for (int x = batteryX; x < batteryX + batteryWidth; x++) {
-    setPixel(x, batteryY, outlineColor);                    // Top
-    setPixel(x, batteryY + batteryHeight - 1, outlineColor); // Bottom
-  }
-  yield(); // Prevent watchdog timeout
-  for (int y = batteryY; y < batteryY + batteryHeight; y++) {
-    setPixel(batteryX, y, outlineColor);                    // Left
-    setPixel(batteryX + batteryWidth - 1, y, outlineColor); // Right
-  }
-  
-  // Battery terminal (positive end) - WITH BOUNDS CHECKING
-  if (batteryY > 0) {
-    setPixel(batteryX + 2, batteryY - 1, outlineColor);
-    setPixel(batteryX + 3, batteryY - 1, outlineColor);
-  }
-  
   // Fill color based on percentage
   CRGB fillColor;
   if (batteryPercentage > 60) fillColor = CRGB::Green;
@@ -271,59 +224,59 @@ void showFullScreenBatteryDisplay() {
     fillColor = CRGB(fillColor.r / 3, fillColor.g / 3, fillColor.b / 3);
   }
   
-  // Fill battery based on percentage - USE SAFE COORDINATE FUNCTIONS
-  yield(); // Prevent watchdog timeout
   int fillHeight = (batteryHeight - 2) * batteryPercentage / 100.0;
   fillHeight = constrain(fillHeight, 0, batteryHeight - 2); // Safety clamp
+  int fillTop = batteryY + batteryHeight - 1 - fillHeight;
   
-  for (int y = 0; y < fillHeight; y++) {
-    for (int x = batteryX + 1; x < batteryX + batteryWidth - 1; x++) {
-      setPixel(x, batteryY + batteryHeight - 2 - y, fillColor);
-    }
-    if (y % 2 == 0) yield(); // Yield every few iterations
-  }
+  int centerX = batteryX + batteryWidth / 2;
+  int centerY = batteryY + batteryHeight / 2;
   
-  // Show charging indicator if charging (make it more visible)
-  if (isCharging) {
-    // Yellow lightning bolt pattern - larger and more visible
-    CRGB lightningColor = CRGB::Yellow;
-    int centerX = batteryX + batteryWidth / 2;
-    int centerY = batteryY + batteryHeight / 2;
-    
-    // Enhanced lightning bolt pattern - override any fill - USE SAFE COORDINATES
-    setPixel(centerX, centerY - 2, lightningColor);
-    setPixel(centerX - 1, centerY - 1, lightningColor);
-    setPixel(centerX, centerY - 1, lightningColor);
-    setPixel(centerX, centerY, lightningColor);
-    setPixel(centerX + 1, centerY, lightningColor);
-    setPixel(centerX, centerY + 1, lightningColor);
-    setPixel(centerX + 1, centerY + 1, lightningColor);
-    setPixel(centerX, centerY + 2, lightningColor);
-    
-    // Add sides to make it more obvious
-    setPixel(centerX - 1, centerY, lightningColor);
-    setPixel(centerX + 1, centerY - 1, lightningColor);
+  // Battery body, terminal, fill and charging bolt as one display list
+  static uint8_t batteryCommands[96];
+  DisplayListBuilder list;
+  beginDisplayList(list, batteryCommands, sizeof(batteryCommands));
+  dlFillRect(list, batteryX, batteryY - 1, batteryWidth, batteryHeight + 1, CRGB::Black);
+  dlLine(list, batteryX + 2, batteryY - 1, batteryX + 3, batteryY - 1, outlineColor);  // Terminal
+  dlRect(list, batteryX, batteryY, batteryWidth, batteryHeight, outlineColor);
+  dlFillRect(list, batteryX + 1, fillTop, batteryWidth - 2, fillHeight, fillColor);
+  if (battery.charging) {
+    dlBlit(list, centerX - 1, centerY - 2, 3, 5, true, lightningBoltBitmap);
   }
   
+  // Drawn in a canvas first so the overlay only sees each pixel's final colour
+  static CRGB batteryCanvas[NUM_LEDS];
+  DirtyRect drawn;
+  executeDisplayList(batteryCommands, list.length, batteryCanvas, &drawn);
+  copyCanvasToOverlay(LAYER_STATUS, batteryCanvas, drawn);
+  
   // Display percentage as dots only during automatic low battery warnings
   // Skip this during manual battery display to avoid conflicts
-  if (lowBatteryAutoDisplay) {
-    displayPercentageDigits(batteryPercentage);
-  }
+  displayPercentageDigits(batteryPercentage, lowBatteryAutoDisplay);
   
-  // Flash perimeter ONLY for automatic low battery warning - never during manual display
-  if (lowBatteryAutoDisplay && !manualBatteryDisplay && isLowBattery && (millis() % 600 < 300)) {
-    for (int x = 0; x < MATRIX_WIDTH; x++) {
-      setPixel(x, 0, CRGB::Red);
-      setPixel(x, MATRIX_HEIGHT - 1, CRGB::Red);
-    }
-    for (int y = 0; y < MATRIX_HEIGHT; y++) {
-      setPixel(0, y, CRGB::Red);
-      setPixel(MATRIX_WIDTH - 1, y, CRGB::Red);
-    }
+  // Flash perimeter ONLY for automatic low battery warning - never during manual display.
+  // The perimeter is drawn once on its own layer; flashing only toggles visibility.
+  for (int x = 0; x < MATRIX_WIDTH; x++) {
+    setOverlayPixel(LAYER_ALERT, x, 0, CRGB::Red);
+    setOverlayPixel(LAYER_ALERT, x, MATRIX_HEIGHT - 1, CRGB::Red);
+  }
+  for (int y = 0; y < MATRIX_HEIGHT; y++) {
+    setOverlayPixel(LAYER_ALERT, 0, y, CRGB::Red);
+    setOverlayPixel(LAYER_ALERT, MATRIX_WIDTH - 1, y, CRGB::Red);
+  }
+  setOverlayVisible(LAYER_ALERT, lowBatteryAutoDisplay && !manualBatteryDisplay && isLowBattery &&
+                                 (millis() % 600 < 300));
+}
+
+void hideFullScreenBatteryDisplay() {
+  if (!batteryScreenActive) {
+    return;
   }
   
-  yield(); // Final yield before function exit to prevent crashes
+  clearOverlay(LAYER_STATUS);
+  clearOverlay(LAYER_ALERT);
+  setOverlayVisible(LAYER_ALERT, false);
+  setBaseLayerVisible(true);
+  batteryScreenActive = false;
 }
 
 // ==================== BATTERY MANAGEMENT ====================
@@ -365,7 +318,7 @@ void emergencyShutdown() {
   esp_deep_sleep_start();
 }
 
-// overlayBatteryIndicator function moved to led_control.cpp
+// overlayBatteryIndicator function moved to led_control.cpp (draws on the compositor status layer)
 
 // ==================== MPU6050 FUNCTIONS ====================
 // MPU6050 functions now in sensor_manager.cpp
@@ -378,254 +331,24 @@ void emergencyShutdown() {
 
 // ==================== BUTTON HANDLING ====================
 
-void initializeButtons() {
-  pinMode(BUTTON_PIN_1, INPUT_PULLUP);
-  pinMode(BUTTON_PIN_2, INPUT_PULLUP);
-  pinMode(BUTTON_PIN_3, INPUT_PULLUP);
-  
-  // Initialize charging status pin for hardware-based detection (if available)
-  #ifdef CHARGING_STATUS_PIN
-  pinMode(CHARGING_STATUS_PIN, INPUT_PULLUP); // BQ25606 charging status
-  #endif
-  
-  button1.pressed = false;
-  button1.lastPressed = false;
-  button1.longPressTriggered = false;
-  
-  button2.pressed = false;
-  button2.lastPressed = false;
-  button2.longPressTriggered = false;
-  
-  button3.pressed = false;
-  button3.lastPressed = false;
-  button3.longPressTriggered = false;
-  
-  // Initialize simple state tracking
-  lastButton1State = false;
-  lastButton2State = false;
-  lastButton3State = false;
-  
-  Serial.println("Buttons initialized");
-}
-
-void updateButton(ButtonState* btn, int pin) {
-  bool reading = !digitalRead(pin); // Inverted because of pull-up
-  
-  // Store previous pressed state for release detection
-  bool prevPressed = btn->pressed;
-  
-  // Debouncing
-  if (reading != btn->lastPressed) {
-    btn->lastDebounceTime = millis();
-  }
-  
-  if ((millis() - btn->lastDebounceTime) > BUTTON_DEBOUNCE_MS) {
-    if (reading != btn->pressed) {
-      btn->pressed = reading;
-      
-      if (btn->pressed) {
-        btn->pressTime = millis();
-        btn->longPressTriggered = false;
-      }
-    }
-    
-    // Check for long press
-    if (btn->pressed && !btn->longPressTriggered && 
-        (millis() - btn->pressTime) > BUTTON_LONG_PRESS_MS) {
-      btn->longPressTriggered = true;
-    }
-  }
-  
-  btn->lastPressed = reading;
-}
-
-void handleButtons() {
-  // Store previous states for edge detection BEFORE reading new states
-  bool prevButton1 = lastButton1State;
-  bool prevButton2 = lastButton2State;
-  bool prevButton3 = lastButton3State;
-  
-  // Read current button states
-  button1.pressed = digitalRead(BUTTON_PIN_1) == LOW;
-  button2.pressed = digitalRead(BUTTON_PIN_2) == LOW;
-  button3.pressed = digitalRead(BUTTON_PIN_3) == LOW;
-  
-  // Update last states for next iteration
-  lastButton1State = button1.pressed;
-  lastButton2State = button2.pressed;
-  lastButton3State = button3.pressed;
-  
-  // Debug button states (only when they change to reduce spam)
-  static bool debugButton1 = false, debugButton2 = false, debugButton3 = false;
-  static unsigned long lastButtonDebug = 0;
-  
-  // Limit button debug messages to prevent serial overflow
-  if (millis() - lastButtonDebug > 100) { // Max one debug message per 100ms
-    if (button1.pressed != debugButton1) {
-      Serial.printf("🔘 Button 1: %s (Pin %d)\n", button1.pressed ? "PRESSED" : "RELEASED", BUTTON_PIN_1);
-      debugButton1 = button1.pressed;
-      lastButtonDebug = millis();
-    } else if (button2.pressed != debugButton2) {
-      Serial.printf("🔘 Button 2: %s (Pin %d)\n", button2.pressed ? "PRESSED" : "RELEASED", BUTTON_PIN_2);
-      debugButton2 = button2.pressed;
-      lastButtonDebug = millis();
-    } else if (button3.pressed != debugButton3) {
-      Serial.printf("🔘 Button 3: %s (Pin %d)\n", button3.pressed ? "PRESSED" : "RELEASED", BUTTON_PIN_3);
-      debugButton3 = button3.pressed;
-      lastButtonDebug = millis();
-    }
-  }
-
-  // Button 1 - Pattern cycling - FIXED RELEASE DETECTION
-  if (!button1.pressed && prevButton1) {
-    Serial.println("🎨 Button 1 released - processing pattern change");
-  
-  if (painterMode) {
-    // Exit painter mode
-    painterMode = false;
-    Serial.println("Exited Painter Mode - Back to Patterns");
-  } else {
-    // In pattern mode: cycle patterns (safer approach)
-    static unsigned long lastPatternChange = 0;
-    if (millis() - lastPatternChange > BUTTON_COOLDOWN_MS) {
-      // Safer pattern cycling without modulo on enums
-      switch (currentPattern) {
-        case PATTERN_PLASMA_BLOB: currentPattern = PATTERN_RAIN_MATRIX; break;
-        case PATTERN_RAIN_MATRIX: currentPattern = PATTERN_RAINBOW_WAVE; break;
-        case PATTERN_RAINBOW_WAVE: currentPattern = PATTERN_STARFIELD; break;
-        case PATTERN_STARFIELD: currentPattern = PATTERN_RIPPLES; break;
-        case PATTERN_RIPPLES: currentPattern = PATTERN_GITHUB_ACTIVITY; break;
-        case PATTERN_GITHUB_ACTIVITY: currentPattern = PATTERN_OFF; break;
-        case PATTERN_OFF: 
-        default: currentPattern = PATTERN_PLASMA_BLOB; break;
-      }
-      
-      // Pattern name lookup for better debugging with bounds checking
-      const char* patternNames[] = {
-        "Plasma Blob", "Rain Matrix", "Rainbow Wave", "Starfield", 
-        "Ripples", "GitHub Activity", "Off", "Unknown"
-      };
-      
-      // Bounds check for safety
-      int patternIndex = (currentPattern >= 0 && currentPattern <= 6) ? currentPattern : 7;
-      
-      Serial.printf("✅ Pattern changed to: %s (%d) (%.1fs since last)\n", 
-                    patternNames[patternIndex], currentPattern, 
-                    (millis() - lastPatternChange) / 1000.0);
-      
-      // Notify GitHub client if switching to/from GitHub pattern (with safety)
-      yield(); // Yield before calling external function
-      extern void setGitHubPatternActive(bool active);
-      setGitHubPatternActive(currentPattern == PATTERN_GITHUB_ACTIVITY);
-      yield(); // Yield after calling external function
-      
-      // Reset pattern state timestamp (removed initializePatterns() to prevent crashes)
-      lastPatternUpdate = millis();
-      lastPatternChange = millis();
-      yield(); // Allow ESP32 to handle background tasks
-    } else {
-      // Provide feedback for ignored rapid clicks
-      Serial.printf("⏱️ Button click ignored - too fast (%.0fms remaining)\n", 
-                    BUTTON_COOLDOWN_MS - (millis() - lastPatternChange));
-    }
-  }
-  }
-  
-  // Button 2 - Battery display toggle - FIXED RELEASE DETECTION
-  if (!button2.pressed && prevButton2) {
-    Serial.println("🔋 Button 2 released - processing battery toggle");
-    
-    static unsigned long lastBatteryButton = 0;
-    if (millis() - lastBatteryButton > BUTTON_DEBOUNCE_MS) {
-      
-      if (painterMode) {
-        // Exit painter mode
-        painterMode = false;
-        Serial.println("Exited Painter Mode - Back to Patterns");
-      } else if (manualBatteryDisplay) {
-        // Turn battery display OFF
-        Serial.println("🔋 Manual battery display OFF");
-        manualBatteryDisplay = false;
-      } else {
-        // Turn battery display ON
-        Serial.println("🔋 Manual battery display ON");
-        manualBatteryDisplay = true;
-        batteryDisplayStartTime = millis();
-      }
-      
-      yield(); // Prevent watchdog timeout
-      lastBatteryButton = millis();
-    }
-  }
-  
-  // Button 3 - Brightness control - FIXED RELEASE DETECTION
-  if (!button3.pressed && prevButton3) {
-    Serial.println("🔆 Button 3 released - processing brightness change");
-    static unsigned long lastBrightnessButton = 0;
-    unsigned long timeSinceLastPress = millis() - lastBrightnessButton;
-    Serial.printf("🔆 Time since last brightness button: %lu ms (debounce: %d ms)\n", 
-                  timeSinceLastPress, BUTTON_DEBOUNCE_MS);
-    
-    if (timeSinceLastPress > BUTTON_DEBOUNCE_MS) {
-      
-      if (painterMode) {
-        // Exit painter mode
-        painterMode = false;
-        Serial.println("Exited Painter Mode - Back to Patterns");
-      } else {
-        // Cycle through brightness levels (auto -> low -> med -> high -> max -> auto)
-        Serial.printf("🔆 Current brightness level: %d, cycling to next...\n", manualBrightnessLevel);
-        manualBrightnessLevel = (manualBrightnessLevel + 1) % 5;
-        Serial.printf("🔆 New brightness level: %d\n", manualBrightnessLevel);
-        
-        if (manualBrightnessLevel == 0) {
-          // Auto brightness mode
-          Serial.println("💡 Brightness: AUTO (battery controlled)");
-          updateAutoDimming(); // Apply current auto-brightness
-        } else {
-          // Manual brightness mode - respect battery limits
-          float batteryPercentage = getBatteryPercentage();
-          uint8_t maxAllowedBrightness = getBatteryLimitedMaxBrightness(batteryPercentage);
-          uint8_t targetBrightness = brightnessLevels[manualBrightnessLevel];
-          
-          // Don't exceed battery-safe limits
-          if (targetBrightness > maxAllowedBrightness) {
-            targetBrightness = maxAllowedBrightness;
-          }
-          
-          setBrightness(targetBrightness);
-          yield(); // Prevent watchdog timeout
-          
-          const char* levelNames[] = {"AUTO", "LOW", "MEDIUM", "HIGH", "MAX"};
-          Serial.printf("💡 Brightness: %s (%d) - Battery Limited to %d (%.1f%%)\n", 
-                       levelNames[manualBrightnessLevel], targetBrightness, 
-                       maxAllowedBrightness, batteryPercentage);
-        }
-      }
-      
-      lastBrightnessButton = millis();
-    }
-  }
-}
+// initializeButtons() and handleButtons() now in button_handler.cpp
 
 // Helper function moved to led_control.cpp
 
 // ==================== SENSOR UPDATE FUNCTION ====================
 
 void updateSensors() {
-  // Update gravity from MPU6050
-  updateGravity(); // from sensor_manager.cpp
+  // Drain the MPU6050 FIFO when no pattern frame is reading it (painter, battery screen)
+  serviceGravitySensor(); // from sensor_manager.cpp
   
-  // Update battery monitoring (less frequently)
-  static unsigned long lastBatteryUpdate = 0;
+  // Update battery monitoring (throttled inside; queued fuel gauge reads are collected as they finish)
   static bool batteryUpdateStarted = false;
-  if (millis() - lastBatteryUpdate > BATTERY_UPDATE_MS && millis() > 5000) { // Wait 5 seconds after startup
+  if (millis() > 5000) { // Wait 5 seconds after startup
     if (!batteryUpdateStarted) {
       Serial.println("🔋 Starting battery readings from fuel gauge (startup delay complete)");
       batteryUpdateStarted = true;
     }
     updateBatteryManager();
-    lastBatteryUpdate = millis();
   }
   
   // Sync charging status for web interface
@@ -648,69 +371,121 @@ void setup() {
   Serial.begin(115200);
   Serial.println("ESP32 LED Panel Controller Starting...");
   Serial.println("Version 2.0 - Production Ready");
+  markBootPhase("setup");
+  
+  // Start counting hot-path heap allocations
+  initializeAllocGuard();
   
-  // Initialize I2C
-  Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN, I2C_FREQUENCY);
+  // Initialize I2C - the bus task owns Wire from here on
+  initializeI2cBus();
   
   // Initialize LED panel
   initializeLEDs();
   
+  // Map the flash animation pack (if one has been flashed)
+  initializeAnimationPlayer();
+  
+  // Restore the last uploaded custom pattern from NVS
+  initializePixelVm();
+  
+  // Initialize patterns (game logic removed)
+  initializePatterns(); // from pattern_engine.cpp
+  
+  // Back from an idle deep sleep: the pattern continues where it stopped
+  if (loadResumeState()) {
+    applyResumeState();
+    Serial.println("⚡ Warm resume from deep sleep");
+  }
+  
+  // First frame goes up before anything slow (fuel gauge, MPU6050, WiFi)
+  updateCurrentPattern();
+  markBaseLayerDirty();
+  showLEDs();
+  markBootPhase("firstFrame");
+  
   // Initialize battery manager
   initializeBatteryManager();
+  markBootPhase("battery");
   
   // Initialize MPU6050 (from sensor_manager)
   initMPU6050();
+  markBootPhase("imu");
   
   // Initialize buttons
   initializeButtons();
   
-  // Initialize patterns (game logic removed)
-  initializePatterns(); // from pattern_engine.cpp
+  // Idle dimming and sleep (wakes on buttons and the MPU6050 motion interrupt)
+  initializePowerManager();
   
-  // Setup WiFi and web server
-  setupWebServer(); // from web_server.cpp
+  // Start the render-ahead pump that covers main loop stalls
+  initializeFrameQueue();
   
-  // Initialize GitHub client (after WiFi setup)
+  // Initialize GitHub client (data arrives once WiFi is up)
   initializeGitHubClient(); // from github_client.cpp
   
-  // Print access information for debugging
-  delay(2000);
-  Serial.println("=== WiFi Access Information ===");
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.printf("🌐 Home WiFi Connected: %s\n", WiFi.localIP().toString().c_str());
-    Serial.printf("🔗 Web Interface: http://%s\n", WiFi.localIP().toString().c_str());
-  } else {
-    Serial.printf("📶 AP Mode Active: %s\n", WiFi.softAPIP().toString().c_str());
-    Serial.printf("🔗 Web Interface: http://%s\n", WiFi.softAPIP().toString().c_str());
-  }
-  Serial.println("================================");
+  // WiFi connect, AP fallback and the web server come up on their own task while patterns run
+  startWebServerInBackground(); // from web_server.cpp
   
   Serial.println("=== Setup Complete ===");
   Serial.println("Ready for operation!");
+  markBootPhase("setupDone");
   
   // Record startup time for grace period
   startupTime = millis();
 }
 
 void loop() {
-  // Handle web server
-  server.handleClient();
+  static bool loopStarted = false;
+  if (!loopStarted) {
+    markBootPhase("loop");
+    loopStarted = true;
+  }
+  
+  // Handle web server (started in the background after a warm resume). Handlers
+  // draw, preview and replay patterns, so the frame pump must not run meanwhile.
+  if (isWebServerReady()) {
+    lockFrameOutput();
+    server.handleClient();
+    // One tick of a /preview render per pass
+    updatePatternPreview();
+    unlockFrameOutput();
+  }
   
   // Update sensors (gravity, battery, etc.)
   updateSensors();
   
   // Handle button inputs
+  armAllocGuard(ALLOC_STAGE_BUTTONS);
   handleButtons();
+  disarmAllocGuard();
+  
+  // Idle dimming and sleep - returns after a wake from light sleep
+  updatePowerManager();
+  
+  // Runtime target - caps brightness from the measured discharge rate
+  updateRuntimeGovernor();
   
-  // Update auto-dimming only if in auto mode
-  if (manualBrightnessLevel == 0) {
+  // Update brightness limits only when not dimmed for idle
+  if (getPowerState() == POWER_ACTIVE) {
     static unsigned long lastAutoDimmingUpdate = 0;
     if (millis() - lastAutoDimmingUpdate > 10000) { // Check every 10 seconds
-      updateAutoDimming();
+      if (manualBrightnessLevel == 0) {
+        updateAutoDimming();
+      } else {
+        // Manual levels follow the battery and governor limits down (and back up)
+        uint8_t targetBrightness = min(brightnessLevels[manualBrightnessLevel],
+                                       getBatteryLimitedMaxBrightness(getBatteryPercentage()));
+        if (targetBrightness != getCurrentBrightness()) {
+          setBrightness(targetBrightness);
+        }
+      }
       lastAutoDimmingUpdate = millis();
     }
   }
   
+  // Display section - the frame pump only draws while the loop is stuck outside it
+  lockFrameOutput();
+  
   // Handle battery display logic
   bool shouldShowBattery = false;
   
@@ -765,21 +540,55 @@ void loop() {
                     getBatteryPercentage());
       lastBatteryStatusPrint = millis();
     }
+    flushFrameQueue();
     showFullScreenBatteryDisplay();
   } else if (painterMode) {
-    // Painter mode is handled via web interface
-    // LED updates happen through web server requests
+    flushFrameQueue();
+    hideFullScreenBatteryDisplay();
+    // Painter mode is handled via web interface - redraw only when a request changed the grid
+    if (painterGridChanged) {
+      renderPainterMode();
+      markBaseLayerDirty();
+      painterGridChanged = false;
+    }
   } else {
     // Normal pattern mode
+    hideFullScreenBatteryDisplay();
+    overlayBatteryIndicator();
+    
     static unsigned long lastPatternUpdateTime = 0;
     if (millis() - lastPatternUpdateTime >= PATTERN_UPDATE_MS) {
-      updateCurrentPattern();
+      // A late frame means WiFi, I2C or the pattern itself blew the budget
+      updateRenderScale(millis() - lastPatternUpdateTime, getBatteryPercentage());
+      
+      // Gravity is read right before the frame that uses it
+      updateGravity();
+      
+      armAllocGuard(ALLOC_STAGE_PATTERN);
+      // Queued frames are always shown before anything renders just-in-time: the
+      // pattern state is already past them, so dropping them would jump ahead.
+      // A pattern switch drops them instead and starts its crossfade right away.
+      if (!presentQueuedFrame(canRenderAhead())) {
+        updateCurrentPattern();
+      }
+      disarmAllocGuard();
+      markBaseLayerDirty();
       lastPatternUpdateTime = millis();
+    } else if (canRenderAhead()) {
+      // Spare time between ticks renders future frames
+      armAllocGuard(ALLOC_STAGE_PATTERN);
+      fillFrameQueue();
+      disarmAllocGuard();
     }
   }
   
   // Always update LEDs
+  armAllocGuard(ALLOC_STAGE_SHOW);
   showLEDs();
+  disarmAllocGuard();
+  
+  unlockFrameOutput();
+  noteMainLoopTick();
   
   // Update GitHub data if pattern is active (with less frequency to prevent crashes)
   static unsigned long lastGitHubUpdate = 0;
@@ -0,0 +1,157 @@
+/*
+ * Motion Fusion Module Implementation
+ * Fixed-point Mahony filter fusing MPU6050 gyro and accelerometer samples into
+ * an orientation quaternion, with short-horizon prediction for display time
+ */
+
+#include "motion_fusion.h"
+
+// Quaternion, gravity and error terms are Q2.30; gains are Q24 multipliers
+#define Q30_ONE (1L << 30)
+#define SAMPLE_PERIOD_US (1000000L / MPU6050_SAMPLE_RATE_HZ)
+
+// Half the rotation angle per sample for one gyro count (Q46 so the >>16 keeps Q30 precision)
+static const int64_t GYRO_HALF_STEP_Q46 =
+  (int64_t)(PI / 180.0 / 131.0 * 0.5 / MPU6050_SAMPLE_RATE_HZ * 70368744177664.0);
+static const int64_t KP_HALF_STEP_Q24 = (int64_t)(MOTION_FUSION_KP * 0.5 / MPU6050_SAMPLE_RATE_HZ * 16777216.0);
+static const int64_t KI_STEP_Q24 = (int64_t)(MOTION_FUSION_KI / MPU6050_SAMPLE_RATE_HZ * 16777216.0);
+static const int64_t HALF_DT_Q24 = (int64_t)(0.5 / MPU6050_SAMPLE_RATE_HZ * 16777216.0);
+static const int32_t INTEGRAL_LIMIT = Q30_ONE / 10;  // 0.1 rad/s of learned bias
+
+// Accepted accelerometer magnitude for correction (knocks and swings are gyro-only)
+#define ACCEL_MIN_COUNTS 8192         // 0.5 g
+#define ACCEL_MAX_COUNTS 24576        // 1.5 g
+
+static int32_t orientation[4] = {Q30_ONE, 0, 0, 0};
+static int32_t integralError[3] = {0, 0, 0};
+static int32_t lastHalfStep[3] = {0, 0, 0};   // Corrected rotation of the newest sample
+
+static inline int32_t mulQ30(int32_t a, int32_t b) {
+  return (int32_t)(((int64_t)a * b) >> 30);
+}
+
+static uint32_t isqrt64(uint64_t value) {
+  uint64_t root = 0;
+  uint64_t bit = 1ULL << 62;
+  while (bit > value) {
+    bit >>= 2;
+  }
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)root;
+}
+
+static void normalizeQuaternion(int32_t* quaternion) {
+  uint64_t squared = 0;
+  for (int i = 0; i < 4; i++) {
+    squared += (int64_t)quaternion[i] * quaternion[i];
+  }
+  uint32_t norm = isqrt64(squared);
+  if (norm == 0) {
+    quaternion[0] = Q30_ONE;
+    quaternion[1] = quaternion[2] = quaternion[3] = 0;
+    return;
+  }
+  for (int i = 0; i < 4; i++) {
+    quaternion[i] = (int32_t)(((int64_t)quaternion[i] << 30) / norm);
+  }
+}
+
+// out = in * (1, h) - first-order integration of a small rotation, renormalized
+static void rotateQuaternion(const int32_t* in, const int32_t* halfStep, int32_t* out) {
+  int32_t hx = halfStep[0], hy = halfStep[1], hz = halfStep[2];
+  out[0] = in[0] - mulQ30(in[1], hx) - mulQ30(in[2], hy) - mulQ30(in[3], hz);
+  out[1] = in[1] + mulQ30(in[0], hx) + mulQ30(in[2], hz) - mulQ30(in[3], hy);
+  out[2] = in[2] + mulQ30(in[0], hy) - mulQ30(in[1], hz) + mulQ30(in[3], hx);
+  out[3] = in[3] + mulQ30(in[0], hz) + mulQ30(in[1], hy) - mulQ30(in[2], hx);
+  normalizeQuaternion(out);
+}
+
+// Gravity direction the quaternion implies, in sensor axes
+static void estimatedGravity(const int32_t* q, int32_t* gravity) {
+  gravity[0] = 2 * (mulQ30(q[1], q[3]) - mulQ30(q[0], q[2]));
+  gravity[1] = 2 * (mulQ30(q[0], q[1]) + mulQ30(q[2], q[3]));
+  gravity[2] = mulQ30(q[0], q[0]) - mulQ30(q[1], q[1]) - mulQ30(q[2], q[2]) + mulQ30(q[3], q[3]);
+}
+
+void resetMotionFusion(const int32_t accel[3]) {
+  integralError[0] = integralError[1] = integralError[2] = 0;
+  lastHalfStep[0] = lastHalfStep[1] = lastHalfStep[2] = 0;
+
+  // Roll and pitch straight from the accelerometer (yaw is unobservable and left at zero)
+  float roll = atan2f(accel[1], accel[2]);
+  float pitch = atan2f(-accel[0], sqrtf((float)accel[1] * accel[1] + (float)accel[2] * accel[2]));
+  float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+  float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+  orientation[0] = (int32_t)(cr * cp * Q30_ONE);
+  orientation[1] = (int32_t)(sr * cp * Q30_ONE);
+  orientation[2] = (int32_t)(cr * sp * Q30_ONE);
+  orientation[3] = (int32_t)(-sr * sp * Q30_ONE);
+  normalizeQuaternion(orientation);
+}
+
+void updateMotionFusion(const int32_t accel[3], const int32_t gyro[3]) {
+  int32_t halfStep[3];
+  for (int i = 0; i < 3; i++) {
+    halfStep[i] = (int32_t)(((int64_t)gyro[i] * GYRO_HALF_STEP_Q46) >> 16);
+  }
+
+  uint32_t magnitude = isqrt64((int64_t)accel[0] * accel[0] + (int64_t)accel[1] * accel[1] +
+                               (int64_t)accel[2] * accel[2]);
+  if (magnitude >= ACCEL_MIN_COUNTS && magnitude <= ACCEL_MAX_COUNTS) {
+    int32_t measured[3], estimated[3], error[3];
+    for (int i = 0; i < 3; i++) {
+      measured[i] = (int32_t)(((int64_t)accel[i] << 30) / magnitude);
+    }
+    estimatedGravity(orientation, estimated);
+
+    // Cross product rotates the estimate toward the measurement
+    error[0] = mulQ30(measured[1], estimated[2]) - mulQ30(measured[2], estimated[1]);
+    error[1] = mulQ30(measured[2], estimated[0]) - mulQ30(measured[0], estimated[2]);
+    error[2] = mulQ30(measured[0], estimated[1]) - mulQ30(measured[1], estimated[0]);
+
+    for (int i = 0; i < 3; i++) {
+      integralError[i] += (int32_t)((error[i] * KI_STEP_Q24) >> 24);
+      integralError[i] = constrain(integralError[i], -INTEGRAL_LIMIT, INTEGRAL_LIMIT);
+      halfStep[i] += (int32_t)((error[i] * KP_HALF_STEP_Q24) >> 24);
+    }
+  }
+
+  for (int i = 0; i < 3; i++) {
+    halfStep[i] += (int32_t)((integralError[i] * HALF_DT_Q24) >> 24);
+    lastHalfStep[i] = halfStep[i];
+  }
+
+  int32_t next[4];
+  rotateQuaternion(orientation, halfStep, next);
+  memcpy(orientation, next, sizeof(orientation));
+}
+
+void predictGravity(uint32_t horizonUs, float gravity[3]) {
+  horizonUs = min(horizonUs, (uint32_t)MOTION_PREDICTION_MAX_MS * 1000);
+
+  // Keep turning at the newest sample's rate until display time
+  int32_t halfStep[3], predicted[4], direction[3];
+  for (int i = 0; i < 3; i++) {
+    halfStep[i] = (int32_t)((int64_t)lastHalfStep[i] * horizonUs / SAMPLE_PERIOD_US);
+  }
+  rotateQuaternion(orientation, halfStep, predicted);
+  estimatedGravity(predicted, direction);
+
+  for (int i = 0; i < 3; i++) {
+    gravity[i] = (float)direction[i] / Q30_ONE;
+  }
+}
+
+void getMotionOrientation(float quaternion[4]) {
+  for (int i = 0; i < 4; i++) {
+    quaternion[i] = (float)orientation[i] / Q30_ONE;
+  }
+}
@@ -0,0 +1,38 @@
+/*
+ * Motion Fusion Module
+ * Fixed-point Mahony filter fusing MPU6050 gyro and accelerometer samples into
+ * an orientation quaternion, with short-horizon prediction for display time
+ */
+
+#ifndef MOTION_FUSION_H
+#define MOTION_FUSION_H
+
+#include "config.h"
+
+#ifndef MPU6050_SAMPLE_RATE_HZ
+#define MPU6050_SAMPLE_RATE_HZ 100
+#endif
+#ifndef MOTION_FUSION_KP
+#define MOTION_FUSION_KP 1.0        // Accelerometer correction gain (1/s)
+#endif
+#ifndef MOTION_FUSION_KI
+#define MOTION_FUSION_KI 0.02       // Gyro bias learning gain (1/s^2)
+#endif
+#ifndef MOTION_PREDICTION_MAX_MS
+#define MOTION_PREDICTION_MAX_MS 100
+#endif
+
+// Raw counts with calibration offsets removed: accel ±2g (16384/g), gyro ±250°/s (131 per °/s)
+
+// Seeds the orientation from a still accelerometer sample
+void resetMotionFusion(const int32_t accel[3]);
+// One FIFO sample at MPU6050_SAMPLE_RATE_HZ
+void updateMotionFusion(const int32_t accel[3], const int32_t gyro[3]);
+
+// Gravity direction in sensor axes (unit vector, +Z when flat), extrapolated by the
+// current rotation rate 'horizonUs' past the newest sample
+void predictGravity(uint32_t horizonUs, float gravity[3]);
+// Orientation quaternion (w, x, y, z) as of the newest sample
+void getMotionOrientation(float quaternion[4]);
+
+#endif // MOTION_FUSION_H
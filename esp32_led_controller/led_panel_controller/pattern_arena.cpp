@@ -0,0 +1,78 @@
+/*
+ * Pattern Arena Module Implementation
+ * Fixed-size scratch memory holding only the active pattern's working state
+ */
+
+#include "pattern_arena.h"
+
+// Word-aligned so any pattern state struct can be placed at the start of a slot
+static uint32_t patternArena[PATTERN_ARENA_SLOTS][(PATTERN_ARENA_SIZE + 3) / 4];
+static uint8_t patternArenaOwner[PATTERN_ARENA_SLOTS] = {PATTERN_ARENA_NO_OWNER};
+static size_t patternArenaUsed[PATTERN_ARENA_SLOTS] = {0};
+static uint8_t currentSlot = 0;
+
+void selectPatternArenaSlot(uint8_t slot) {
+  if (slot < PATTERN_ARENA_SLOTS) {
+    currentSlot = slot;
+  }
+}
+
+uint8_t getPatternArenaSlot() {
+  return currentSlot;
+}
+
+void* claimPatternArena(uint8_t owner, size_t size, bool* created) {
+  // Same owner: hand back the existing state untouched
+  if (owner == patternArenaOwner[currentSlot]) {
+    if (created) *created = false;
+    return patternArena[currentSlot];
+  }
+  
+  // New owner: previous state is discarded and the slot starts zeroed
+  if (size > PATTERN_ARENA_SIZE) {
+    return NULL; // Only reachable for types not covered by PATTERN_ARENA_CHECK
+  }
+  memset(patternArena[currentSlot], 0, sizeof(patternArena[currentSlot]));
+  patternArenaOwner[currentSlot] = owner;
+  patternArenaUsed[currentSlot] = size;
+  if (created) *created = true;
+  return patternArena[currentSlot];
+}
+
+void releasePatternArena() {
+  patternArenaOwner[currentSlot] = PATTERN_ARENA_NO_OWNER;
+  patternArenaUsed[currentSlot] = 0;
+}
+
+void releaseLivePatternArenas() {
+  for (int i = 0; i < PATTERN_ARENA_OFFSCREEN_SLOT; i++) {
+    patternArenaOwner[i] = PATTERN_ARENA_NO_OWNER;
+    patternArenaUsed[i] = 0;
+  }
+}
+
+const void* getPatternArenaData(size_t* used) {
+  *used = patternArenaUsed[currentSlot];
+  return patternArena[currentSlot];
+}
+
+bool restorePatternArena(uint8_t owner, const void* data, size_t size) {
+  if (owner == PATTERN_ARENA_NO_OWNER || size > PATTERN_ARENA_SIZE) {
+    return false;
+  }
+  claimPatternArena(owner, size, NULL);
+  memcpy(patternArena[currentSlot], data, size);
+  return true;
+}
+
+uint8_t getPatternArenaOwner() {
+  return patternArenaOwner[currentSlot];
+}
+
+size_t getPatternArenaUsed() {
+  size_t used = 0;
+  for (int i = 0; i < PATTERN_ARENA_SLOTS; i++) {
+    used += patternArenaUsed[i];
+  }
+  return used;
+}
@@ -0,0 +1,42 @@
+/*
+ * Pattern Arena Module
+ * Fixed-size scratch memory holding only the active pattern's working state
+ * (plus the outgoing pattern's while a crossfade is running, and an offscreen one)
+ */
+
+#ifndef PATTERN_ARENA_H
+#define PATTERN_ARENA_H
+
+#include <Arduino.h>
+
+// Sized for the largest pattern state (starfield: 40 stars x 16 bytes)
+#ifndef PATTERN_ARENA_SIZE
+#define PATTERN_ARENA_SIZE 768
+#endif
+
+// One slot per concurrently running pattern (two during a crossfade),
+// plus one for offscreen preview renders
+#define PATTERN_ARENA_SLOTS 3
+#define PATTERN_ARENA_OFFSCREEN_SLOT 2
+
+// Fails the build if a pattern's state outgrows the arena
+#define PATTERN_ARENA_CHECK(type) \
+  static_assert(sizeof(type) <= PATTERN_ARENA_SIZE, #type " does not fit in PATTERN_ARENA_SIZE")
+
+// Owner tag for a state block that was never claimed
+#define PATTERN_ARENA_NO_OWNER 0
+
+// Function declarations - claim/release act on the selected slot
+void selectPatternArenaSlot(uint8_t slot);
+uint8_t getPatternArenaSlot();
+void* claimPatternArena(uint8_t owner, size_t size, bool* created);
+void releasePatternArena();
+void releaseLivePatternArenas();   // All but the offscreen slot (a paused preview keeps its state)
+uint8_t getPatternArenaOwner();
+size_t getPatternArenaUsed();
+
+// Raw slot contents for warm resume - restoring hands the owner back its state untouched
+const void* getPatternArenaData(size_t* used);
+bool restorePatternArena(uint8_t owner, const void* data, size_t size);
+
+#endif // PATTERN_ARENA_H
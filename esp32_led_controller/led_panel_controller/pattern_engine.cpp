@@ -4,49 +4,184 @@
  */
 
 #include "pattern_engine.h"
+#include "sensor_manager.h"
+#include "github_client.h"
 
 // Pattern state variables
 PatternType currentPattern = PATTERN_PLASMA_BLOB;
 unsigned long lastPatternUpdate = 0;
 
-PlasmaBlob blob;
-RainDrop rainDrops[MAX_RAINDROPS];
-uint8_t fireBuffer[MATRIX_HEIGHT][MATRIX_WIDTH];
-Star stars[MAX_STARS];
-float waveTime = 0;
-uint16_t rainbowOffset = 0;
 GitHubActivity githubActivity;
 
-void initializePatterns() {
-  // Initialize plasma blob
-  blob.x = MATRIX_WIDTH / 2.0;
-  blob.y = MATRIX_HEIGHT / 2.0;
-  blob.vx = 0;
-  blob.vy = 0;
-  blob.size = 3.0;
-  blob.color = CHSV(160, 255, 255);
-  blob.intensity = 255;
-  
-  // Initialize rain drops
-  for (int i = 0; i < MAX_RAINDROPS; i++) {
-    rainDrops[i].active = false;
+// Frame inputs and the status published after each live frame
+float gravityX = 0.0;
+float gravityY = 1.0;
+Seqlock<PatternStatus> patternStatus(PatternStatus{PATTERN_OFF, PATTERN_OFF, false, false, 0, 0});
+
+// Every pattern's working state must fit in the shared arena
+PATTERN_ARENA_CHECK(PlasmaState);
+PATTERN_ARENA_CHECK(RainState);
+PATTERN_ARENA_CHECK(FireState);
+PATTERN_ARENA_CHECK(StarfieldState);
+PATTERN_ARENA_CHECK(RainbowState);
+PATTERN_ARENA_CHECK(AnimationState);
+
+// Per-pattern random generators
+FastRandom rainRandom;
+FastRandom fireRandom;
+FastRandom starRandom;
+FastRandom githubRandom;
+
+// Crossfade state - the incoming pattern renders into displayBuffer from its own
+// arena slot while the outgoing one keeps animating in transitionBuffer
+uint16_t patternTransitionMs = PATTERN_TRANSITION_MS;
+static CRGB transitionBuffer[NUM_LEDS] __attribute__((aligned(4)));
+static CRGB blendedBuffer[NUM_LEDS] __attribute__((aligned(4)));
+static bool patternActivated = false;
+static bool transitionActive = false;
+static bool outgoingFrozen = false;
+static PatternType renderedPattern = PATTERN_OFF;
+static PatternType outgoingPattern = PATTERN_OFF;
+static uint8_t activeArenaSlot = 0;
+static unsigned long transitionStart = 0;
+static unsigned long outgoingRenderUs = 0;
+
+// Keyframe interpolation state - keyframes render into keyframeNext and the
+// output frame is blended from keyframePrev towards it
+uint8_t keyframeInterval = PATTERN_KEYFRAME_INTERVAL;
+static CRGB keyframePrev[NUM_LEDS] __attribute__((aligned(4)));
+static CRGB keyframeNext[NUM_LEDS] __attribute__((aligned(4)));
+static bool keyframesPrimed = false;
+static uint8_t keyframePhase = 0;
+static PatternType keyframePattern = PATTERN_OFF;
+static uint8_t patternFrameStep = 1;  // Simulation steps the current render covers
+static CRGB* frameOutput = displayBuffer;  // Where the finished (interpolated) frame goes
+static unsigned long patternRenderUs = 0;  // Last render of the current pattern
+
+// Offscreen rendering - live state saved while a preview runs in its own arena slot
+static bool offscreenRendering = false;
+static PatternType offscreenPattern = PATTERN_OFF;
+static FastRandom savedRandoms[4];
+static FastRandom offscreenRandoms[4];  // Preview's own streams while it is paused
+static float savedGravityX, savedGravityY;
+static bool savedClockPinned = false;
+static unsigned long savedClockTime = 0;
+static uint8_t savedArenaSlot = 0;
+static uint8_t savedFrameStep = 1;
+
+// Adaptive resolution state
+bool adaptiveRenderEnabled = ENABLE_ADAPTIVE_RENDER;
+static bool halfResolution = false;
+static RenderScaleReason renderScaleReason = RENDER_SCALE_NONE;
+static float smoothedFrameInterval = PATTERN_UPDATE_MS;
+static unsigned long lastRenderScaleSwitch = 0;
+static uint32_t renderScaleSwitches = 0;
+static uint32_t halfResolutionFrames = 0;
+static CRGB lowResBuffer[LOW_RES_HEIGHT][LOW_RES_WIDTH];
+
+// Per-pixel colour function shared by the full- and half-resolution paths
+typedef CRGB (*PixelShader)(float x, float y, const void* context);
+
+// Pattern clock - follows millis() unless pinned for deterministic replay
+// (offset so a warm resume continues from the time the pattern stopped at)
+bool patternClockPinned = false;
+unsigned long pinnedPatternTime = 0;
+static unsigned long patternClockOffset = 0;
+
+void seedPatterns(uint32_t seed) {
+  // Each pattern gets its own stream so one pattern's draws never shift another's
+  seedFastRandom(rainRandom, seed ^ 0x01000193);
+  seedFastRandom(fireRandom, seed ^ 0x02000327);
+  seedFastRandom(starRandom, seed ^ 0x030004BB);
+  seedFastRandom(githubRandom, seed ^ 0x0400064F);
+}
+
+unsigned long patternMillis() {
+  return patternClockPinned ? pinnedPatternTime : millis() + patternClockOffset;
+}
+
+void pinPatternClock(unsigned long timeMs) {
+  patternClockPinned = true;
+  pinnedPatternTime = timeMs;
+}
+
+void releasePatternClock() {
+  patternClockPinned = false;
+}
+
+static PlasmaState* plasmaState() {
+  bool created;
+  PlasmaState* state = (PlasmaState*)claimPatternArena(STATE_PLASMA, sizeof(PlasmaState), &created);
+  if (created) {
+    state->blob.x = MATRIX_WIDTH / 2.0;
+    state->blob.y = MATRIX_HEIGHT / 2.0;
+    state->blob.vx = 0;
+    state->blob.vy = 0;
+    state->blob.size = 3.0;
+    state->blob.color = CHSV(160, 255, 255);
+    state->blob.intensity = 255;
   }
-  
-  // Initialize fire buffer
-  for (int y = 0; y < MATRIX_HEIGHT; y++) {
-    for (int x = 0; x < MATRIX_WIDTH; x++) {
-      fireBuffer[y][x] = 0;
+  return state;
+}
+
+static RainState* rainState() {
+  // Zeroed arena already means no active drops and no previous spawn
+  return (RainState*)claimPatternArena(STATE_RAIN, sizeof(RainState), NULL);
+}
+
+static FireState* fireState() {
+  return (FireState*)claimPatternArena(STATE_FIRE, sizeof(FireState), NULL);
+}
+
+static StarfieldState* starfieldState() {
+  bool created;
+  StarfieldState* state = (StarfieldState*)claimPatternArena(STATE_STARFIELD, sizeof(StarfieldState), &created);
+  if (created) {
+    for (int i = 0; i < MAX_STARS; i++) {
+      state->stars[i].x = fastRandom(starRandom, -MATRIX_WIDTH, MATRIX_WIDTH * 2);
+      state->stars[i].y = fastRandom(starRandom, -MATRIX_HEIGHT, MATRIX_HEIGHT * 2);
+      state->stars[i].z = fastRandom(starRandom, 1, 15);
+      state->stars[i].brightness = fastRandom(starRandom, 50, 255) / 255.0;
     }
   }
-  
-  // Initialize stars
-  for (int i = 0; i < MAX_STARS; i++) {
-    stars[i].x = random(-MATRIX_WIDTH, MATRIX_WIDTH * 2);
-    stars[i].y = random(-MATRIX_HEIGHT, MATRIX_HEIGHT * 2);
-    stars[i].z = random(1, 15);
-    stars[i].brightness = random(50, 255) / 255.0;
+  return state;
+}
+
+static RainbowState* rainbowState() {
+  return (RainbowState*)claimPatternArena(STATE_RAINBOW, sizeof(RainbowState), NULL);
+}
+
+static AnimationState* animationState() {
+  bool created;
+  AnimationState* state = (AnimationState*)claimPatternArena(STATE_ANIMATION, sizeof(AnimationState), &created);
+  if (created || state->playback.animation != getSelectedAnimation()) {
+    // New or reselected animation starts again from its first keyframe
+    memset(&state->playback, 0, sizeof(state->playback));
+    state->playback.animation = getSelectedAnimation();
+  }
+  return state;
+}
+
+void initializePatterns() {
+  // Seed generators on first use so patterns never draw from an unseeded state
+  static bool randomSeeded = false;
+  if (!randomSeeded) {
+    seedPatterns(PATTERN_RANDOM_SEED);
+    randomSeeded = true;
   }
   
+  // Drop any resident pattern state - the next frame rebuilds it from scratch
+  releaseLivePatternArenas();
+  
+  // Cancel any crossfade so the next frame is a hard cut into currentPattern
+  patternActivated = false;
+  transitionActive = false;
+  keyframesPrimed = false;
+  activeArenaSlot = 0;
+  selectPatternArenaSlot(0);
+  setRenderTarget(displayBuffer);
+  setBaseLayerSource(displayBuffer);
+  
   // Only initialize GitHub activity if it hasn't been initialized yet
   static bool githubInitialized = false;
   if (!githubInitialized) {
@@ -55,12 +190,443 @@ void initializePatterns() {
   }
 }
 
+void updateRenderScale(unsigned long frameIntervalMs, float batteryPercentage) {
+  // Smooth out single slow frames (a WiFi burst or one I2C retry)
+  smoothedFrameInterval += ((float)frameIntervalMs - smoothedFrameInterval) * 0.1;
+  
+  // Separate enter/exit thresholds plus a hold time keep the scale from flapping
+  RenderScaleReason wanted = renderScaleReason;
+  if (batteryPercentage < LOW_BATTERY_THRESHOLD) {
+    wanted = RENDER_SCALE_BATTERY;
+  } else if (smoothedFrameInterval > ADAPTIVE_RENDER_ENTER_MS) {
+    wanted = RENDER_SCALE_LOAD;
+  } else if (renderScaleReason == RENDER_SCALE_BATTERY) {
+    if (batteryPercentage > LOW_BATTERY_THRESHOLD + ADAPTIVE_RENDER_BATTERY_MARGIN) {
+      wanted = RENDER_SCALE_NONE;
+    }
+  } else if (smoothedFrameInterval < ADAPTIVE_RENDER_EXIT_MS) {
+    wanted = RENDER_SCALE_NONE;
+  }
+  
+  bool wantHalf = (wanted != RENDER_SCALE_NONE);
+  if (wantHalf != halfResolution) {
+    if (millis() - lastRenderScaleSwitch < ADAPTIVE_RENDER_HOLD_MS) {
+      return;
+    }
+    halfResolution = wantHalf;
+    lastRenderScaleSwitch = millis();
+    renderScaleSwitches++;
+    printfNoAlloc("🔍 Render scale: %s (%s, frame %.1f ms, battery %.1f%%)\n",
+                  halfResolution ? "half" : "full",
+                  wanted == RENDER_SCALE_BATTERY ? "battery" : "load",
+                  smoothedFrameInterval, batteryPercentage);
+  }
+  renderScaleReason = wanted;
+}
+
+bool isHalfResolutionActive() {
+  return adaptiveRenderEnabled && halfResolution;
+}
+
+float getSmoothedFrameInterval() {
+  return smoothedFrameInterval;
+}
+
+const char* getRenderScaleReason() {
+  if (!isHalfResolutionActive()) {
+    return "none";
+  }
+  return renderScaleReason == RENDER_SCALE_BATTERY ? "battery" : "load";
+}
+
+uint32_t getRenderScaleSwitches() {
+  return renderScaleSwitches;
+}
+
+uint32_t getHalfResolutionFrames() {
+  return halfResolutionFrames;
+}
+
+static CRGB sampleLowRes(int column, int row, uint8_t weightX, uint8_t weightY) {
+  int nextColumn = min(column + 1, LOW_RES_WIDTH - 1);
+  int nextRow = min(row + 1, LOW_RES_HEIGHT - 1);
+  CRGB top = blend(lowResBuffer[row][column], lowResBuffer[row][nextColumn], weightX);
+  CRGB bottom = blend(lowResBuffer[nextRow][column], lowResBuffer[nextRow][nextColumn], weightX);
+  return blend(top, bottom, weightY);
+}
+
+static void lowResCoordinate(int pixel, int& cell, uint8_t& weight) {
+  // Half-res samples sit at full-res 2i + 0.5, so each pixel is 1/4 or 3/4 of
+  // the way between two samples (edge pixels clamp to the outer sample)
+  if (pixel == 0) {
+    cell = 0;
+    weight = 0;
+    return;
+  }
+  cell = (pixel - 1) / 2;
+  weight = ((pixel - 1) & 1) ? 192 : 64;
+}
+
+static void shadePixels(PixelShader shader, const void* context) {
+  if (!isHalfResolutionActive() || offscreenRendering) {
+    for (int y = 0; y < MATRIX_HEIGHT; y++) {
+      for (int x = 0; x < MATRIX_WIDTH; x++) {
+        setLED(x, y, shader(x, y, context));
+      }
+    }
+    return;
+  }
+  
+  // Quarter of the shader calls, then bilinear upscale back to the full grid
+  halfResolutionFrames++;
+  for (int row = 0; row < LOW_RES_HEIGHT; row++) {
+    for (int column = 0; column < LOW_RES_WIDTH; column++) {
+      lowResBuffer[row][column] = shader(column * 2 + 0.5, row * 2 + 0.5, context);
+    }
+  }
+  
+  for (int y = 0; y < MATRIX_HEIGHT; y++) {
+    int row;
+    uint8_t weightY;
+    lowResCoordinate(y, row, weightY);
+    for (int x = 0; x < MATRIX_WIDTH; x++) {
+      int column;
+      uint8_t weightX;
+      lowResCoordinate(x, column, weightX);
+      setLED(x, y, sampleLowRes(column, row, weightX, weightY));
+    }
+  }
+}
+
+bool isPatternTransitionActive() {
+  return transitionActive;
+}
+
+static void finishPatternTransition() {
+  transitionActive = false;
+  
+  // Outgoing state is no longer needed
+  selectPatternArenaSlot(activeArenaSlot ^ 1);
+  releasePatternArena();
+  selectPatternArenaSlot(activeArenaSlot);
+  setBaseLayerSource(displayBuffer);
+}
+
+static void startPatternTransition() {
+  PatternType previousPattern = renderedPattern;
+  renderedPattern = currentPattern;
+  
+  if (patternTransitionMs == 0) {
+    // Hard cut - restart the new pattern in the active slot
+    if (transitionActive) {
+      finishPatternTransition();
+    }
+    releasePatternArena();
+    return;
+  }
+  
+  if (transitionActive) {
+    // Switched again mid-fade: fade out from what is on screen now rather than
+    // jumping back to the previous pattern's own frame
+    memcpy(transitionBuffer, blendedBuffer, sizeof(transitionBuffer));
+    outgoingFrozen = true;
+  } else {
+    // displayBuffer still holds the outgoing pattern's last frame
+    memcpy(transitionBuffer, displayBuffer, sizeof(transitionBuffer));
+    outgoingFrozen = false;
+  }
+  outgoingPattern = previousPattern;
+  outgoingRenderUs = 0;
+  keyframesPrimed = false;
+  
+  // Incoming pattern starts fresh in the other slot on a black frame
+  activeArenaSlot ^= 1;
+  selectPatternArenaSlot(activeArenaSlot);
+  releasePatternArena();
+  fill_solid(displayBuffer, NUM_LEDS, CRGB::Black);
+  
+  transitionActive = true;
+  transitionStart = patternMillis();
+  setBaseLayerSource(blendedBuffer);
+}
+
+bool supportsKeyframes(PatternType pattern) {
+  // Only fully repainted, slowly changing patterns opt in - rain, stars and
+  // the GitHub calendar rely on every frame (trails, flicker, loading spinner)
+  switch (pattern) {
+    case PATTERN_PLASMA_BLOB:
+    case PATTERN_RAINBOW_WAVE:
+    case PATTERN_RIPPLES:
+    case PATTERN_CUSTOM:
+      return true;
+    default:
+      return false;
+  }
+}
+
+unsigned long getPatternRenderUs() {
+  return patternRenderUs;
+}
+
+void setKeyframeInterval(uint8_t interval) {
+  keyframeInterval = constrain(interval, 1, PATTERN_KEYFRAME_INTERVAL_MAX);
+  keyframesPrimed = false;
+}
+
+static void renderKeyframe(PatternType pattern, uint8_t steps) {
+  patternFrameStep = steps;
+  setRenderTarget(keyframeNext);
+  renderPattern(pattern);
+  setRenderTarget(displayBuffer);
+  patternFrameStep = 1;
+}
+
+static void renderInterpolated(PatternType pattern) {
+  uint8_t interval = supportsKeyframes(pattern) ? keyframeInterval : 1;
+  if (interval <= 1) {
+    keyframesPrimed = false;
+    setRenderTarget(frameOutput);
+    renderPattern(pattern);
+    setRenderTarget(displayBuffer);
+    return;
+  }
+  
+  if (!keyframesPrimed || keyframePattern != pattern) {
+    // Start from a single keyframe shown as-is; the next tick renders the one after it
+    renderKeyframe(pattern, 1);
+    memcpy(keyframePrev, keyframeNext, sizeof(keyframePrev));
+    keyframesPrimed = true;
+    keyframePattern = pattern;
+    keyframePhase = interval - 1;
+  } else if (keyframePhase == 0) {
+    memcpy(keyframePrev, keyframeNext, sizeof(keyframePrev));
+    renderKeyframe(pattern, interval);
+  }
+  
+  // Output trails the newest keyframe by one keyframe period
+  keyframePhase++;
+  blendBuffers(frameOutput, keyframePrev, keyframeNext, (uint16_t)(keyframePhase * 256 / interval));
+  if (keyframePhase >= interval) {
+    keyframePhase = 0;
+  }
+}
+
+bool supportsRenderAhead(PatternType pattern) {
+  // Patterns that never read gravity can be rendered before they are shown;
+  // plasma and rain follow the accelerometer and stay just-in-time
+  switch (pattern) {
+    case PATTERN_RAINBOW_WAVE:
+    case PATTERN_RIPPLES:
+    case PATTERN_STARFIELD:
+    case PATTERN_GITHUB_ACTIVITY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool canRenderAhead() {
+  // Pattern switches and crossfades go through updateCurrentPattern() just-in-time
+  return patternActivated && !transitionActive && !patternClockPinned &&
+         currentPattern == renderedPattern && supportsRenderAhead(currentPattern);
+}
+
+static void publishPatternStatus() {
+  static uint32_t liveFrames = 0;
+  PatternStatus status;
+  status.requested = currentPattern;
+  status.shown = renderedPattern;
+  status.transitioning = transitionActive;
+  status.halfResolution = halfResolution;
+  status.renderUs = patternRenderUs;
+  status.frames = ++liveFrames;
+  publishSnapshot(patternStatus, status);
+}
+
+void renderFrameAt(CRGB* out, unsigned long frameTime) {
+  pinPatternClock(frameTime);
+  frameOutput = out;
+  renderInterpolated(currentPattern);
+  frameOutput = displayBuffer;
+  releasePatternClock();
+  publishPatternStatus();
+}
+
+void snapshotPatterns(PatternSnapshot& snapshot) {
+  // Mid-crossfade the incoming pattern is saved and simply starts over
+  snapshot.pattern = transitionActive || !patternActivated ? currentPattern : renderedPattern;
+  snapshot.clockMs = patternMillis();
+  snapshot.randoms[0] = rainRandom;
+  snapshot.randoms[1] = fireRandom;
+  snapshot.randoms[2] = starRandom;
+  snapshot.randoms[3] = githubRandom;
+  snapshot.arenaOwner = PATTERN_ARENA_NO_OWNER;
+  snapshot.arenaUsed = 0;
+  
+  // Animation playback decodes against the previous frame, which does not survive the sleep
+  if (!patternActivated || transitionActive || snapshot.pattern == PATTERN_ANIMATION) {
+    return;
+  }
+  uint8_t slot = getPatternArenaSlot();
+  selectPatternArenaSlot(activeArenaSlot);
+  size_t used;
+  const void* data = getPatternArenaData(&used);
+  snapshot.arenaOwner = getPatternArenaOwner();
+  snapshot.arenaUsed = used;
+  memcpy(snapshot.arena, data, used);
+  selectPatternArenaSlot(slot);
+}
+
+void restorePatterns(const PatternSnapshot& snapshot) {
+  currentPattern = (PatternType)snapshot.pattern;
+  rainRandom = snapshot.randoms[0];
+  fireRandom = snapshot.randoms[1];
+  starRandom = snapshot.randoms[2];
+  githubRandom = snapshot.randoms[3];
+  patternClockOffset = snapshot.clockMs - millis();
+  
+  // initializePatterns() left slot 0 active; the first frame reuses this state as a hard cut
+  selectPatternArenaSlot(activeArenaSlot);
+  restorePatternArena(snapshot.arenaOwner, snapshot.arena, snapshot.arenaUsed);
+}
+
+static void enterOffscreenState() {
+  savedRandoms[0] = rainRandom;
+  savedRandoms[1] = fireRandom;
+  savedRandoms[2] = starRandom;
+  savedRandoms[3] = githubRandom;
+  savedGravityX = gravityX;
+  savedGravityY = gravityY;
+  gravityX = 0;
+  gravityY = 0;
+  savedClockPinned = patternClockPinned;
+  savedClockTime = pinnedPatternTime;
+  // One simulation step per preview frame, whatever the live render scale is
+  savedFrameStep = patternFrameStep;
+  patternFrameStep = 1;
+  
+  savedArenaSlot = getPatternArenaSlot();
+  selectPatternArenaSlot(PATTERN_ARENA_OFFSCREEN_SLOT);
+  offscreenRendering = true;
+}
+
+static void leaveOffscreenState() {
+  selectPatternArenaSlot(savedArenaSlot);
+  
+  rainRandom = savedRandoms[0];
+  fireRandom = savedRandoms[1];
+  starRandom = savedRandoms[2];
+  githubRandom = savedRandoms[3];
+  gravityX = savedGravityX;
+  gravityY = savedGravityY;
+  patternClockPinned = savedClockPinned;
+  pinnedPatternTime = savedClockTime;
+  patternFrameStep = savedFrameStep;
+  
+  offscreenRendering = false;
+}
+
+void beginOffscreenRender(PatternType pattern) {
+  enterOffscreenState();
+  // Same random streams, no tilt - previews come out identical every time
+  seedPatterns(PATTERN_RANDOM_SEED);
+  releasePatternArena();
+  offscreenPattern = pattern;
+}
+
+void renderOffscreenFrame(CRGB* out, unsigned long frameTime) {
+  pinPatternClock(frameTime);
+  setRenderTarget(out);
+  renderPattern(offscreenPattern);
+  setRenderTarget(displayBuffer);
+}
+
+void pauseOffscreenRender() {
+  // The offscreen arena slot keeps the pattern state; only the random streams need parking
+  offscreenRandoms[0] = rainRandom;
+  offscreenRandoms[1] = fireRandom;
+  offscreenRandoms[2] = starRandom;
+  offscreenRandoms[3] = githubRandom;
+  leaveOffscreenState();
+}
+
+void resumeOffscreenRender() {
+  enterOffscreenState();
+  rainRandom = offscreenRandoms[0];
+  fireRandom = offscreenRandoms[1];
+  starRandom = offscreenRandoms[2];
+  githubRandom = offscreenRandoms[3];
+}
+
+void endOffscreenRender() {
+  releasePatternArena();
+  leaveOffscreenState();
+}
+
+static void renderLiveFrame() {
+  if (!patternActivated) {
+    // First frame after initializePatterns() is always a hard cut
+    patternActivated = true;
+    renderedPattern = currentPattern;
+  } else if (currentPattern != renderedPattern) {
+    startPatternTransition();
+  }
+  
+  if (!transitionActive) {
+    renderInterpolated(currentPattern);
+    return;
+  }
+  
+  unsigned long renderStart = micros();
+  renderPattern(currentPattern);
+  unsigned long incomingRenderUs = micros() - renderStart;
+  
+  // Keep the outgoing pattern animating only while both fit in one frame;
+  // otherwise it freezes on its last frame for the rest of the fade
+  if (!outgoingFrozen && incomingRenderUs + outgoingRenderUs <= PATTERN_UPDATE_MS * 1000UL) {
+    selectPatternArenaSlot(activeArenaSlot ^ 1);
+    setRenderTarget(transitionBuffer);
+    renderStart = micros();
+    renderPattern(outgoingPattern);
+    outgoingRenderUs = micros() - renderStart;
+    setRenderTarget(displayBuffer);
+    selectPatternArenaSlot(activeArenaSlot);
+  } else {
+    outgoingFrozen = true;
+  }
+  
+  unsigned long elapsed = patternMillis() - transitionStart;
+  if (elapsed >= patternTransitionMs) {
+    finishPatternTransition();
+    return;
+  }
+  
+  uint16_t amount = (uint16_t)((elapsed * 256UL) / patternTransitionMs);
+  blendBuffers(blendedBuffer, transitionBuffer, displayBuffer, amount);
+}
+
 void updateCurrentPattern() {
+  // Pinned replays (frame check) keep the tilt and status they set up themselves
+  if (patternClockPinned) {
+    renderLiveFrame();
+    return;
+  }
+  GravityState gravity = readSnapshot(gravitySnapshot);
+  gravityX = gravity.x;
+  gravityY = gravity.y;
+  renderLiveFrame();
+  publishPatternStatus();
+}
+
+void renderPattern(PatternType pattern) {
   // Pattern functions handle their own clearing to prevent double-clear glitches
+  unsigned long renderStart = micros();
   
-  switch (currentPattern) {
+  switch (pattern) {
     case PATTERN_PLASMA_BLOB:
-      updatePlasmaBlob();
+      for (uint8_t step = 0; step < patternFrameStep; step++) {
+        updatePlasmaBlob();
+      }
       drawPlasmaBlob();
       break;
       
@@ -90,10 +656,24 @@ void updateCurrentPattern() {
     case PATTERN_OFF:
       clearLEDs();
       break;
+      
+    case PATTERN_ANIMATION:
+      updateAnimation();
+      break;
+      
+    case PATTERN_CUSTOM:
+      updateCustomPattern();
+      break;
+  }
+  
+  if (pattern == currentPattern && !offscreenRendering) {
+    patternRenderUs = micros() - renderStart;
   }
 }
 
 void updatePlasmaBlob() {
+  PlasmaBlob& blob = plasmaState()->blob;
+  
   // Apply gravity to blob velocity
   float gravityStrength = 0.15;
   blob.vx += gravityX * gravityStrength;
@@ -126,45 +706,49 @@ void updatePlasmaBlob() {
   }
   
   // Change color over time
-  uint8_t hue = (millis() / 100) % 255;
+  uint8_t hue = (patternMillis() / 100) % 255;
   blob.color = CHSV(hue, 200, 255);
 }
 
-void drawPlasmaBlob() {
-  clearLEDs();
+static CRGB plasmaPixel(float x, float y, const void* context) {
+  const PlasmaBlob& blob = *(const PlasmaBlob*)context;
+  float distance = sqrt((x - blob.x) * (x - blob.x) + (y - blob.y) * (y - blob.y));
   
-  for (int y = 0; y < MATRIX_HEIGHT; y++) {
-    for (int x = 0; x < MATRIX_WIDTH; x++) {
-      float distance = sqrt((x - blob.x) * (x - blob.x) + (y - blob.y) * (y - blob.y));
-      
-      if (distance < blob.size * 2) {
-        float intensity = exp(-distance * distance / (blob.size * blob.size));
-        intensity = constrain(intensity, 0.0, 1.0);
-        
-        uint8_t r = (blob.color.r * intensity);
-        uint8_t g = (blob.color.g * intensity);
-        uint8_t b = (blob.color.b * intensity);
-        
-        setLED(x, y, CRGB(r, g, b));
-      }
-    }
+  if (distance >= blob.size * 2) {
+    return CRGB::Black;
   }
+  
+  float intensity = exp(-distance * distance / (blob.size * blob.size));
+  intensity = constrain(intensity, 0.0, 1.0);
+  
+  uint8_t r = (blob.color.r * intensity);
+  uint8_t g = (blob.color.g * intensity);
+  uint8_t b = (blob.color.b * intensity);
+  
+  return CRGB(r, g, b);
+}
+
+void drawPlasmaBlob() {
+  const PlasmaBlob& blob = plasmaState()->blob;
+  shadePixels(plasmaPixel, &blob);
 }
 
 void updateRainMatrix() {
+  RainState* rain = rainState();
+  RainDrop* rainDrops = rain->drops;
+  
   // Determine gravity direction to find "up" side of panel
   float absGravityX = abs(gravityX);
   float absGravityY = abs(gravityY);
   
   // Spawn new raindrops from the "up" edge based on gravity
-  static unsigned long lastRainSpawn = 0;
-  if (millis() - lastRainSpawn > 150) {
+  if (patternMillis() - rain->lastSpawn > 150) {
     for (int i = 0; i < MAX_RAINDROPS; i++) {
       if (!rainDrops[i].active) {
         // Determine spawn position based on strongest gravity component
         if (absGravityY > absGravityX) {
           // Gravity is primarily vertical
-          rainDrops[i].x = random(MATRIX_WIDTH);
+          rainDrops[i].x = fastRandom(rainRandom, MATRIX_WIDTH);
           if (gravityY > 0) {
             // Gravity points down, spawn from top
             rainDrops[i].y = -1;
@@ -174,7 +758,7 @@ void updateRainMatrix() {
           }
         } else {
           // Gravity is primarily horizontal
-          rainDrops[i].y = random(MATRIX_HEIGHT);
+          rainDrops[i].y = fastRandom(rainRandom, MATRIX_HEIGHT);
           if (gravityX > 0) {
             // Gravity points right, spawn from left
             rainDrops[i].x = -1;
@@ -184,10 +768,10 @@ void updateRainMatrix() {
           }
         }
         
-        rainDrops[i].velocity = 0.2 + random(50) / 100.0;
-        rainDrops[i].brightness = 150 + random(105);
+        rainDrops[i].velocity = 0.2 + fastRandom(rainRandom, 50) / 100.0;
+        rainDrops[i].brightness = 150 + fastRandom(rainRandom, 105);
         rainDrops[i].active = true;
-        lastRainSpawn = millis();
+        rain->lastSpawn = patternMillis();
         break;
       }
     }
@@ -221,10 +805,10 @@ void updateRainMatrix() {
 }
 
 void drawRainMatrix() {
+  const RainDrop* rainDrops = rainState()->drops;
+  
   // Fade existing pixels
-  for (int i = 0; i < NUM_LEDS; i++) {
-    displayBuffer[i].fadeToBlackBy(40);
-  }
+  fadeToBlack(40);
   
   // Determine gravity direction for trail effect
   float absGravityX = abs(gravityX);
@@ -233,18 +817,18 @@ void drawRainMatrix() {
   // Draw active raindrops
   for (int i = 0; i < MAX_RAINDROPS; i++) {
     if (rainDrops[i].active) {
-      int x = (int)rainDrops[i].x;
-      int y = (int)rainDrops[i].y;
+      float x = rainDrops[i].x;
+      float y = rainDrops[i].y;
       
-      // Only draw if within bounds
-      if (x >= 0 && x < MATRIX_WIDTH && y >= 0 && y < MATRIX_HEIGHT) {
+      // Only draw if the drop's footprint overlaps the panel
+      if (x > -1 && x < MATRIX_WIDTH && y > -1 && y < MATRIX_HEIGHT) {
         CRGB color = CHSV(160, 255, rainDrops[i].brightness);
-        addLED(x, y, color);
+        addLEDSubpixel(x, y, color);
         
         // Trail effect opposite to gravity direction
         for (int j = 1; j <= 3; j++) {
-          int trailX = x;
-          int trailY = y;
+          float trailX = x;
+          float trailY = y;
           
           // Calculate trail position opposite to gravity
           if (absGravityY > absGravityX) {
@@ -263,13 +847,10 @@ void drawRainMatrix() {
             }
           }
           
-          // Draw trail pixel if within bounds
-          if (trailX >= 0 && trailX < MATRIX_WIDTH && 
-              trailY >= 0 && trailY < MATRIX_HEIGHT) {
-            uint8_t trailBrightness = rainDrops[i].brightness / (j + 1);
-            CRGB trailColor = CHSV(160, 255, trailBrightness);
-            addLED(trailX, trailY, trailColor);
-          }
+          // Footprint pixels off the panel are clipped by addLEDSubpixel()
+          uint8_t trailBrightness = rainDrops[i].brightness / (j + 1);
+          CRGB trailColor = CHSV(160, 255, trailBrightness);
+          addLEDSubpixel(trailX, trailY, trailColor);
         }
       }
     }
@@ -277,9 +858,11 @@ void drawRainMatrix() {
 }
 
 void updateFire() {
+  uint8_t (*fireBuffer)[MATRIX_WIDTH] = fireState()->heat;
+  
   // Add heat at the bottom
   for (int x = 0; x < MATRIX_WIDTH; x++) {
-    fireBuffer[MATRIX_HEIGHT-1][x] = random(180, 255);
+    fireBuffer[MATRIX_HEIGHT-1][x] = fastRandom(fireRandom, 180, 255);
   }
   
   // Cool down and rise
@@ -300,13 +883,15 @@ void updateFire() {
       }
       
       int avgHeat = heatSum / count;
-      int cooling = random(5, 20);
+      int cooling = fastRandom(fireRandom, 5, 20);
       fireBuffer[y][x] = max(0, avgHeat - cooling);
     }
   }
 }
 
 void drawFire() {
+  uint8_t (*fireBuffer)[MATRIX_WIDTH] = fireState()->heat;
+  
   clearLEDs();
   
   for (int y = 0; y < MATRIX_HEIGHT; y++) {
@@ -330,87 +915,108 @@ void drawFire() {
   }
 }
 
+static CRGB rainbowPixel(float x, float y, const void* context) {
+  const RainbowState& rainbow = *(const RainbowState*)context;
+  float waveTime = rainbow.waveTime;
+  
+  float wave = sin((x * 0.4) + (y * 0.4) + (waveTime * 0.1));
+  uint8_t hue = ((int)(x * 15 + y * 15) + (int)(wave * 60) + rainbow.offset) % 255;
+  
+  float intensity = (sin(waveTime * 0.05 + x * 0.3 + y * 0.3) + 1) / 2;
+  uint8_t brightness = 50 + intensity * 200;
+  
+  return CHSV(hue, 255, brightness);
+}
+
 void updateRainbowWave() {
-  clearLEDs();
+  RainbowState* rainbow = rainbowState();
   
-  for (int x = 0; x < MATRIX_WIDTH; x++) {
-    for (int y = 0; y < MATRIX_HEIGHT; y++) {
-      float wave = sin((x * 0.4) + (y * 0.4) + (waveTime * 0.1));
-      uint8_t hue = ((x * 15) + (y * 15) + (int)(wave * 60) + rainbowOffset) % 255;
-      
-      float intensity = (sin(waveTime * 0.05 + x * 0.3 + y * 0.3) + 1) / 2;
-      uint8_t brightness = 50 + intensity * 200;
-      
-      CRGB color = CHSV(hue, 255, brightness);
-      setLED(x, y, color);
-    }
-  }
+  shadePixels(rainbowPixel, rainbow);
   
-  rainbowOffset += 2;
-  waveTime += 1;
+  rainbow->offset += 2 * patternFrameStep;
+  rainbow->waveTime += patternFrameStep;
 }
 
 void updateStarfield() {
+  Star* stars = starfieldState()->stars;
+  
   clearLEDs();
   
   for (int i = 0; i < MAX_STARS; i++) {
     stars[i].z -= 0.15;
     if (stars[i].z <= 0) {
       stars[i].z = 15;
-      stars[i].x = random(-MATRIX_WIDTH, MATRIX_WIDTH * 2);
-      stars[i].y = random(-MATRIX_HEIGHT, MATRIX_HEIGHT * 2);
-      stars[i].brightness = random(50, 255) / 255.0;
+      stars[i].x = fastRandom(starRandom, -MATRIX_WIDTH, MATRIX_WIDTH * 2);
+      stars[i].y = fastRandom(starRandom, -MATRIX_HEIGHT, MATRIX_HEIGHT * 2);
+      stars[i].brightness = fastRandom(starRandom, 50, 255) / 255.0;
     }
     
-    int screenX = (int)((stars[i].x - MATRIX_WIDTH/2) / stars[i].z * 8 + MATRIX_WIDTH/2);
-    int screenY = (int)((stars[i].y - MATRIX_HEIGHT/2) / stars[i].z * 8 + MATRIX_HEIGHT/2);
+    float screenX = (stars[i].x - MATRIX_WIDTH/2) / stars[i].z * 8 + MATRIX_WIDTH/2;
+    float screenY = (stars[i].y - MATRIX_HEIGHT/2) / stars[i].z * 8 + MATRIX_HEIGHT/2;
     
-    if (screenX >= 0 && screenX < MATRIX_WIDTH && screenY >= 0 && screenY < MATRIX_HEIGHT) {
-      float brightness = stars[i].brightness / stars[i].z * 8;
-      brightness = min(1.0f, brightness);
-      
-      uint8_t colorValue = (uint8_t)(255 * brightness);
-      CRGB color = CRGB(colorValue, colorValue, colorValue);
-      setLED(screenX, screenY, color);
-    }
+    float brightness = stars[i].brightness / stars[i].z * 8;
+    brightness = min(1.0f, brightness);
+    
+    uint8_t colorValue = (uint8_t)(255 * brightness);
+    CRGB color = CRGB(colorValue, colorValue, colorValue);
+    addLEDSubpixel(screenX, screenY, color);
   }
 }
 
-void updateRipples() {
-  clearLEDs();
-  
+static CRGB ripplePixel(float x, float y, const void* context) {
+  float timeFactor = *(const float*)context;
   float centerX = MATRIX_WIDTH / 2.0;
   float centerY = MATRIX_HEIGHT / 2.0;
-  float timeFactor = millis() * 0.003;
+  float distance = sqrt((x - centerX) * (x - centerX) + (y - centerY) * (y - centerY));
   
-  for (int x = 0; x < MATRIX_WIDTH; x++) {
-    for (int y = 0; y < MATRIX_HEIGHT; y++) {
-      float distance = sqrt((x - centerX) * (x - centerX) + (y - centerY) * (y - centerY));
-      
-      float ripple = sin(distance * 0.8 - timeFactor * 3) * 0.5 + 0.5;
-      float ripple2 = sin(distance * 0.4 - timeFactor * 4.5) * 0.3 + 0.5;
-      
-      float combined = (ripple + ripple2) / 2;
-      
-      uint8_t hue = (uint8_t)((distance * 20 + timeFactor * 50)) % 255;
-      uint8_t brightness = (uint8_t)(combined * 255);
-      
-      CRGB color = CHSV(hue, 255, brightness);
-      setLED(x, y, color);
-    }
+  float ripple = sin(distance * 0.8 - timeFactor * 3) * 0.5 + 0.5;
+  float ripple2 = sin(distance * 0.4 - timeFactor * 4.5) * 0.3 + 0.5;
+  
+  float combined = (ripple + ripple2) / 2;
+  
+  uint8_t hue = (uint8_t)((distance * 20 + timeFactor * 50)) % 255;
+  uint8_t brightness = (uint8_t)(combined * 255);
+  
+  return CHSV(hue, 255, brightness);
+}
+
+void updateRipples() {
+  float timeFactor = patternMillis() * 0.003;
+  shadePixels(ripplePixel, &timeFactor);
+}
+
+static CRGB customPixel(float x, float y, const void* context) {
+  return evaluatePixelVm(x, y);
+}
+
+void updateCustomPattern() {
+  if (!isPixelVmLoaded()) {
+    clearLEDs();
+    return;
   }
+  
+  // Inputs are Q16.16; t wraps every 32768 s so it never overflows
+  PixelVmFrame frame;
+  frame.t = (int32_t)((uint64_t)(patternMillis() % 32768000UL) * 65536 / 1000);
+  frame.gravityX = (int32_t)(gravityX * 65536);
+  frame.gravityY = (int32_t)(gravityY * 65536);
+  frame.battery = (int32_t)(constrain(getBatteryPercentage(), 0.0f, 100.0f) * 655.36f);
+  
+  beginPixelVmFrame(frame);
+  shadePixels(customPixel, NULL);
+}
+
+void updateAnimation() {
+  // Frames decode straight from mapped flash into the render target
+  stepAnimation(animationState()->playback, renderTarget, patternMillis());
 }
 
 void updateGitHubActivity() {
   clearLEDs();
   
-  // Check if we should show loading animation
-  extern bool showGitHubLoading;
-  extern void drawGitHubLoadingAnimation();
-  
   static unsigned long lastDebugOutput = 0;
   if (millis() - lastDebugOutput > 5000) { // Debug every 5 seconds
-    Serial.printf("🎨 GitHub Activity Pattern - Loading: %s, Data Age: %lu ms\n", 
+    printfNoAlloc("🎨 GitHub Activity Pattern - Loading: %s, Data Age: %lu ms\n", 
                   showGitHubLoading ? "YES" : "NO", 
                   millis() - githubActivity.lastUpdate);
     lastDebugOutput = millis();
@@ -452,15 +1058,15 @@ void drawGitHubContributions() {
       }
     }
     
-    Serial.printf("📊 Calendar Stats - Total: %d contributions\n", totalContributions);
-    Serial.printf("📊 Distribution: None=%d, Low=%d, Med=%d, High=%d, Max=%d\n",
+    printfNoAlloc("📊 Calendar Stats - Total: %d contributions\n", totalContributions);
+    printfNoAlloc("📊 Distribution: None=%d, Low=%d, Med=%d, High=%d, Max=%d\n",
                   intensityCounts[0], intensityCounts[1], intensityCounts[2], 
                   intensityCounts[3], intensityCounts[4]);
     
     // Show recent activity (rightmost column)
-    Serial.printf("📈 Recent activity (last 7 days): ");
+    printfNoAlloc("📈 Recent activity (last 7 days): ");
     for (int y = 0; y < 7; y++) {
-      Serial.printf("%d ", githubActivity.contributionData[y][15]);
+      printfNoAlloc("%d ", githubActivity.contributionData[y][15]);
     }
     Serial.println();
     
@@ -536,9 +1142,9 @@ void setGitHubData(const String& jsonData) {
         
         // More activity on weekdays
         if (dayOfWeek < 5) { // Monday-Friday
-          intensity = random(0, 5);
+          intensity = fastRandom(githubRandom, 0, 5);
         } else { // Weekend
-          intensity = random(0, 2);
+          intensity = fastRandom(githubRandom, 0, 2);
         }
         
         // Add some streaks and patterns
@@ -8,6 +8,12 @@
 
 #include <Arduino.h>
 #include <FastLED.h>
+#include "fast_random.h"
+#include "alloc_guard.h"
+#include "pattern_arena.h"
+#include "anim_player.h"
+#include "pixel_vm.h"
+#include "pattern_status.h"
 
 // Hardware definitions (if not included elsewhere)
 #ifndef NUM_LEDS
@@ -25,6 +31,39 @@
 #ifndef MAX_STARS
 #define MAX_STARS 40
 #endif
+#ifndef PATTERN_UPDATE_MS
+#define PATTERN_UPDATE_MS 20
+#endif
+#ifndef PATTERN_TRANSITION_MS
+#define PATTERN_TRANSITION_MS 600
+#endif
+#ifndef PATTERN_KEYFRAME_INTERVAL
+#define PATTERN_KEYFRAME_INTERVAL 3
+#endif
+#ifndef PATTERN_KEYFRAME_INTERVAL_MAX
+#define PATTERN_KEYFRAME_INTERVAL_MAX 6
+#endif
+#ifndef ENABLE_ADAPTIVE_RENDER
+#define ENABLE_ADAPTIVE_RENDER 1
+#endif
+#ifndef ADAPTIVE_RENDER_ENTER_MS
+#define ADAPTIVE_RENDER_ENTER_MS 30
+#endif
+#ifndef ADAPTIVE_RENDER_EXIT_MS
+#define ADAPTIVE_RENDER_EXIT_MS 23
+#endif
+#ifndef ADAPTIVE_RENDER_HOLD_MS
+#define ADAPTIVE_RENDER_HOLD_MS 3000
+#endif
+#ifndef ADAPTIVE_RENDER_BATTERY_MARGIN
+#define ADAPTIVE_RENDER_BATTERY_MARGIN 5.0
+#endif
+#ifndef LOW_BATTERY_THRESHOLD
+#define LOW_BATTERY_THRESHOLD 10.0
+#endif
+#ifndef PATTERN_RANDOM_SEED
+#define PATTERN_RANDOM_SEED 0x4C424F58
+#endif
 
 // Pattern types enumeration
 enum PatternType {
@@ -34,7 +73,20 @@ enum PatternType {
   PATTERN_STARFIELD,
   PATTERN_RIPPLES,
   PATTERN_GITHUB_ACTIVITY,
-  PATTERN_OFF
+  PATTERN_OFF,
+  PATTERN_ANIMATION,  // Flash-resident animation (after Off so frame-check indices stay put)
+  PATTERN_CUSTOM      // User-uploaded pixel VM program
+};
+
+// Half-resolution grid used by adaptive rendering
+#define LOW_RES_WIDTH (MATRIX_WIDTH / 2)
+#define LOW_RES_HEIGHT (MATRIX_HEIGHT / 2)
+
+// Why adaptive rendering is currently at half resolution
+enum RenderScaleReason {
+  RENDER_SCALE_NONE,
+  RENDER_SCALE_LOAD,
+  RENDER_SCALE_BATTERY
 };
 
 // Pattern-specific data structures
@@ -59,32 +111,124 @@ struct GitHubActivity {
   unsigned long lastUpdate;
   bool showProfile;
   uint8_t profileScrollOffset;
-  String username;
+  const char* username;
+};
+
+// Per-pattern working state - only the active pattern's block is resident (pattern arena)
+enum PatternStateOwner {
+  STATE_NONE = PATTERN_ARENA_NO_OWNER,
+  STATE_PLASMA,
+  STATE_RAIN,
+  STATE_FIRE,
+  STATE_STARFIELD,
+  STATE_RAINBOW,
+  STATE_ANIMATION
+};
+
+struct PlasmaState {
+  PlasmaBlob blob;
+};
+
+struct RainState {
+  RainDrop drops[MAX_RAINDROPS];
+  unsigned long lastSpawn;
+};
+
+struct FireState {
+  uint8_t heat[MATRIX_HEIGHT][MATRIX_WIDTH];
+};
+
+struct StarfieldState {
+  Star stars[MAX_STARS];
+};
+
+struct RainbowState {
+  float waveTime;
+  uint16_t offset;
+};
+
+struct AnimationState {
+  AnimationPlayback playback;
 };
 
 // External variables
 extern PatternType currentPattern;
 extern unsigned long lastPatternUpdate;
+// Tilt the current frame is drawn with - latched from gravitySnapshot at the start
+// of each live frame, set directly by pinned replays
 extern float gravityX, gravityY;
+extern uint16_t patternTransitionMs;
+extern bool adaptiveRenderEnabled;
+extern uint8_t keyframeInterval;
 
-// Pattern state variables
-extern PlasmaBlob blob;
-extern RainDrop rainDrops[MAX_RAINDROPS];
-extern uint8_t fireBuffer[MATRIX_HEIGHT][MATRIX_WIDTH];
-extern Star stars[MAX_STARS];
-extern float waveTime;
-extern uint16_t rainbowOffset;
+// Pattern state variables (GitHub data is a network cache, so it stays resident)
 extern GitHubActivity githubActivity;
 
+// Per-pattern random generators (seeded by seedPatterns())
+extern FastRandom rainRandom;
+extern FastRandom fireRandom;
+extern FastRandom starRandom;
+extern FastRandom githubRandom;
+
 // External LED control functions
 extern CRGB displayBuffer[NUM_LEDS];
+extern CRGB* renderTarget;
+void setRenderTarget(CRGB* buffer);
+void blendBuffers(CRGB* out, const CRGB* from, const CRGB* to, uint16_t amount);
 void clearLEDs();
 void setLED(int x, int y, CRGB color);
 void addLED(int x, int y, CRGB color);
+void addLEDSubpixel(float x, float y, CRGB color);
+void fadeToBlack(uint8_t fadeAmount);
+void setBaseLayerSource(const CRGB* source);
+float getBatteryPercentage();
 
 // Function declarations
 void initializePatterns();
 void updateCurrentPattern();
+void renderPattern(PatternType pattern);
+bool isPatternTransitionActive();
+bool supportsKeyframes(PatternType pattern);
+bool supportsRenderAhead(PatternType pattern);
+bool canRenderAhead();
+void renderFrameAt(CRGB* out, unsigned long frameTime);
+
+// Offscreen rendering for previews - the live pattern's state, clock, random
+// streams and output are untouched (call from the main loop only). A render
+// can be paused between loop passes and resumed where it stopped.
+void beginOffscreenRender(PatternType pattern);
+void renderOffscreenFrame(CRGB* out, unsigned long frameTime);
+void pauseOffscreenRender();
+void resumeOffscreenRender();
+void endOffscreenRender();
+void setKeyframeInterval(uint8_t interval);
+unsigned long getPatternRenderUs();
+
+// Adaptive resolution - call once per pattern frame with the measured interval
+void updateRenderScale(unsigned long frameIntervalMs, float batteryPercentage);
+bool isHalfResolutionActive();
+float getSmoothedFrameInterval();
+const char* getRenderScaleReason();
+uint32_t getRenderScaleSwitches();
+uint32_t getHalfResolutionFrames();
+
+// Warm resume from deep sleep: the active pattern's working state, random streams and clock
+struct PatternSnapshot {
+  uint8_t pattern;
+  uint8_t arenaOwner;
+  uint16_t arenaUsed;
+  uint32_t clockMs;
+  FastRandom randoms[4];
+  uint32_t arena[(PATTERN_ARENA_SIZE + 3) / 4];
+};
+void snapshotPatterns(PatternSnapshot& snapshot);
+void restorePatterns(const PatternSnapshot& snapshot);  // After initializePatterns()
+
+// Deterministic replay: same seed + clock + gravity gives identical frames
+void seedPatterns(uint32_t seed);
+unsigned long patternMillis();
+void pinPatternClock(unsigned long timeMs);
+void releasePatternClock();
 
 // Individual pattern functions
 void updatePlasmaBlob();
@@ -98,6 +242,8 @@ void updateStarfield();
 void updateRipples();
 void updateGitHubActivity();
 void drawGitHubContributions();
+void updateAnimation();
+void updateCustomPattern();
 
 void setGitHubData(const String& jsonData);
 
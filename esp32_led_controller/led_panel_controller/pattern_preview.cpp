@@ -0,0 +1,264 @@
+/*
+ * Pattern Preview Module Implementation
+ * Renders patterns offscreen into short animations (anim_player format) for
+ * the web UI, cached on LittleFS until the firmware or animation pack changes
+ */
+
+#include "pattern_preview.h"
+#include "pattern_engine.h"
+#include <LittleFS.h>
+
+#define PREVIEW_DIRECTORY "/preview"
+#define PREVIEW_STAMP_FILE "/preview/stamp"
+#define PREVIEW_START_MS 10000
+
+// Stamp, a .tmp and every clip that can exist - clearPreviewCache() collects this many per pass
+#define PREVIEW_MAX_FILES (PATTERN_CUSTOM + ANIMATION_MAX_COUNT + 3)
+
+static bool previewCacheChecked = false;
+static bool previewCacheReady = false;
+
+// Offscreen frames and the encoded record being written
+static CRGB previewFrame[NUM_LEDS];
+static CRGB previewPrevious[NUM_LEDS];
+static uint8_t previewRecord[ANIMATION_FRAME_RECORD_MAX];
+
+// The one clip being rendered - a request for any other waits until it is done
+struct PreviewJob {
+  bool active;
+  uint8_t pattern;
+  uint8_t index;
+  File file;                // Open on the .tmp until the last frame is written
+  unsigned long frameTime;  // Pinned pattern clock of the next tick
+  uint16_t tick;            // Ticks rendered so far, warmup included
+  unsigned long startTime;
+};
+
+static PreviewJob previewJob = {false, 0, 0, File(), 0, 0, 0};
+
+static String previewPath(uint8_t pattern, uint8_t index) {
+  return String(PREVIEW_DIRECTORY) + "/" + String(pattern) + "-" + String(index) + ".lba";
+}
+
+static String previewStamp() {
+  // Firmware image hash covers pattern code and preview settings
+  return ESP.getSketchMD5() + "-" + String(getAnimationPackFingerprint(), HEX);
+}
+
+static void clearPreviewCache() {
+  // Paths are collected before anything is removed - deleting while openNextFile()
+  // walks the directory skips entries
+  String paths[PREVIEW_MAX_FILES];
+  int count;
+  do {
+    count = 0;
+    File directory = LittleFS.open(PREVIEW_DIRECTORY);
+    if (directory && directory.isDirectory()) {
+      File entry = directory.openNextFile();
+      while (entry && count < PREVIEW_MAX_FILES) {
+        paths[count++] = entry.path();
+        entry.close();
+        entry = directory.openNextFile();
+      }
+      entry.close();
+    }
+    directory.close();
+    
+    for (int i = 0; i < count; i++) {
+      LittleFS.remove(paths[i]);
+    }
+  } while (count == PREVIEW_MAX_FILES);
+}
+
+static bool preparePreviewCache() {
+  if (previewCacheChecked) {
+    return previewCacheReady;
+  }
+  previewCacheChecked = true;
+
+  // Formats the data partition on first use
+  if (!LittleFS.begin(true)) {
+    Serial.println("❌ LittleFS mount failed - pattern previews disabled");
+    return false;
+  }
+  LittleFS.mkdir(PREVIEW_DIRECTORY);
+
+  String stamp = previewStamp();
+  File stampFile = LittleFS.open(PREVIEW_STAMP_FILE, "r");
+  String cachedStamp = stampFile ? stampFile.readString() : String();
+  stampFile.close();
+
+  if (cachedStamp != stamp) {
+    Serial.println("🖼️ Firmware or animation pack changed - clearing pattern previews");
+    clearPreviewCache();
+    stampFile = LittleFS.open(PREVIEW_STAMP_FILE, "w");
+    if (!stampFile || stampFile.print(stamp) != stamp.length()) {
+      stampFile.close();
+      Serial.println("❌ Could not write preview cache stamp");
+      return false;
+    }
+    stampFile.close();
+  }
+
+  previewCacheReady = true;
+  return true;
+}
+
+static bool hasPreview(uint8_t pattern, uint8_t index) {
+  // GitHub would freeze a network snapshot (and its loading animation writes the
+  // shared calendar), and Off has nothing to show
+  switch (pattern) {
+    case PATTERN_PLASMA_BLOB:
+    case PATTERN_RAIN_MATRIX:
+    case PATTERN_RAINBOW_WAVE:
+    case PATTERN_STARFIELD:
+    case PATTERN_RIPPLES:
+      return true;
+    case PATTERN_ANIMATION:
+      return index < getAnimationCount();
+    case PATTERN_CUSTOM:
+      return isPixelVmLoaded();
+    default:
+      return false;
+  }
+}
+
+static String temporaryPreviewPath() {
+  return previewPath(previewJob.pattern, previewJob.index) + ".tmp";
+}
+
+static void cancelPreviewJob() {
+  if (!previewJob.active) {
+    return;
+  }
+  // Back in so the offscreen slot and streams are released like any finished render
+  resumeOffscreenRender();
+  endOffscreenRender();
+  previewJob.file.close();
+  LittleFS.remove(temporaryPreviewPath());
+  previewJob.active = false;
+}
+
+static bool startPreviewJob(uint8_t pattern, uint8_t index) {
+  previewJob.pattern = pattern;
+  previewJob.index = index;
+  previewJob.file = LittleFS.open(temporaryPreviewPath(), "w");
+  if (!previewJob.file) {
+    return false;
+  }
+
+  AnimationHeader header;
+  header.magic = ANIMATION_MAGIC;
+  header.width = MATRIX_WIDTH;
+  header.height = MATRIX_HEIGHT;
+  header.frameCount = PREVIEW_FRAME_COUNT;
+  header.frameDelayMs = PREVIEW_FRAME_STEP * PATTERN_UPDATE_MS;
+  header.reserved = 0;
+  if (previewJob.file.write((const uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+    previewJob.file.close();
+    LittleFS.remove(temporaryPreviewPath());
+    return false;
+  }
+
+  fill_solid(previewFrame, NUM_LEDS, CRGB::Black);
+  beginOffscreenRender((PatternType)pattern);
+  pauseOffscreenRender();
+  previewJob.frameTime = PREVIEW_START_MS;
+  previewJob.tick = 0;
+  previewJob.startTime = millis();
+  previewJob.active = true;
+  return true;
+}
+
+static void finishPreviewJob(bool written) {
+  String temporaryPath = temporaryPreviewPath();
+  String path = previewPath(previewJob.pattern, previewJob.index);
+  size_t size = previewJob.file.size();
+  previewJob.file.close();
+  previewJob.active = false;
+
+  // Renamed into place only when complete, so a failed render is never served
+  if (!written || !LittleFS.rename(temporaryPath, path)) {
+    LittleFS.remove(temporaryPath);
+    Serial.printf("❌ Preview for pattern %d could not be written\n", previewJob.pattern);
+    return;
+  }
+  Serial.printf("🖼️ Rendered preview for pattern %d (%u bytes, %lu ms)\n",
+                previewJob.pattern, (unsigned)size, millis() - previewJob.startTime);
+}
+
+void updatePatternPreview() {
+  if (!previewJob.active) {
+    return;
+  }
+
+  uint8_t savedAnimation = getSelectedAnimation();
+  if (previewJob.pattern == PATTERN_ANIMATION) {
+    selectAnimation(previewJob.index);
+  }
+  resumeOffscreenRender();
+  renderOffscreenFrame(previewFrame, previewJob.frameTime);
+  previewJob.frameTime += PATTERN_UPDATE_MS;
+  previewJob.tick++;
+
+  // Warmup ticks fill in rain/stars; after that every PREVIEW_FRAME_STEP-th tick is a clip frame
+  bool written = true;
+  bool finished = false;
+  int captured = previewJob.tick - PREVIEW_WARMUP_TICKS;
+  if (captured > 0 && captured % PREVIEW_FRAME_STEP == 0) {
+    int frame = captured / PREVIEW_FRAME_STEP - 1;
+    // Frame 0 must be a keyframe - playback loops back to it
+    size_t length = encodeAnimationFrame(previewFrame, (frame > 0) ? previewPrevious : NULL,
+                                         previewRecord, sizeof(previewRecord));
+    written = length > 0 && previewJob.file.write(previewRecord, length) == length;
+    memcpy(previewPrevious, previewFrame, sizeof(previewPrevious));
+    finished = !written || frame == PREVIEW_FRAME_COUNT - 1;
+  }
+
+  if (finished) {
+    endOffscreenRender();
+  } else {
+    pauseOffscreenRender();
+  }
+  selectAnimation(savedAnimation);
+  if (finished) {
+    finishPreviewJob(written);
+  }
+}
+
+PreviewStatus openPatternPreview(uint8_t pattern, uint8_t index, File& file) {
+  if (!hasPreview(pattern, index) || !preparePreviewCache()) {
+    return PREVIEW_UNAVAILABLE;
+  }
+  if (pattern != PATTERN_ANIMATION) {
+    index = 0;
+  }
+
+  String path = previewPath(pattern, index);
+  if (LittleFS.exists(path)) {
+    file = LittleFS.open(path, "r");
+    return file ? PREVIEW_READY : PREVIEW_UNAVAILABLE;
+  }
+
+  // Busy with this or another clip - the client retries
+  if (previewJob.active) {
+    return PREVIEW_RENDERING;
+  }
+  return startPreviewJob(pattern, index) ? PREVIEW_RENDERING : PREVIEW_UNAVAILABLE;
+}
+
+void invalidatePatternPreview(uint8_t pattern) {
+  if (!preparePreviewCache()) {
+    return;
+  }
+  // A clip half-rendered from the old program or pack is discarded too
+  if (previewJob.pattern == pattern) {
+    cancelPreviewJob();
+  }
+  for (uint8_t index = 0; index < ((pattern == PATTERN_ANIMATION) ? ANIMATION_MAX_COUNT : 1); index++) {
+    String path = previewPath(pattern, index);
+    if (LittleFS.exists(path)) {
+      LittleFS.remove(path);
+    }
+  }
+}
@@ -0,0 +1,37 @@
+/*
+ * Pattern Preview Module
+ * Renders patterns offscreen into short animations (anim_player format) for
+ * the web UI, cached on LittleFS until the firmware or animation pack changes
+ */
+
+#ifndef PATTERN_PREVIEW_H
+#define PATTERN_PREVIEW_H
+
+#include "config.h"
+#include <FS.h>
+
+#ifndef PREVIEW_FRAME_COUNT
+#define PREVIEW_FRAME_COUNT 24
+#endif
+#ifndef PREVIEW_FRAME_STEP
+#define PREVIEW_FRAME_STEP 2        // Pattern ticks per preview frame
+#endif
+#ifndef PREVIEW_WARMUP_TICKS
+#define PREVIEW_WARMUP_TICKS 50     // Rendered before capture so rain/stars have filled in
+#endif
+
+// Outcome of a preview request
+enum PreviewStatus {
+  PREVIEW_READY,          // File is open on the cached clip
+  PREVIEW_RENDERING,      // Cache miss - queued or rendering, ask again shortly
+  PREVIEW_UNAVAILABLE     // No preview for this pattern, or the cache is unavailable
+};
+
+// Function declarations - 'pattern' is a PatternType, 'index' selects the animation.
+// A cache miss starts a render that updatePatternPreview() advances one tick per
+// main loop pass, so no request ever waits for a whole clip (main loop only).
+PreviewStatus openPatternPreview(uint8_t pattern, uint8_t index, File& file);
+void updatePatternPreview();
+void invalidatePatternPreview(uint8_t pattern);
+
+#endif // PATTERN_PREVIEW_H
@@ -0,0 +1,22 @@
+/*
+ * Pattern Status
+ * What the pattern engine last put on screen, published once per live frame for
+ * readers outside the render path (PatternType values - see pattern_engine.h)
+ */
+
+#ifndef PATTERN_STATUS_H
+#define PATTERN_STATUS_H
+
+#include "seqlock.h"
+
+struct PatternStatus {
+  uint8_t requested;        // currentPattern when the frame was rendered
+  uint8_t shown;            // Incoming pattern while a crossfade runs
+  bool transitioning;
+  bool halfResolution;
+  uint32_t renderUs;        // Last render of the shown pattern
+  uint32_t frames;          // Live frames since boot
+};
+extern Seqlock<PatternStatus> patternStatus;
+
+#endif // PATTERN_STATUS_H
@@ -0,0 +1,556 @@
+/*
+ * Pixel VM Module Implementation
+ * Stack-based fixed-point bytecode evaluated per pixel for user-uploaded
+ * patterns (compiled from expressions by pattern_compiler.py)
+ */
+
+#include "pixel_vm.h"
+#include <Preferences.h>
+
+#define VM_ONE 65536
+#define VM_NO_NODE 0xFF
+#define VM_NO_REGISTER 0xFF
+
+// Compiled-only instructions (uploads using these are rejected as unknown opcodes):
+// a store that leaves its value on the stack, and binary operations whose right
+// operand is an immediate or a register - one dispatch instead of two or three
+#define VM_TEE 0x0B
+#define VM_IMMEDIATE_FORM 0x30   // VM_ADD..VM_MAX + this: b = instruction value
+#define VM_REGISTER_FORM 0x40    // VM_ADD..VM_MAX + this: b = registers[reg]
+
+// What a value depends on - constants fold at load, frame values are hoisted
+enum VmNodeKind {
+  VM_KIND_CONST,
+  VM_KIND_FRAME,
+  VM_KIND_PIXEL
+};
+
+// Expression tree rebuilt from the uploaded stack code
+struct VmNode {
+  uint8_t op;
+  uint8_t kind;
+  uint8_t uses;       // Parents referencing this node (shared via LOAD)
+  uint8_t reg;        // Register holding the value once emitted
+  uint8_t left;
+  uint8_t right;
+  int32_t value;      // VM_PUSH immediate or folded constant
+};
+
+struct VmProgram {
+  PixelVmInstruction code[PIXEL_VM_MAX_INSTRUCTIONS];
+  uint8_t count;
+  uint8_t depth;
+  uint8_t maxDepth;
+};
+
+struct VmCompiler {
+  VmNode nodes[PIXEL_VM_MAX_NODES];
+  uint8_t nodeCount;
+  uint8_t nextRegister;
+  uint16_t folded;
+  VmProgram pixel;
+  VmProgram frame;
+  const char* error;
+};
+
+// Active program - swapped in only after a complete, successful compile
+static VmProgram pixelProgram;
+static VmProgram frameProgram;
+static uint8_t outputMode = PIXEL_VM_OUTPUT_HSV;
+static bool programLoaded = false;
+static uint16_t foldedNodes = 0;
+
+// Uploaded bytes, kept for saving to NVS
+static uint8_t programSource[PIXEL_VM_MAX_CODE];
+static uint16_t programSourceLength = 0;
+
+// Frame inputs and registers (frame results persist across the frame's pixels)
+static PixelVmFrame currentFrame;
+static int32_t registers[PIXEL_VM_REGISTERS];
+
+// Fixed-point primitives shared by the interpreter and constant folding
+static inline int32_t vmAdd(int32_t a, int32_t b) {
+  return (int32_t)((uint32_t)a + (uint32_t)b);
+}
+
+static inline int32_t vmSub(int32_t a, int32_t b) {
+  return (int32_t)((uint32_t)a - (uint32_t)b);
+}
+
+static inline int32_t vmMul(int32_t a, int32_t b) {
+  return (int32_t)(((int64_t)a * b) >> 16);
+}
+
+static int32_t vmDiv(int32_t a, int32_t b) {
+  if (b == 0) {
+    return 0;
+  }
+  int64_t quotient = ((int64_t)a * VM_ONE) / b;
+  return (int32_t)constrain(quotient, (int64_t)INT32_MIN, (int64_t)INT32_MAX);
+}
+
+static int32_t vmMod(int32_t a, int32_t b) {
+  if (b == 0) {
+    return 0;
+  }
+  int32_t remainder = a % b;
+  if (remainder != 0 && ((remainder ^ b) < 0)) {
+    remainder += b;
+  }
+  return remainder;
+}
+
+static inline int32_t vmSin(int32_t radians) {
+  // 65536 / 2pi = 10430.38 sin16 units per radian
+  uint16_t angle = (uint16_t)(((int64_t)radians * 10430) >> 16);
+  return (int32_t)sin16(angle) * 2;
+}
+
+static inline int32_t vmCos(int32_t radians) {
+  uint16_t angle = (uint16_t)((((int64_t)radians * 10430) >> 16) + 16384);
+  return (int32_t)sin16(angle) * 2;
+}
+
+static int32_t vmSqrt(int32_t a) {
+  if (a <= 0) {
+    return 0;
+  }
+
+  // Normalise by an even shift so the 32-bit integer root keeps 16 bits
+  uint8_t shift = min(__builtin_clz((uint32_t)a) & ~1, 16);
+  uint32_t n = (uint32_t)a << shift;
+  uint32_t root = 0;
+  // Highest power of four not above n
+  uint32_t bit = 1UL << ((31 - __builtin_clz(n)) & ~1);
+  while (bit != 0) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  // sqrt(a * 2^shift) = sqrt(a) * 2^(shift/2); Q16.16 wants sqrt(a) * 2^8
+  return (int32_t)(root << (8 - shift / 2));
+}
+
+static int32_t applyOperation(uint8_t op, int32_t a, int32_t b) {
+  switch (op) {
+    case VM_ADD: return vmAdd(a, b);
+    case VM_SUB: return vmSub(a, b);
+    case VM_MUL: return vmMul(a, b);
+    case VM_DIV: return vmDiv(a, b);
+    case VM_MOD: return vmMod(a, b);
+    case VM_MIN: return min(a, b);
+    case VM_MAX: return max(a, b);
+    case VM_NEG: return vmSub(0, a);
+    case VM_ABS: return (a < 0) ? vmSub(0, a) : a;
+    case VM_SIN: return vmSin(a);
+    case VM_COS: return vmCos(a);
+    case VM_SQRT: return vmSqrt(a);
+    case VM_FLOOR: return a & ~(VM_ONE - 1);
+    case VM_FRACT: return a & (VM_ONE - 1);
+    default: return 0;
+  }
+}
+
+// Operands popped by an opcode (-1 = not an operation)
+static int8_t operationArity(uint8_t op) {
+  if (op >= VM_ADD && op <= VM_MAX) return 2;
+  if (op >= VM_NEG && op <= VM_FRACT) return 1;
+  return -1;
+}
+
+static bool isInputOp(uint8_t op) {
+  return op >= VM_PUSH && op <= VM_BATTERY;
+}
+
+// Runs a compiled program; returns the stack top after it finishes
+static int32_t* runProgram(const VmProgram& program, int32_t* sp, int32_t x, int32_t y, int32_t index) {
+  const PixelVmInstruction* instruction = program.code;
+  const PixelVmInstruction* end = program.code + program.count;
+
+  for (; instruction < end; instruction++) {
+    switch (instruction->op) {
+      case VM_PUSH: *sp++ = instruction->value; break;
+      case VM_X: *sp++ = x; break;
+      case VM_Y: *sp++ = y; break;
+      case VM_INDEX: *sp++ = index; break;
+      case VM_T: *sp++ = currentFrame.t; break;
+      case VM_GRAVITY_X: *sp++ = currentFrame.gravityX; break;
+      case VM_GRAVITY_Y: *sp++ = currentFrame.gravityY; break;
+      case VM_BATTERY: *sp++ = currentFrame.battery; break;
+      case VM_LOAD: *sp++ = registers[instruction->reg]; break;
+      case VM_STORE: registers[instruction->reg] = *--sp; break;
+      case VM_TEE: registers[instruction->reg] = sp[-1]; break;
+      case VM_ADD: sp--; sp[-1] = vmAdd(sp[-1], sp[0]); break;
+      case VM_SUB: sp--; sp[-1] = vmSub(sp[-1], sp[0]); break;
+      case VM_MUL: sp--; sp[-1] = vmMul(sp[-1], sp[0]); break;
+      case VM_ADD + VM_IMMEDIATE_FORM: sp[-1] = vmAdd(sp[-1], instruction->value); break;
+      case VM_SUB + VM_IMMEDIATE_FORM: sp[-1] = vmSub(sp[-1], instruction->value); break;
+      case VM_MUL + VM_IMMEDIATE_FORM: sp[-1] = vmMul(sp[-1], instruction->value); break;
+      case VM_ADD + VM_REGISTER_FORM: sp[-1] = vmAdd(sp[-1], registers[instruction->reg]); break;
+      case VM_SUB + VM_REGISTER_FORM: sp[-1] = vmSub(sp[-1], registers[instruction->reg]); break;
+      case VM_MUL + VM_REGISTER_FORM: sp[-1] = vmMul(sp[-1], registers[instruction->reg]); break;
+      case VM_SIN: sp[-1] = vmSin(sp[-1]); break;
+      case VM_COS: sp[-1] = vmCos(sp[-1]); break;
+      case VM_SQRT: sp[-1] = vmSqrt(sp[-1]); break;
+      default:
+        // Rarer operations go through the shared folding path
+        if (instruction->op >= VM_REGISTER_FORM) {
+          sp[-1] = applyOperation(instruction->op - VM_REGISTER_FORM, sp[-1], registers[instruction->reg]);
+        } else if (instruction->op >= VM_IMMEDIATE_FORM) {
+          sp[-1] = applyOperation(instruction->op - VM_IMMEDIATE_FORM, sp[-1], instruction->value);
+        } else if (operationArity(instruction->op) == 2) {
+          sp--;
+          sp[-1] = applyOperation(instruction->op, sp[-1], sp[0]);
+        } else {
+          sp[-1] = applyOperation(instruction->op, sp[-1], 0);
+        }
+        break;
+    }
+  }
+  return sp;
+}
+
+// ---- Loading: decode to a tree, fold constants, hoist frame-invariant subtrees ----
+
+static uint8_t addNode(VmCompiler& compiler, uint8_t op, uint8_t kind, int32_t value) {
+  if (compiler.nodeCount >= PIXEL_VM_MAX_NODES) {
+    compiler.error = "Too many expression nodes";
+    return VM_NO_NODE;
+  }
+  VmNode& node = compiler.nodes[compiler.nodeCount];
+  node.op = op;
+  node.kind = kind;
+  node.uses = 0;
+  node.reg = VM_NO_REGISTER;
+  node.left = VM_NO_NODE;
+  node.right = VM_NO_NODE;
+  node.value = value;
+  return compiler.nodeCount++;
+}
+
+static void useNode(VmCompiler& compiler, uint8_t index) {
+  if (compiler.nodes[index].uses < 255) {
+    compiler.nodes[index].uses++;
+  }
+}
+
+static bool decodeProgram(VmCompiler& compiler, const uint8_t* code, size_t length, uint8_t* roots) {
+  uint8_t stack[PIXEL_VM_STACK_DEPTH];
+  uint8_t depth = 0;
+  uint8_t variables[PIXEL_VM_REGISTERS];
+  memset(variables, VM_NO_NODE, sizeof(variables));
+
+  size_t position = 0;
+  while (position < length) {
+    uint8_t op = code[position++];
+    int8_t arity = operationArity(op);
+
+    if (op == VM_PUSH) {
+      if (length - position < 4) {
+        compiler.error = "Truncated constant";
+        return false;
+      }
+      int32_t value;
+      memcpy(&value, code + position, 4);
+      position += 4;
+      if (depth >= PIXEL_VM_STACK_DEPTH) {
+        compiler.error = "Stack overflow";
+        return false;
+      }
+      stack[depth] = addNode(compiler, op, VM_KIND_CONST, value);
+      if (stack[depth++] == VM_NO_NODE) return false;
+    } else if (isInputOp(op)) {
+      uint8_t kind = (op == VM_X || op == VM_Y || op == VM_INDEX) ? VM_KIND_PIXEL : VM_KIND_FRAME;
+      if (depth >= PIXEL_VM_STACK_DEPTH) {
+        compiler.error = "Stack overflow";
+        return false;
+      }
+      stack[depth] = addNode(compiler, op, kind, 0);
+      if (stack[depth++] == VM_NO_NODE) return false;
+    } else if (op == VM_LOAD || op == VM_STORE) {
+      if (position >= length || code[position] >= PIXEL_VM_REGISTERS) {
+        compiler.error = "Bad register";
+        return false;
+      }
+      uint8_t reg = code[position++];
+      if (op == VM_STORE) {
+        // Variables are tree edges, not storage - emission decides what gets a register
+        if (depth == 0) {
+          compiler.error = "Stack underflow";
+          return false;
+        }
+        variables[reg] = stack[--depth];
+      } else {
+        if (variables[reg] == VM_NO_NODE) {
+          compiler.error = "Register read before write";
+          return false;
+        }
+        if (depth >= PIXEL_VM_STACK_DEPTH) {
+          compiler.error = "Stack overflow";
+          return false;
+        }
+        stack[depth++] = variables[reg];
+      }
+    } else if (arity > 0) {
+      if (depth < arity) {
+        compiler.error = "Stack underflow";
+        return false;
+      }
+      uint8_t right = (arity == 2) ? stack[--depth] : VM_NO_NODE;
+      uint8_t left = stack[--depth];
+      uint8_t kind = compiler.nodes[left].kind;
+      if (right != VM_NO_NODE) {
+        kind = max(kind, compiler.nodes[right].kind);
+      }
+
+      if (kind == VM_KIND_CONST) {
+        // Constant folding - the operands simply become unreferenced
+        int32_t b = (right != VM_NO_NODE) ? compiler.nodes[right].value : 0;
+        stack[depth] = addNode(compiler, VM_PUSH, VM_KIND_CONST,
+                               applyOperation(op, compiler.nodes[left].value, b));
+        compiler.folded++;
+      } else {
+        stack[depth] = addNode(compiler, op, kind, 0);
+        if (stack[depth] != VM_NO_NODE) {
+          compiler.nodes[stack[depth]].left = left;
+          compiler.nodes[stack[depth]].right = right;
+          useNode(compiler, left);
+          if (right != VM_NO_NODE) useNode(compiler, right);
+        }
+      }
+      if (stack[depth++] == VM_NO_NODE) return false;
+    } else {
+      compiler.error = "Unknown opcode";
+      return false;
+    }
+  }
+
+  if (depth != 3) {
+    compiler.error = "Program must leave exactly three values";
+    return false;
+  }
+  for (uint8_t i = 0; i < 3; i++) {
+    roots[i] = stack[i];
+    useNode(compiler, roots[i]);
+  }
+  return true;
+}
+
+static int8_t stackEffect(uint8_t op) {
+  if (isInputOp(op) || op == VM_LOAD) return 1;
+  if (op == VM_STORE) return -1;
+  return (operationArity(op) == 2) ? -1 : 0;  // Fused forms and VM_TEE leave the depth alone
+}
+
+static bool append(VmCompiler& compiler, VmProgram& program, uint8_t op, uint8_t reg, int32_t value) {
+  if (program.count >= PIXEL_VM_MAX_INSTRUCTIONS) {
+    compiler.error = "Compiled program too long";
+    return false;
+  }
+  program.depth += stackEffect(op);
+  if (program.depth > PIXEL_VM_STACK_DEPTH) {
+    compiler.error = "Stack overflow";
+    return false;
+  }
+  program.maxDepth = max(program.maxDepth, program.depth);
+
+  PixelVmInstruction& instruction = program.code[program.count++];
+  instruction.op = op;
+  instruction.reg = reg;
+  instruction.value = value;
+  return true;
+}
+
+static bool allocateRegister(VmCompiler& compiler, VmNode& node) {
+  if (compiler.nextRegister >= PIXEL_VM_REGISTERS) {
+    compiler.error = "Out of registers";
+    return false;
+  }
+  node.reg = compiler.nextRegister++;
+  return true;
+}
+
+static bool emitNode(VmCompiler& compiler, uint8_t index, bool toFrame);
+static bool emitOperation(VmCompiler& compiler, VmNode& node, bool toFrame);
+
+// Pixel-invariant subtree: computed once per frame into a register
+static bool hoistToFrame(VmCompiler& compiler, VmNode& node) {
+  return emitOperation(compiler, node, true) &&
+         allocateRegister(compiler, node) &&
+         append(compiler, compiler.frame, VM_STORE, node.reg, 0);
+}
+
+static bool emitOperation(VmCompiler& compiler, VmNode& node, bool toFrame) {
+  VmProgram& program = toFrame ? compiler.frame : compiler.pixel;
+  if (!emitNode(compiler, node.left, toFrame)) return false;
+  if (node.right == VM_NO_NODE) {
+    return append(compiler, program, node.op, 0, 0);
+  }
+
+  // A right operand that is a constant or already in a register fuses into the operation
+  VmNode& right = compiler.nodes[node.right];
+  if (right.op == VM_PUSH) {
+    return append(compiler, program, node.op + VM_IMMEDIATE_FORM, 0, right.value);
+  }
+  if (right.reg == VM_NO_REGISTER && right.kind == VM_KIND_FRAME && !toFrame && !isInputOp(right.op) &&
+      !hoistToFrame(compiler, right)) {
+    return false;
+  }
+  if (right.reg != VM_NO_REGISTER) {
+    return append(compiler, program, node.op + VM_REGISTER_FORM, right.reg, 0);
+  }
+  return emitNode(compiler, node.right, toFrame) && append(compiler, program, node.op, 0, 0);
+}
+
+static bool emitNode(VmCompiler& compiler, uint8_t index, bool toFrame) {
+  VmNode& node = compiler.nodes[index];
+  VmProgram& program = toFrame ? compiler.frame : compiler.pixel;
+
+  if (node.reg != VM_NO_REGISTER) {
+    return append(compiler, program, VM_LOAD, node.reg, 0);
+  }
+  if (isInputOp(node.op)) {
+    return append(compiler, program, node.op, 0, node.value);
+  }
+
+  if (node.kind == VM_KIND_FRAME && !toFrame) {
+    // Pixel-invariant subtree: compute once per frame, pixels just load it
+    return hoistToFrame(compiler, node) && append(compiler, program, VM_LOAD, node.reg, 0);
+  }
+
+  if (!emitOperation(compiler, node, toFrame)) return false;
+  if (node.uses > 1) {
+    // Shared sub-expression: keep a copy for the later uses
+    return allocateRegister(compiler, node) && append(compiler, program, VM_TEE, node.reg, 0);
+  }
+  return true;
+}
+
+bool loadPixelVmProgram(const uint8_t* data, size_t length, const char** error) {
+  static VmCompiler compiler;
+  memset(&compiler, 0, sizeof(compiler));
+  compiler.error = "Malformed program";
+
+  PixelVmHeader header;
+  bool valid = length >= sizeof(header) && length <= PIXEL_VM_MAX_CODE;
+  if (valid) {
+    memcpy(&header, data, sizeof(header));
+    valid = header.magic == PIXEL_VM_MAGIC && header.output <= PIXEL_VM_OUTPUT_RGB &&
+            header.codeLength == length - sizeof(header);
+    if (!valid) compiler.error = "Bad header";
+  }
+
+  uint8_t roots[3];
+  if (valid) {
+    valid = decodeProgram(compiler, data + sizeof(header), header.codeLength, roots);
+  }
+  for (uint8_t i = 0; valid && i < 3; i++) {
+    valid = emitNode(compiler, roots[i], false);
+  }
+
+  if (!valid) {
+    if (error != NULL) *error = compiler.error;
+    return false;
+  }
+
+  pixelProgram = compiler.pixel;
+  frameProgram = compiler.frame;
+  outputMode = header.output;
+  foldedNodes = compiler.folded;
+  memcpy(programSource, data, length);
+  programSourceLength = length;
+  programLoaded = true;
+
+  Serial.printf("🧮 Pixel VM program loaded: %u pixel + %u frame instructions, %u folded, stack %u\n",
+                pixelProgram.count, frameProgram.count, foldedNodes,
+                max(pixelProgram.maxDepth, frameProgram.maxDepth));
+  return true;
+}
+
+bool savePixelVmProgram() {
+  if (!programLoaded) {
+    return false;
+  }
+  Preferences preferences;
+  if (!preferences.begin("pixelvm", false)) {
+    return false;
+  }
+  bool saved = preferences.putBytes("program", programSource, programSourceLength) == programSourceLength;
+  preferences.end();
+  return saved;
+}
+
+void initializePixelVm() {
+  // Restore the last uploaded pattern, if any
+  Preferences preferences;
+  if (!preferences.begin("pixelvm", true)) {
+    return;
+  }
+  size_t length = preferences.getBytesLength("program");
+  if (length > 0 && length <= PIXEL_VM_MAX_CODE) {
+    static uint8_t saved[PIXEL_VM_MAX_CODE];
+    preferences.getBytes("program", saved, length);
+    const char* error = NULL;
+    if (!loadPixelVmProgram(saved, length, &error)) {
+      Serial.printf("❌ Saved pixel VM program rejected: %s\n", error);
+    }
+  }
+  preferences.end();
+}
+
+bool isPixelVmLoaded() {
+  return programLoaded;
+}
+
+size_t copyPixelVmProgram(uint8_t* out, size_t capacity) {
+  if (!programLoaded || programSourceLength > capacity) {
+    return 0;
+  }
+  memcpy(out, programSource, programSourceLength);
+  return programSourceLength;
+}
+
+void unloadPixelVmProgram() {
+  programLoaded = false;
+  programSourceLength = 0;
+}
+
+void beginPixelVmFrame(const PixelVmFrame& frame) {
+  currentFrame = frame;
+  int32_t stack[PIXEL_VM_STACK_DEPTH];
+  runProgram(frameProgram, stack, 0, 0, 0);
+}
+
+static inline uint8_t unitToByte(int32_t value) {
+  if (value <= 0) return 0;
+  if (value >= VM_ONE) return 255;
+  return (uint8_t)((value * 255 + VM_ONE / 2) >> 16);
+}
+
+CRGB evaluatePixelVm(float x, float y) {
+  int32_t stack[PIXEL_VM_STACK_DEPTH];
+  int32_t index = ((int)y * MATRIX_WIDTH + (int)x) * VM_ONE;
+  int32_t* top = runProgram(pixelProgram, stack, (int32_t)(x * VM_ONE), (int32_t)(y * VM_ONE), index);
+
+  if (outputMode == PIXEL_VM_OUTPUT_RGB) {
+    return CRGB(unitToByte(top[-3]), unitToByte(top[-2]), unitToByte(top[-1]));
+  }
+  // Hue wraps: the fractional part maps onto the colour wheel
+  return CHSV((uint8_t)(top[-3] >> 8), unitToByte(top[-2]), unitToByte(top[-1]));
+}
+
+uint8_t getPixelVmPixelInstructions() {
+  return pixelProgram.count;
+}
+
+uint8_t getPixelVmFrameInstructions() {
+  return frameProgram.count;
+}
+
+uint16_t getPixelVmFoldedNodes() {
+  return foldedNodes;
+}
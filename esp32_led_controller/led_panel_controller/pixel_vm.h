@@ -0,0 +1,115 @@
+/*
+ * Pixel VM Module
+ * Stack-based fixed-point bytecode evaluated per pixel for user-uploaded
+ * patterns (compiled from expressions by pattern_compiler.py)
+ */
+
+#ifndef PIXEL_VM_H
+#define PIXEL_VM_H
+
+#include "config.h"
+#include <FastLED.h>
+
+// Limits for a loaded program
+#ifndef PIXEL_VM_MAX_CODE
+#define PIXEL_VM_MAX_CODE 512         // Uploaded bytecode bytes (header included)
+#endif
+#ifndef PIXEL_VM_MAX_NODES
+#define PIXEL_VM_MAX_NODES 96         // Expression nodes after decoding
+#endif
+#ifndef PIXEL_VM_MAX_INSTRUCTIONS
+#define PIXEL_VM_MAX_INSTRUCTIONS 96  // Per compiled program (pixel and frame each)
+#endif
+#define PIXEL_VM_STACK_DEPTH 16
+#define PIXEL_VM_REGISTERS 16
+
+// Render-time budget: the frame-check test program may cost at most this many
+// Ripples frames (checked by test/frame_check)
+#ifndef PIXEL_VM_BUDGET_RATIO
+#define PIXEL_VM_BUDGET_RATIO 2.0f
+#endif
+
+// Uploaded program layout (little-endian): PixelVmHeader then codeLength bytes.
+// Values are Q16.16 fixed point; the code must leave exactly three values on the
+// stack - h, s, v or r, g, b in 0..1 (hue wraps, the rest are clamped).
+#define PIXEL_VM_MAGIC 0x31564C42     // "LBV1"
+
+enum PixelVmOutput {
+  PIXEL_VM_OUTPUT_HSV = 0,
+  PIXEL_VM_OUTPUT_RGB = 1
+};
+
+struct __attribute__((packed)) PixelVmHeader {
+  uint32_t magic;
+  uint8_t output;       // PixelVmOutput
+  uint8_t reserved;
+  uint16_t codeLength;
+};
+
+// Opcodes - stack effect in brackets
+enum PixelVmOp {
+  VM_PUSH = 0x01,       // int32 immediate [-> a]
+  VM_X = 0x02,          // column, 0..15 [-> x]
+  VM_Y = 0x03,          // row, 0..15 [-> y]
+  VM_INDEX = 0x04,      // logical pixel index x + y * width [-> i]
+  VM_T = 0x05,          // seconds since boot (wraps after ~9 hours) [-> t]
+  VM_GRAVITY_X = 0x06,  // accelerometer gravity [-> gx]
+  VM_GRAVITY_Y = 0x07,  // [-> gy]
+  VM_BATTERY = 0x08,    // charge, 0..1 [-> b]
+  VM_LOAD = 0x09,       // uint8 register [-> r]
+  VM_STORE = 0x0A,      // uint8 register [a ->]
+  VM_ADD = 0x10,        // [a b -> a+b]
+  VM_SUB = 0x11,
+  VM_MUL = 0x12,
+  VM_DIV = 0x13,        // x/0 = 0
+  VM_MOD = 0x14,        // floored, x%0 = 0
+  VM_MIN = 0x15,
+  VM_MAX = 0x16,
+  VM_NEG = 0x20,        // [a -> -a]
+  VM_ABS = 0x21,
+  VM_SIN = 0x22,        // radians
+  VM_COS = 0x23,
+  VM_SQRT = 0x24,       // negative -> 0
+  VM_FLOOR = 0x25,
+  VM_FRACT = 0x26
+};
+
+// One decoded instruction of a compiled program
+struct PixelVmInstruction {
+  uint8_t op;
+  uint8_t reg;
+  int32_t value;
+};
+
+// Per-frame inputs shared by every pixel
+struct PixelVmFrame {
+  int32_t t;
+  int32_t gravityX;
+  int32_t gravityY;
+  int32_t battery;
+};
+
+// Function declarations
+void initializePixelVm();
+
+// Decodes, constant-folds and hoists pixel-invariant work into a per-frame program.
+// Returns false (with a reason in 'error') and keeps the previous program on failure.
+bool loadPixelVmProgram(const uint8_t* data, size_t length, const char** error);
+bool savePixelVmProgram();
+bool isPixelVmLoaded();
+
+// Frame check: copy the uploaded program out before loading a test program, then
+// reload the copy (or unload if there was none). Returns the length, 0 if none.
+size_t copyPixelVmProgram(uint8_t* out, size_t capacity);
+void unloadPixelVmProgram();
+
+// Runs the per-frame program, then evaluates pixels against its results
+void beginPixelVmFrame(const PixelVmFrame& frame);
+CRGB evaluatePixelVm(float x, float y);
+
+// Stats for /status
+uint8_t getPixelVmPixelInstructions();
+uint8_t getPixelVmFrameInstructions();
+uint16_t getPixelVmFoldedNodes();
+
+#endif // PIXEL_VM_H
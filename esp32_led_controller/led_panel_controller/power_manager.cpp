@@ -0,0 +1,180 @@
+/*
+ * Power Manager Module Implementation
+ * Idle power stages - dim, light sleep, deep sleep - left on a button press or
+ * when the MPU6050 motion interrupt reports the panel being picked up or tilted
+ */
+
+#include "power_manager.h"
+#include "led_control.h"
+#include "compositor.h"
+#include "frame_queue.h"
+#include "sensor_manager.h"
+#include "resume_state.h"
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+
+static PowerState powerState = POWER_ACTIVE;
+static unsigned long lastActivityMillis = 0;
+static uint8_t brightnessBeforeDim = BRIGHTNESS_100_PERCENT;
+static uint32_t lightSleeps = 0;
+static const char* lastWakeSource = "power-on";
+
+static const char* const powerStateNames[] = {"active", "dimmed", "lightSleep", "deepSleep"};
+static const uint8_t buttonPins[] = {BUTTON_PIN_1, BUTTON_PIN_2, BUTTON_PIN_3};
+
+// Deep sleep can only wake on RTC GPIOs; light sleep wakes on any pin
+static bool motionDeepWakeAvailable() {
+#if MPU6050_INT_PIN >= 0
+  return esp_sleep_is_valid_wakeup_gpio((gpio_num_t)MPU6050_INT_PIN);
+#else
+  return false;
+#endif
+}
+
+void initializePowerManager() {
+  lastActivityMillis = millis();
+  
+  esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+  if (cause == ESP_SLEEP_WAKEUP_EXT0) {
+    lastWakeSource = "button";
+  } else if (cause == ESP_SLEEP_WAKEUP_EXT1) {
+    lastWakeSource = "motion";
+  }
+  if (cause == ESP_SLEEP_WAKEUP_EXT0 || cause == ESP_SLEEP_WAKEUP_EXT1) {
+    Serial.printf("⏰ Woke from deep sleep (%s)\n", lastWakeSource);
+  }
+  
+#if ENABLE_AUTO_SLEEP
+  Serial.printf("😴 Auto-sleep: dim after %lus, light sleep after %lus, deep sleep after %lus idle\n",
+                IDLE_DIM_MS / 1000, IDLE_LIGHT_SLEEP_MS / 1000, IDLE_DEEP_SLEEP_MS / 1000);
+#if MPU6050_INT_PIN >= 0 && ENABLE_DEEP_SLEEP
+  if (!motionDeepWakeAvailable()) {
+    Serial.printf("⚠️ MPU6050 INT on GPIO %d is not an RTC pin - deep sleep wakes on button 1 only\n", MPU6050_INT_PIN);
+  }
+#endif
+#endif
+}
+
+void noteUserActivity() {
+  lastActivityMillis = millis();
+  if (powerState == POWER_DIMMED) {
+    setBrightness(brightnessBeforeDim);
+    powerState = POWER_ACTIVE;
+    Serial.println("☀️ Activity - brightness restored");
+  }
+}
+
+static void enterDeepSleep(bool motionWake) {
+  bool tiltWake = motionWake && motionDeepWakeAvailable();
+  Serial.printf("💤 Still idle - deep sleep until button 1%s\n", tiltWake ? " or tilt" : "");
+  powerState = POWER_DEEP_SLEEP;
+  
+  // The wake picks up the same pattern at the pre-dim brightness
+  saveResumeState(brightnessBeforeDim);
+  Serial.flush();
+  
+  esp_sleep_enable_ext0_wakeup((gpio_num_t)BUTTON_PIN_1, 0);
+#if MPU6050_INT_PIN >= 0
+  if (tiltWake) {
+    esp_sleep_enable_ext1_wakeup(1ULL << MPU6050_INT_PIN, ESP_EXT1_WAKEUP_ANY_HIGH);
+  }
+#endif
+  esp_deep_sleep_start();
+}
+
+static void enterLightSleep() {
+  Serial.printf("😴 Idle for %lus - light sleep until the panel is moved\n", getIdleMillis() / 1000);
+  Serial.flush();
+  
+  disableLEDPower();
+  bool motionWake = armMotionWake();
+  
+  // Level wakeups: the motion interrupt is latched high, buttons pull low
+#if MPU6050_INT_PIN >= 0
+  if (motionWake) {
+    gpio_wakeup_enable((gpio_num_t)MPU6050_INT_PIN, GPIO_INTR_HIGH_LEVEL);
+  }
+#endif
+  for (uint8_t pin : buttonPins) {
+    gpio_wakeup_enable((gpio_num_t)pin, GPIO_INTR_LOW_LEVEL);
+  }
+  esp_sleep_enable_gpio_wakeup();
+#if ENABLE_DEEP_SLEEP
+  esp_sleep_enable_timer_wakeup((uint64_t)(IDLE_DEEP_SLEEP_MS - IDLE_LIGHT_SLEEP_MS) * 1000);
+#endif
+  
+  powerState = POWER_LIGHT_SLEEP;
+  lightSleeps++;
+  unsigned long sleepStart = millis();
+  esp_light_sleep_start();
+  esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+  
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+  for (uint8_t pin : buttonPins) {
+    gpio_wakeup_disable((gpio_num_t)pin);
+  }
+#if MPU6050_INT_PIN >= 0
+  if (motionWake) {
+    gpio_wakeup_disable((gpio_num_t)MPU6050_INT_PIN);
+  }
+#endif
+  
+  if (cause == ESP_SLEEP_WAKEUP_TIMER) {
+    enterDeepSleep(motionWake);
+  }
+  
+#if MPU6050_INT_PIN >= 0
+  lastWakeSource = (motionWake && digitalRead(MPU6050_INT_PIN) == HIGH) ? "motion" : "button";
+#else
+  lastWakeSource = "button";
+#endif
+  disarmMotionWake();
+  
+  // Everything on the panel has to be drawn again
+  enableLEDPower();
+  setBrightness(brightnessBeforeDim);
+  invalidateCompositor();
+  noteMainLoopTick();
+  powerState = POWER_ACTIVE;
+  lastActivityMillis = millis();
+  Serial.printf("⏰ Woke from light sleep (%s) after %lus\n", lastWakeSource, (millis() - sleepStart) / 1000);
+}
+
+void updatePowerManager() {
+#if ENABLE_AUTO_SLEEP
+  // Handling the panel counts as activity
+  if ((long)(getLastMotionTime() - lastActivityMillis) > 0) {
+    noteUserActivity();
+  }
+  
+  unsigned long idle = getIdleMillis();
+  if (powerState == POWER_ACTIVE && idle >= IDLE_DIM_MS) {
+    brightnessBeforeDim = getCurrentBrightness();
+    setBrightness(min(brightnessBeforeDim, (uint8_t)IDLE_DIM_BRIGHTNESS));
+    powerState = POWER_DIMMED;
+    Serial.printf("🌙 Idle for %lus - dimmed\n", idle / 1000);
+  } else if (powerState == POWER_DIMMED && idle >= IDLE_LIGHT_SLEEP_MS) {
+    enterLightSleep();
+  }
+#endif
+}
+
+PowerState getPowerState() {
+  return powerState;
+}
+
+const char* getPowerStateName() {
+  return powerStateNames[powerState];
+}
+
+const char* getLastWakeSource() {
+  return lastWakeSource;
+}
+
+unsigned long getIdleMillis() {
+  return millis() - lastActivityMillis;
+}
+
+uint32_t getLightSleepCount() {
+  return lightSleeps;
+}
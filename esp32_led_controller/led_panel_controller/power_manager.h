@@ -0,0 +1,46 @@
+/*
+ * Power Manager Module
+ * Idle power stages - dim, light sleep, deep sleep - left on a button press or
+ * when the MPU6050 motion interrupt reports the panel being picked up or tilted
+ */
+
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include "config.h"
+
+#ifndef ENABLE_AUTO_SLEEP
+#define ENABLE_AUTO_SLEEP 1
+#endif
+#ifndef IDLE_DIM_MS
+#define IDLE_DIM_MS 120000UL
+#endif
+#ifndef IDLE_LIGHT_SLEEP_MS
+#define IDLE_LIGHT_SLEEP_MS 600000UL
+#endif
+#ifndef IDLE_DEEP_SLEEP_MS
+#define IDLE_DEEP_SLEEP_MS 3600000UL
+#endif
+#ifndef IDLE_DIM_BRIGHTNESS
+#define IDLE_DIM_BRIGHTNESS 40
+#endif
+
+enum PowerState {
+  POWER_ACTIVE,
+  POWER_DIMMED,
+  POWER_LIGHT_SLEEP,
+  POWER_DEEP_SLEEP
+};
+
+// Function declarations
+void initializePowerManager();
+void updatePowerManager();          // Main loop; may sleep in place and return after the wake
+void noteUserActivity();            // Buttons and web requests (motion is read from the sensor manager)
+
+PowerState getPowerState();
+const char* getPowerStateName();
+const char* getLastWakeSource();
+unsigned long getIdleMillis();
+uint32_t getLightSleepCount();
+
+#endif // POWER_MANAGER_H
@@ -0,0 +1,92 @@
+/*
+ * Resume State Module Implementation
+ * Snapshot of the running pattern, brightness settings and IMU calibration kept
+ * in RTC slow memory across an idle deep sleep, so the wake skips the cold boot
+ */
+
+#include "resume_state.h"
+#include "pattern_engine.h"
+#include "led_control.h"
+#include "sensor_manager.h"
+#include <esp_sleep.h>
+
+#define RESUME_STATE_MAGIC 0x31535752     // "RWS1"
+#define RESUME_STATE_VERSION 1            // Bump when ResumeState changes meaning
+
+struct ResumeState {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;
+  PatternSnapshot patterns;
+  uint8_t manualBrightnessLevel;
+  uint8_t brightness;
+  uint8_t keyframeInterval;
+  bool calibrationValid;
+  uint16_t transitionMs;
+  ImuCalibration calibration;
+  uint32_t checksum;
+};
+
+// RTC slow memory keeps its contents through deep sleep (not through power loss)
+RTC_DATA_ATTR static ResumeState rtcResumeState;
+static bool resumeStateLoaded = false;
+
+// FNV-1a over everything before the checksum
+static uint32_t resumeChecksum(const ResumeState& state) {
+  const uint8_t* bytes = (const uint8_t*)&state;
+  uint32_t hash = 0x811C9DC5;
+  for (size_t i = 0; i < offsetof(ResumeState, checksum); i++) {
+    hash ^= bytes[i];
+    hash *= 0x01000193;
+  }
+  return hash;
+}
+
+void saveResumeState(uint8_t brightness) {
+  memset(&rtcResumeState, 0, sizeof(rtcResumeState));  // Padding is part of the checksum
+  rtcResumeState.magic = RESUME_STATE_MAGIC;
+  rtcResumeState.version = RESUME_STATE_VERSION;
+  rtcResumeState.size = sizeof(ResumeState);
+  snapshotPatterns(rtcResumeState.patterns);
+  rtcResumeState.manualBrightnessLevel = manualBrightnessLevel;
+  rtcResumeState.brightness = brightness;
+  rtcResumeState.keyframeInterval = keyframeInterval;
+  rtcResumeState.transitionMs = patternTransitionMs;
+  rtcResumeState.calibrationValid = getImuCalibration(rtcResumeState.calibration);
+  rtcResumeState.checksum = resumeChecksum(rtcResumeState);
+  
+  Serial.printf("💾 Resume state saved (pattern %d, %d bytes of pattern state)\n",
+                rtcResumeState.patterns.pattern, rtcResumeState.patterns.arenaUsed);
+}
+
+bool loadResumeState() {
+  // RTC memory also survives watchdog and software resets - only trust it after a sleep
+  esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+  bool wokeFromSleep = (cause == ESP_SLEEP_WAKEUP_EXT0 || cause == ESP_SLEEP_WAKEUP_EXT1 ||
+                        cause == ESP_SLEEP_WAKEUP_TIMER);
+  bool valid = wokeFromSleep && rtcResumeState.magic == RESUME_STATE_MAGIC &&
+               rtcResumeState.version == RESUME_STATE_VERSION &&
+               rtcResumeState.size == sizeof(ResumeState) &&
+               rtcResumeState.checksum == resumeChecksum(rtcResumeState) &&
+               rtcResumeState.patterns.pattern <= PATTERN_CUSTOM &&
+               rtcResumeState.patterns.arenaUsed <= PATTERN_ARENA_SIZE;
+  
+  // One use only - a later crash must not bring back stale state
+  rtcResumeState.magic = 0;
+  resumeStateLoaded = valid;
+  return valid;
+}
+
+void applyResumeState() {
+  if (!resumeStateLoaded) {
+    return;
+  }
+  restorePatterns(rtcResumeState.patterns);
+  setKeyframeInterval(rtcResumeState.keyframeInterval);
+  patternTransitionMs = rtcResumeState.transitionMs;
+  manualBrightnessLevel = rtcResumeState.manualBrightnessLevel;
+  setBrightness(rtcResumeState.brightness);
+  if (rtcResumeState.calibrationValid) {
+    presetImuCalibration(rtcResumeState.calibration);
+  }
+}
@@ -0,0 +1,20 @@
+/*
+ * Resume State Module
+ * Snapshot of the running pattern, brightness settings and IMU calibration kept
+ * in RTC slow memory across an idle deep sleep, so the wake skips the cold boot
+ */
+
+#ifndef RESUME_STATE_H
+#define RESUME_STATE_H
+
+#include "config.h"
+
+// Function declarations
+// Called right before esp_deep_sleep_start() with the brightness to come back at
+void saveResumeState(uint8_t brightness);
+// True when this boot is a wake from deep sleep with a valid snapshot (consumed once)
+bool loadResumeState();
+// After initializePatterns(): pattern, brightness and calibration from the snapshot
+void applyResumeState();
+
+#endif // RESUME_STATE_H
@@ -0,0 +1,213 @@
+/*
+ * Runtime Governor Module Implementation
+ * Picks the highest brightness that still lasts a user-set runtime, from the
+ * discharge rate measured by the fuel gauge (CRATE, or SOC history on ADC) and
+ * how much light the panel is actually putting out
+ */
+
+#include "runtime_governor.h"
+#include "battery_manager.h"
+#include "led_control.h"
+#include "alloc_guard.h"
+#include "frame_queue.h"
+
+#define GOVERNOR_SMOOTHING 0.2          // Weight of each new discharge sample
+#define CONTENT_SMOOTHING 0.05          // Weight of each content sample (~10 s at 500 ms)
+#define GOVERNOR_MAX_TARGET_HOURS 48.0
+#define SOC_SLOPE_MIN_MS 300000UL       // ADC fallback: SOC history spans at least this long
+#define SOC_SLOPE_MIN_DROP 1.0          // ...and at least this many percent
+
+static bool targetSet = false;
+static unsigned long targetDeadline = 0;
+static bool governing = false;
+static uint8_t brightnessCeiling = 255;
+static unsigned long lastGovernorUpdate = 0;
+static uint32_t lastBatteryVersion = 0;
+
+// Discharge model: drain = base + perLoad * load. WS2812 current follows the pixel
+// values sent and the brightness they are scaled by, so load is brightness times the
+// shown frame's content (0..1 of full white). Frame rate only moves the CPU share,
+// which the base covers. Drain and the load it was measured at are smoothed together.
+static bool drainMeasured = false;
+static float drainRate = 0.0;
+static float drainLoad = 0.0;
+static const char* drainSource = "none";
+static float socAnchor = -1.0;
+static unsigned long socAnchorMillis = 0;
+
+// Content sampled from the frames actually sent, averaged over each drain sample
+static float contentLevel = -1.0;       // Smoothed, -1 until the first sample
+static float windowLoad = 0.0;
+static uint32_t windowSamples = 0;
+static unsigned long lastContentSample = 0;
+
+// Mean channel value of the composed frame (before FastLED's brightness scaling).
+// Read under the output lock - the frame pump composes into leds[] during a stall.
+static float measureContent() {
+  uint32_t total = 0;
+  lockFrameOutput();
+  for (int i = 0; i < NUM_LEDS; i++) {
+    total += leds[i].r + leds[i].g + leds[i].b;
+  }
+  unlockFrameOutput();
+  return total / (NUM_LEDS * 765.0f);
+}
+
+static void sampleContent() {
+  float content = measureContent();
+  contentLevel = (contentLevel < 0) ? content : contentLevel + (content - contentLevel) * CONTENT_SMOOTHING;
+  windowLoad += getCurrentBrightness() * content;
+  windowSamples++;
+}
+
+// Load since the previous drain sample - the charge rate covers the same stretch
+static float takeWindowLoad() {
+  float load = (windowSamples > 0) ? windowLoad / windowSamples
+                                   : getCurrentBrightness() * max(contentLevel, 0.0f);
+  windowLoad = 0.0;
+  windowSamples = 0;
+  return load;
+}
+
+static void addDrainSample(const BatteryState& battery) {
+  float sample;
+  if (battery.fuelGaugeWorking) {
+    sample = -battery.chargeRate;
+    drainSource = "crate";
+  } else {
+    // The ADC has no rate register - use the SOC slope once it has moved far enough
+    unsigned long now = millis();
+    if (socAnchor < 0 || battery.percentage > socAnchor) {
+      socAnchor = battery.percentage;
+      socAnchorMillis = now;
+      return;
+    }
+    if (now - socAnchorMillis < SOC_SLOPE_MIN_MS || socAnchor - battery.percentage < SOC_SLOPE_MIN_DROP) {
+      return;
+    }
+    sample = (socAnchor - battery.percentage) * 3600000.0 / (now - socAnchorMillis);
+    socAnchor = battery.percentage;
+    socAnchorMillis = now;
+    drainSource = "soc";
+  }
+  float load = takeWindowLoad();
+  if (sample <= 0) {
+    return;  // Briefly on external power, or the gauge has not settled
+  }
+
+  if (!drainMeasured) {
+    drainRate = sample;
+    drainLoad = load;
+    drainMeasured = true;
+  } else {
+    drainRate += (sample - drainRate) * GOVERNOR_SMOOTHING;
+    drainLoad += (load - drainLoad) * GOVERNOR_SMOOTHING;
+  }
+}
+
+static void releaseLimits() {
+  if (brightnessCeiling != 255) {
+    printfNoAlloc("⏱️ Runtime governor released\n");
+  }
+  brightnessCeiling = 255;
+}
+
+void setRuntimeTarget(float hours) {
+  if (hours <= 0) {
+    targetSet = false;
+    Serial.println("⏱️ Runtime target cleared");
+  } else {
+    hours = min(hours, (float)GOVERNOR_MAX_TARGET_HOURS);
+    targetSet = true;
+    targetDeadline = millis() + (unsigned long)(hours * 3600000.0);
+    Serial.printf("⏱️ Runtime target: %.1f more hours\n", hours);
+  }
+  // Apply on the next loop rather than waiting out the update period
+  lastGovernorUpdate = millis() - GOVERNOR_UPDATE_MS;
+}
+
+void updateRuntimeGovernor() {
+  if (millis() - lastContentSample >= GOVERNOR_CONTENT_SAMPLE_MS) {
+    lastContentSample = millis();
+    sampleContent();
+  }
+
+  // Each battery publish is one sample - the snapshot version says when there is a new one
+  uint32_t version = snapshotVersion(batterySnapshot);
+  if (version != lastBatteryVersion) {
+    lastBatteryVersion = version;
+    BatteryState battery = readSnapshot(batterySnapshot);
+    if (!battery.charging) {
+      addDrainSample(battery);
+    } else {
+      takeWindowLoad();  // Nothing drained - start the next window fresh
+    }
+  }
+
+  if (millis() - lastGovernorUpdate < GOVERNOR_UPDATE_MS) {
+    return;
+  }
+  lastGovernorUpdate = millis();
+
+  if (targetSet && (long)(millis() - targetDeadline) >= 0) {
+    targetSet = false;
+    Serial.println("⏱️ Runtime target reached");
+  }
+  BatteryState battery = readSnapshot(batterySnapshot);
+  governing = targetSet && drainMeasured && !battery.charging;
+  if (!governing) {
+    releaseLimits();
+    return;
+  }
+
+  // Drain the rest of the charge may use per hour, and the load that fits in it
+  float hoursLeft = max(getRuntimeTargetHours(), 0.01f);
+  float allowedDrain = battery.percentage / hoursLeft;
+  float drainPerLoad = max(drainRate - (float)GOVERNOR_BASE_DRAIN_PCT_HR, 0.05f) / max(drainLoad, 1.0f);
+  float allowedLoad = (allowedDrain - GOVERNOR_BASE_DRAIN_PCT_HR) / drainPerLoad;
+
+  // Brightness that puts the current content at that load - dark patterns may run brighter
+  float content = max(contentLevel, 1.0f / 255);
+  int wanted = (int)constrain(allowedLoad / content, 0.0f, 255.0f);
+
+  // Small steps so one noisy sample never visibly jumps the panel
+  int ceiling = constrain(wanted, brightnessCeiling - GOVERNOR_MAX_STEP, brightnessCeiling + GOVERNOR_MAX_STEP);
+  ceiling = constrain(ceiling, GOVERNOR_MIN_BRIGHTNESS, 255);
+  if (ceiling != brightnessCeiling) {
+    printfNoAlloc("⏱️ Runtime governor: %.1f%%/hr allowed, %.1f%%/hr measured, content %.2f -> brightness %d\n",
+                  allowedDrain, drainRate, contentLevel, ceiling);
+  }
+  brightnessCeiling = ceiling;
+}
+
+uint8_t getGovernorBrightnessCeiling() {
+  return brightnessCeiling;
+}
+
+bool isRuntimeGovernorActive() {
+  return governing;
+}
+
+float getRuntimeTargetHours() {
+  long remaining = (long)(targetDeadline - millis());
+  return (targetSet && remaining > 0) ? remaining / 3600000.0 : 0.0;
+}
+
+float getGovernorDrainRate() {
+  return drainMeasured ? drainRate : 0.0;
+}
+
+float getGovernorPredictedHours() {
+  if (!drainMeasured || drainRate <= 0) {
+    return 0.0;
+  }
+  return readSnapshot(batterySnapshot).percentage / drainRate;
+}
+
+const char* getGovernorSource() {
+  return drainSource;
+}
+
+float getGovernorContentLevel() {
+  return max(contentLevel, 0.0f);
+}
@@ -0,0 +1,44 @@
+/*
+ * Runtime Governor Module
+ * Picks the highest brightness that still lasts a user-set runtime, from the
+ * discharge rate measured by the fuel gauge (CRATE, or SOC history on ADC) and
+ * how much light the panel is actually putting out
+ */
+
+#ifndef RUNTIME_GOVERNOR_H
+#define RUNTIME_GOVERNOR_H
+
+#include "config.h"
+
+#ifndef GOVERNOR_UPDATE_MS
+#define GOVERNOR_UPDATE_MS 30000
+#endif
+#ifndef GOVERNOR_BASE_DRAIN_PCT_HR
+#define GOVERNOR_BASE_DRAIN_PCT_HR 1.2
+#endif
+#ifndef GOVERNOR_MIN_BRIGHTNESS
+#define GOVERNOR_MIN_BRIGHTNESS 40
+#endif
+#ifndef GOVERNOR_CONTENT_SAMPLE_MS
+#define GOVERNOR_CONTENT_SAMPLE_MS 500
+#endif
+#ifndef GOVERNOR_MAX_STEP
+#define GOVERNOR_MAX_STEP 16
+#endif
+
+// Function declarations
+void setRuntimeTarget(float hours);     // Run at least this much longer from now; 0 turns it off
+void updateRuntimeGovernor();           // Main loop - only works when the battery publishes new data
+
+// Limit for the brightness code (255 while off or charging)
+uint8_t getGovernorBrightnessCeiling();
+
+// Status
+bool isRuntimeGovernorActive();
+float getRuntimeTargetHours();          // Remaining until the target, 0 when off
+float getGovernorDrainRate();           // Smoothed %/hr, 0 until measured
+float getGovernorPredictedHours();      // At the current drain, 0 until measured
+const char* getGovernorSource();
+float getGovernorContentLevel();        // Smoothed pixel load of the shown frames, 0..1 of full white
+
+#endif // RUNTIME_GOVERNOR_H
@@ -4,16 +4,56 @@
  */
 
 #include "sensor_manager.h"
+#include "i2c_bus.h"
+#include "motion_fusion.h"
+#include "imu_calibration.h"
+#include "alloc_guard.h"
 
 // Hardware definitions
 #ifndef MPU6050_I2C_ADDRESS
 #define MPU6050_I2C_ADDRESS 0x68
 #endif
 
-// Gravity vector components
-float gravityX = 0.0;
-float gravityY = 1.0;
-float gravityZ = 0.0;
+// MPU6050 registers
+#define MPU6050_REG_SMPLRT_DIV 0x19
+#define MPU6050_REG_CONFIG 0x1A
+#define MPU6050_REG_GYRO_CONFIG 0x1B
+#define MPU6050_REG_ACCEL_CONFIG 0x1C
+#define MPU6050_REG_MOT_THR 0x1F
+#define MPU6050_REG_MOT_DUR 0x20
+#define MPU6050_REG_FIFO_EN 0x23
+#define MPU6050_REG_INT_PIN_CFG 0x37
+#define MPU6050_REG_INT_ENABLE 0x38
+#define MPU6050_REG_INT_STATUS 0x3A
+#define MPU6050_REG_ACCEL_XOUT_H 0x3B
+#define MPU6050_REG_TEMP_OUT_H 0x41
+#define MPU6050_REG_GYRO_XOUT_H 0x43
+#define MPU6050_REG_USER_CTRL 0x6A
+#define MPU6050_REG_PWR_MGMT_1 0x6B
+#define MPU6050_REG_PWR_MGMT_2 0x6C
+#define MPU6050_REG_FIFO_COUNT_H 0x72
+#define MPU6050_REG_FIFO_R_W 0x74
+
+#define MPU6050_FIFO_SIZE 1024
+#define MPU6050_SAMPLE_BYTES 12         // Accelerometer X, Y, Z then gyro X, Y, Z
+#define MPU6050_FIFO_MAX_BURST 10       // Samples per read (fits the 128-byte Wire buffer)
+#define MPU6050_FIFO_RESYNC_MS 1000     // Interrupt counting is checked against FIFO_COUNT this often
+#define MPU6050_READ_TIMEOUT_MS (PATTERN_UPDATE_MS * 2)
+#define MPU6050_TEMPERATURE_READ_MS 5000
+
+// Calibration capture and drift detection (raw counts: 16384 per g, 131 per °/s)
+#define IMU_CALIBRATION_SAMPLES MPU6050_SAMPLE_RATE_HZ          // One second of FIFO samples
+#define IMU_CALIBRATION_RETRY_MS 10000                          // Boot capture retries until the panel lies flat
+#define IMU_FLAT_TOLERANCE 0.17                                 // g off-axis (~10° tilt)
+#define IMU_STILL_GYRO_RANGE 400                                // Max gyro spread while still (~3°/s)
+#define IMU_STILL_GYRO_LIMIT 655                                // Bias-corrected rate still counted as still (~5°/s)
+#define IMU_DRIFT_WINDOW_SAMPLES (MPU6050_SAMPLE_RATE_HZ * 3)   // Stillness needed to judge drift
+#define IMU_DRIFT_THRESHOLD 65                                  // Residual bias worth correcting (~0.5°/s)
+#define IMU_DRIFT_SAVE_INTERVAL_MS 600000UL                     // NVS wear limit for drift updates
+#define IMU_MOTION_GYRO_LIMIT 1310                              // Rate that counts as handling the panel (~10°/s)
+
+// Gravity vector components (straight down the panel until the first sample)
+Seqlock<GravityState> gravitySnapshot(GravityState{0.0, 1.0, 0.0, 0});
 
 // Gyroscope calibration offsets
 float calibrationOffsetX = 0.0;
@@ -21,209 +61,724 @@ float calibrationOffsetY = 0.0;
 float calibrationOffsetZ = 0.0;
 bool gyroCalibrated = false;
 
-// I2C bus coordination with fuel gauge
-volatile bool pauseGyroscopeReads = false;
+// Gyro zero-rate bias (raw counts)
+float gyroBiasX = 0.0;
+float gyroBiasY = 0.0;
+float gyroBiasZ = 0.0;
+
+// Calibration capture runs over FIFO samples instead of blocking boot
+static float imuTemperatureC = 25.0;
+static float calibrationTemperatureC = 25.0;
+static bool calibrationStored = false;
+static bool calibrationCapturing = false;
+static bool calibrationRetryUntilValid = false;
+static unsigned long calibrationRetryAt = 0;
+static uint16_t captureCount = 0;
+static int32_t captureSum[6];
+static int16_t captureGyroMin[3], captureGyroMax[3];
+
+// Drift detection over still stretches
+static uint16_t stillCount = 0;
+static int32_t stillGyroSum[3];
+static int32_t stillGyroMin[3], stillGyroMax[3];
+static unsigned long lastDriftSave = 0;
+static uint32_t driftCorrections = 0;
+
+// Calibration handed over by a warm resume (used instead of the NVS copy)
+static ImuCalibration presetCalibration;
+static bool calibrationPreset = false;
+
+// Idle detection and motion wake
+static unsigned long lastMotionMillis = 0;
+static bool motionWakeArmed = false;
+
+// FIFO sampling state - the data-ready ISR counts samples so most frames need no
+// bus traffic until a whole batch is waiting
+static volatile uint16_t pendingSamples = 0;
+static volatile bool dataReadySeen = false;
+static portMUX_TYPE pendingSamplesMux = portMUX_INITIALIZER_UNLOCKED;
+static bool fifoEnabled = false;
+static unsigned long lastFifoRead = 0;
+static unsigned long lastFifoResync = 0;
+static int32_t accelOffsetCounts[3] = {0, 0, 0};
+static int32_t gyroBiasCounts[3] = {0, 0, 0};
+static bool fusionSeeded = false;
+static unsigned long burstNewestSampleMicros = 0;
+static unsigned long lastSampleMicros = 0;
+static uint32_t fifoBursts = 0;
+static uint32_t fifoSamples = 0;
+static uint32_t fifoResets = 0;
+static int consecutiveErrors = 0;
+static unsigned long errorBackoffUntil = 0;
+
+// Trace capture - restarted by a FIFO reset so the samples stay evenly spaced
+static ImuTraceSample* traceSamples = NULL;
+static uint16_t traceCapacity = 0;
+static uint16_t traceLength = 0;
+
+// Frame-path reads are queued on the bus task and collected on the next call
+static I2cTransaction fifoCountRead;
+static I2cTransaction fifoBurstRead;
+static I2cTransaction fifoResetWrites[2];
+static I2cTransaction temperatureRead;
+static unsigned long lastTemperatureRead = 0;
+
+static void IRAM_ATTR mpuDataReadyISR() {
+  portENTER_CRITICAL_ISR(&pendingSamplesMux);
+  pendingSamples++;
+  portEXIT_CRITICAL_ISR(&pendingSamplesMux);
+  dataReadySeen = true;
+}
+
+// Blocking register access - initialization and calibration only
+static bool writeMpuRegister(uint8_t reg, uint8_t value) {
+  I2cTransaction transaction = {};
+  prepareI2cWrite(&transaction, I2C_DEVICE_MPU6050, MPU6050_I2C_ADDRESS, reg, &value, 1);
+  return transferI2cBlocking(&transaction, I2C_PRIORITY_HIGH, 100);
+}
+
+static bool readMpuRegisters(uint8_t reg, uint8_t* data, uint8_t length) {
+  I2cTransaction transaction = {};
+  prepareI2cRead(&transaction, I2C_DEVICE_MPU6050, MPU6050_I2C_ADDRESS, reg, length);
+  if (!transferI2cBlocking(&transaction, I2C_PRIORITY_HIGH, 100)) {
+    return false;
+  }
+  memcpy(data, transaction.readData, length);
+  return true;
+}
+
+static void noteMpuReadError() {
+  consecutiveErrors++;
+  if (consecutiveErrors > 5) {
+    Serial.printf("⚠️ MPU6050 I2C error (attempts: %d) - backing off\n", consecutiveErrors);
+    errorBackoffUntil = millis() + 500; // Let the I2C bus settle
+    consecutiveErrors = 0;
+  }
+}
+
+static void setPendingSamples(uint16_t samples) {
+  portENTER_CRITICAL(&pendingSamplesMux);
+  pendingSamples = samples;
+  portEXIT_CRITICAL(&pendingSamplesMux);
+}
+
+static void resetMotionFifo() {
+  if (isI2cPending(&fifoResetWrites[0]) || isI2cPending(&fifoResetWrites[1])) {
+    return;  // Reset already on its way
+  }
+  // Queued back to back on one priority level, so they run in order
+  const uint8_t fifoReset = 0x04;   // FIFO_RESET (self-clearing)
+  const uint8_t fifoEnable = 0x40;  // FIFO_EN
+  prepareI2cWrite(&fifoResetWrites[0], I2C_DEVICE_MPU6050, MPU6050_I2C_ADDRESS,
+                  MPU6050_REG_USER_CTRL, &fifoReset, 1);
+  prepareI2cWrite(&fifoResetWrites[1], I2C_DEVICE_MPU6050, MPU6050_I2C_ADDRESS,
+                  MPU6050_REG_USER_CTRL, &fifoEnable, 1);
+  submitI2cTransaction(&fifoResetWrites[0], I2C_PRIORITY_HIGH, MPU6050_READ_TIMEOUT_MS);
+  submitI2cTransaction(&fifoResetWrites[1], I2C_PRIORITY_HIGH, MPU6050_READ_TIMEOUT_MS);
+  setPendingSamples(0);
+  lastFifoResync = millis();
+  fifoResets++;
+  if (traceLength < traceCapacity) {
+    traceLength = 0;
+  }
+}
+
+static void applyCalibrationCounts() {
+  // Calibration in raw counts for the fixed-point fusion
+  accelOffsetCounts[0] = lroundf(calibrationOffsetX * 16384.0);
+  accelOffsetCounts[1] = lroundf(calibrationOffsetY * 16384.0);
+  accelOffsetCounts[2] = lroundf(calibrationOffsetZ * 16384.0);
+  gyroBiasCounts[0] = lroundf(gyroBiasX);
+  gyroBiasCounts[1] = lroundf(gyroBiasY);
+  gyroBiasCounts[2] = lroundf(gyroBiasZ);
+  
+  // Reseed from the accelerometer so the fusion's learned bias starts over
+  fusionSeeded = false;
+}
+
+static float temperatureFromRegister(const uint8_t* data) {
+  return (int16_t)(data[0] << 8 | data[1]) / 340.0 + 36.53;
+}
+
+static bool storeCalibration() {
+  ImuCalibration calibration;
+  calibration.accelOffset[0] = calibrationOffsetX;
+  calibration.accelOffset[1] = calibrationOffsetY;
+  calibration.accelOffset[2] = calibrationOffsetZ;
+  calibration.gyroBias[0] = gyroBiasX;
+  calibration.gyroBias[1] = gyroBiasY;
+  calibration.gyroBias[2] = gyroBiasZ;
+  calibration.temperatureC = imuTemperatureC;
+  calibrationTemperatureC = imuTemperatureC;
+  calibrationStored = saveImuCalibration(calibration);
+  return calibrationStored;
+}
+
+static bool restoreCalibration() {
+  ImuCalibration calibration;
+  if (calibrationPreset) {
+    calibration = presetCalibration;  // Drift-corrected values carried through deep sleep
+  } else if (!loadImuCalibration(calibration)) {
+    return false;
+  }
+  calibrationOffsetX = calibration.accelOffset[0];
+  calibrationOffsetY = calibration.accelOffset[1];
+  calibrationOffsetZ = calibration.accelOffset[2];
+  gyroBiasX = calibration.gyroBias[0];
+  gyroBiasY = calibration.gyroBias[1];
+  gyroBiasZ = calibration.gyroBias[2];
+  calibrationTemperatureC = calibration.temperatureC;
+  calibrationStored = true;
+  gyroCalibrated = true;
+  return true;
+}
+
+static void enableMotionFifo() {
+  // Accelerometer and all three gyro axes into the FIFO, data-ready on INT (pulse, cleared by any read)
+  bool ok = writeMpuRegister(MPU6050_REG_FIFO_EN, 0x78) &&
+            writeMpuRegister(MPU6050_REG_INT_PIN_CFG, 0x10) &&
+            writeMpuRegister(MPU6050_REG_INT_ENABLE, 0x01);
+  if (!ok) {
+    Serial.println("❌ MPU6050 FIFO setup failed - gravity disabled");
+    return;
+  }
+  
+#if MPU6050_INT_PIN >= 0
+  // Pulled down so an unwired pin stays quiet and the FIFO count is polled instead
+  pinMode(MPU6050_INT_PIN, INPUT_PULLDOWN);
+  attachInterrupt(digitalPinToInterrupt(MPU6050_INT_PIN), mpuDataReadyISR, RISING);
+#endif
+  
+  applyCalibrationCounts();
+  
+  resetMotionFifo();
+  fifoResets = 0;
+  fifoEnabled = true;
+  Serial.printf("✅ MPU6050 FIFO at %d Hz, %d-sample bursts\n", MPU6050_SAMPLE_RATE_HZ, MPU6050_FIFO_BATCH);
+}
 
 void initMPU6050() {
   Serial.println("🔧 Initializing MPU6050...");
   
   // Test communication first
-  Wire.beginTransmission(MPU6050_I2C_ADDRESS);
-  uint8_t error = Wire.endTransmission();
-  if (error != 0) {
-    Serial.printf("❌ MPU6050 not found at address 0x%02X (error %d)\n", MPU6050_I2C_ADDRESS, error);
+  I2cTransaction probe = {};
+  prepareI2cProbe(&probe, MPU6050_I2C_ADDRESS);
+  if (!transferI2cBlocking(&probe, I2C_PRIORITY_HIGH, 100)) {
+    Serial.printf("❌ MPU6050 not found at address 0x%02X (error %d)\n", MPU6050_I2C_ADDRESS, probe.error);
     return;
   }
   
-  // Wake up the MPU6050
-  Wire.beginTransmission(MPU6050_I2C_ADDRESS);
-  Wire.write(0x6B);  // PWR_MGMT_1 register
-  Wire.write(0);     // set to zero (wakes up the MPU-6050)
-  Wire.endTransmission(true);
+  // Wake up the MPU6050, clocked from the X gyro PLL (more stable than the internal oscillator).
+  // PWR_MGMT_2 survives a deep sleep with the gyros in standby, so bring them back too.
+  writeMpuRegister(MPU6050_REG_PWR_MGMT_1, 0x01);
+  writeMpuRegister(MPU6050_REG_PWR_MGMT_2, 0x00);
   delay(50);
   
   // Set accelerometer range to ±2g for better sensitivity
-  Wire.beginTransmission(MPU6050_I2C_ADDRESS);
-  Wire.write(0x1C);  // ACCEL_CONFIG register
-  Wire.write(0x00);  // ±2g range
-  Wire.endTransmission(true);
+  writeMpuRegister(MPU6050_REG_ACCEL_CONFIG, 0x00);
   delay(10);
   
   // Set gyroscope range to ±250°/s
-  Wire.beginTransmission(MPU6050_I2C_ADDRESS);
-  Wire.write(0x1B);  // GYRO_CONFIG register
-  Wire.write(0x00);  // ±250°/s range
-  Wire.endTransmission(true);
+  writeMpuRegister(MPU6050_REG_GYRO_CONFIG, 0x00);
   delay(10);
   
+  // Digital low-pass filter (internal rate becomes 1 kHz), then divide down to the sample rate
+  writeMpuRegister(MPU6050_REG_CONFIG, MPU6050_DLPF_CFG);
+  writeMpuRegister(MPU6050_REG_SMPLRT_DIV, 1000 / MPU6050_SAMPLE_RATE_HZ - 1);
+  
   Serial.println("✅ MPU6050 initialized successfully");
-  delay(100);
   
-  // Auto-calibrate gyroscope with timeout protection
-  Serial.println("🎯 Starting gyroscope calibration...");
-  calibrateGyroscope();
+  uint8_t temperature[2];
+  if (readMpuRegisters(MPU6050_REG_TEMP_OUT_H, temperature, 2)) {
+    imuTemperatureC = temperatureFromRegister(temperature);
+  }
+  
+  // Stored calibration makes boot instant; drift detection keeps the gyro bias honest
+  if (restoreCalibration()) {
+    Serial.printf("✅ IMU calibration loaded (measured at %.1f°C, now %.1f°C)\n",
+                  calibrationTemperatureC, imuTemperatureC);
+  } else {
+    Serial.println("🎯 No stored IMU calibration - capturing once the panel is flat and still");
+    calibrationRetryUntilValid = true;
+    calibrateGyroscope();
+  }
+  
+  enableMotionFifo();
 }
 
 void calibrateGyroscope() {
   Serial.println("Calibrating gyroscope... Keep panel flat and still!");
-  
-  float sumX = 0, sumY = 0, sumZ = 0;
-  int samples = 50; // Reduced from 100 to speed up calibration
-  int validSamples = 0;
-  
-  for (int i = 0; i < samples && validSamples < samples; i++) {
-    // Add error checking to prevent hanging
-    Wire.beginTransmission(MPU6050_I2C_ADDRESS);
-    Wire.write(0x3B);
-    uint8_t error = Wire.endTransmission(false);
-    
-    if (error != 0) {
-      Serial.printf("Calibration I2C error %d, retrying...\n", error);
-      delay(100);
-      continue;
-    }
-    
-    Wire.requestFrom(MPU6050_I2C_ADDRESS, 6);
-    
-    // Check if data is available
-    if (Wire.available() < 6) {
-      Serial.println("Insufficient data during calibration, retrying...");
-      delay(50);
-      continue;
-    }
-    
-    int16_t AcX = Wire.read() << 8 | Wire.read();
-    int16_t AcY = Wire.read() << 8 | Wire.read();
-    int16_t AcZ = Wire.read() << 8 | Wire.read();
-    
-    // Convert to g-force (±2g range, 16-bit)
-    float accelX = (float)AcX / 16384.0;
-    float accelY = (float)AcY / 16384.0;
-    float accelZ = (float)AcZ / 16384.0;
-    
-    // Sanity check readings
-    if (abs(accelX) > 3.0 || abs(accelY) > 3.0 || abs(accelZ) > 3.0) {
-      Serial.println("Invalid reading during calibration, skipping...");
-      continue;
-    }
-    
-    sumX += accelX;
-    sumY += accelY;
-    sumZ += accelZ;
-    validSamples++;
-    
-    // Progress indicator
-    if (validSamples % 10 == 0) {
-      Serial.printf("Calibration progress: %d/%d\n", validSamples, samples);
-    }
-    
-    delay(20); // Increased delay for stability
-  }
-  
-  if (validSamples >= 10) { // Require at least 10 valid samples
-    // Calculate offsets (assuming panel is flat, Z should be ~1g, X&Y should be ~0)
-    calibrationOffsetX = sumX / validSamples;
-    calibrationOffsetY = sumY / validSamples;
-    calibrationOffsetZ = (sumZ / validSamples) - 1.0; // Subtract expected 1g
-    
-    gyroCalibrated = true;
-    
-    Serial.printf("✅ Gyroscope calibrated! (%d samples) Offsets: X=%.3f, Y=%.3f, Z=%.3f\n", 
-                  validSamples, calibrationOffsetX, calibrationOffsetY, calibrationOffsetZ);
-  } else {
-    Serial.printf("❌ Calibration failed - only %d valid samples. Using defaults.\n", validSamples);
-    calibrationOffsetX = 0.0;
-    calibrationOffsetY = 0.0;
-    calibrationOffsetZ = 0.0;
-    gyroCalibrated = false;
+  captureCount = 0;
+  memset(captureSum, 0, sizeof(captureSum));
+  for (int axis = 0; axis < 3; axis++) {
+    captureGyroMin[axis] = INT16_MAX;
+    captureGyroMax[axis] = INT16_MIN;
   }
+  calibrationCapturing = true;
 }
 
-void updateGravity() {
-  static unsigned long lastSensorUpdate = 0;
-  static int consecutiveErrors = 0;  // Track I2C errors
+static void finishCalibrationCapture() {
+  calibrationCapturing = false;
   
-  // Check if fuel gauge has requested I2C pause
-  if (pauseGyroscopeReads) {
-    return; // Skip this update - fuel gauge is using I2C bus
+  float accelX = (float)captureSum[0] / captureCount / 16384.0;
+  float accelY = (float)captureSum[1] / captureCount / 16384.0;
+  float accelZ = (float)captureSum[2] / captureCount / 16384.0;
+  bool flat = abs(accelX) < IMU_FLAT_TOLERANCE && abs(accelY) < IMU_FLAT_TOLERANCE &&
+              abs(accelZ - 1.0) < IMU_FLAT_TOLERANCE;
+  bool still = true;
+  for (int axis = 0; axis < 3; axis++) {
+    still = still && (captureGyroMax[axis] - captureGyroMin[axis] < IMU_STILL_GYRO_RANGE);
   }
   
-  // Reduce update frequency significantly to prevent I2C bus conflicts
-  if (millis() - lastSensorUpdate < 50) { // 20 FPS for stability and reduced I2C traffic
+  if (!flat || !still) {
+    // Offsets from a tilted or moving panel would skew every reading - keep the old ones
+    Serial.printf("❌ Calibration rejected - panel %s (%.2f, %.2f, %.2f g)\n",
+                  !still ? "moving" : "not flat", accelX, accelY, accelZ);
+    calibrationRetryAt = millis() + IMU_CALIBRATION_RETRY_MS;
     return;
   }
   
-  // Add staggered timing to avoid collision with fuel gauge reads
-  // Fuel gauge reads every 5000ms now, so stagger gyro reads
-  unsigned long currentTime = millis();
-  if ((currentTime % 5000) < 200) { // Avoid first 200ms of every 5-second cycle
+  // Calculate offsets (panel is flat, Z should be ~1g, X&Y should be ~0)
+  calibrationOffsetX = accelX;
+  calibrationOffsetY = accelY;
+  calibrationOffsetZ = accelZ - 1.0; // Subtract expected 1g
+  
+  // Still panel - whatever the gyro reads is zero-rate bias
+  gyroBiasX = (float)captureSum[3] / captureCount;
+  gyroBiasY = (float)captureSum[4] / captureCount;
+  gyroBiasZ = (float)captureSum[5] / captureCount;
+  
+  gyroCalibrated = true;
+  calibrationRetryUntilValid = false;
+  applyCalibrationCounts();
+  bool saved = storeCalibration();
+  
+  Serial.printf("✅ Gyroscope calibrated! (%d samples) Offsets: X=%.3f, Y=%.3f, Z=%.3f%s\n",
+                captureCount, calibrationOffsetX, calibrationOffsetY, calibrationOffsetZ,
+                saved ? "" : " (not saved)");
+  Serial.printf("   Gyro bias: X=%.1f, Y=%.1f, Z=%.1f counts at %.1f°C\n", gyroBiasX, gyroBiasY, gyroBiasZ, imuTemperatureC);
+}
+
+static void captureCalibrationSample(const int16_t* raw) {
+  for (int axis = 0; axis < 6; axis++) {
+    captureSum[axis] += raw[axis];
+  }
+  for (int axis = 0; axis < 3; axis++) {
+    captureGyroMin[axis] = min(captureGyroMin[axis], raw[3 + axis]);
+    captureGyroMax[axis] = max(captureGyroMax[axis], raw[3 + axis]);
+  }
+  if (++captureCount >= IMU_CALIBRATION_SAMPLES) {
+    finishCalibrationCapture();
+  }
+}
+
+// Gyro bias wanders with temperature; a long still stretch shows what it has become
+static void checkGyroDrift(const int32_t* accel, const int32_t* gyro) {
+  int64_t accelSquared = (int64_t)accel[0] * accel[0] + (int64_t)accel[1] * accel[1] + (int64_t)accel[2] * accel[2];
+  bool still = accelSquared > (int64_t)15565 * 15565 && accelSquared < (int64_t)17203 * 17203;  // 0.95-1.05 g
+  for (int axis = 0; axis < 3; axis++) {
+    still = still && abs(gyro[axis]) < IMU_STILL_GYRO_LIMIT;
+  }
+  if (!still) {
+    stillCount = 0;
     return;
   }
   
-  // Read accelerometer data from MPU6050 with error handling
-  Wire.beginTransmission(MPU6050_I2C_ADDRESS);
-  Wire.write(0x3B); // Starting register for accelerometer data
-  uint8_t error = Wire.endTransmission(false);
-  
-  if (error != 0) {
-    consecutiveErrors++;
-    if (consecutiveErrors > 5) { // Increased threshold to prevent constant reinit
-      Serial.printf("⚠️ MPU6050 I2C error %d (attempts: %d) - backing off\n", error, consecutiveErrors);
-      lastSensorUpdate = millis() + 500; // Back off for 500ms to let I2C bus settle
-      consecutiveErrors = 0;
+  if (stillCount == 0) {
+    for (int axis = 0; axis < 3; axis++) {
+      stillGyroSum[axis] = 0;
+      stillGyroMin[axis] = INT32_MAX;
+      stillGyroMax[axis] = INT32_MIN;
     }
-    lastSensorUpdate = millis(); // Update timestamp to prevent rapid retries
-    return;  // Skip this update
   }
-  
-  Wire.requestFrom(MPU6050_I2C_ADDRESS, 6);
-  if (Wire.available() < 6) {
-    consecutiveErrors++;
-    return;  // Skip if insufficient data
+  for (int axis = 0; axis < 3; axis++) {
+    stillGyroSum[axis] += gyro[axis];
+    stillGyroMin[axis] = min(stillGyroMin[axis], gyro[axis]);
+    stillGyroMax[axis] = max(stillGyroMax[axis], gyro[axis]);
+  }
+  if (++stillCount < IMU_DRIFT_WINDOW_SAMPLES) {
+    return;
   }
+  stillCount = 0;
   
-  consecutiveErrors = 0;  // Reset error count on success
+  float residual[3];
+  bool drifted = false;
+  for (int axis = 0; axis < 3; axis++) {
+    if (stillGyroMax[axis] - stillGyroMin[axis] >= IMU_STILL_GYRO_RANGE) {
+      return;  // Slow turn rather than drift
+    }
+    residual[axis] = (float)stillGyroSum[axis] / IMU_DRIFT_WINDOW_SAMPLES;
+    drifted = drifted || abs(residual[axis]) > IMU_DRIFT_THRESHOLD;
+  }
+  if (!drifted) {
+    return;
+  }
   
-  int16_t AcX = Wire.read() << 8 | Wire.read();
-  int16_t AcY = Wire.read() << 8 | Wire.read();
-  int16_t AcZ = Wire.read() << 8 | Wire.read();
+  gyroBiasX += residual[0];
+  gyroBiasY += residual[1];
+  gyroBiasZ += residual[2];
+  gyroCalibrated = true;
+  applyCalibrationCounts();
+  driftCorrections++;
   
-  // Apply calibration offsets and convert to g-force (±2g range = 16384 LSB/g)
-  float accelX = ((float)AcX / 16384.0) - calibrationOffsetX;
-  float accelY = ((float)AcY / 16384.0) - calibrationOffsetY;
-  float accelZ = ((float)AcZ / 16384.0) - calibrationOffsetZ;
+  bool saved = false;
+  if (!calibrationStored || millis() - lastDriftSave > IMU_DRIFT_SAVE_INTERVAL_MS) {
+    saved = storeCalibration();
+    lastDriftSave = millis();
+  }
+  printfNoAlloc("🎯 Gyro drift corrected by %.0f/%.0f/%.0f counts at %.1f°C%s\n",
+                residual[0], residual[1], residual[2], imuTemperatureC, saved ? " (saved)" : "");
+}
+
+static void applyMotionSample(const uint8_t* sample) {
+  int16_t raw[6];
+  for (int axis = 0; axis < 6; axis++) {
+    raw[axis] = (int16_t)(sample[axis * 2] << 8 | sample[axis * 2 + 1]);
+  }
   
-  // Normalize raw readings first to prevent scaling issues
-  float magnitude = sqrt(accelX*accelX + accelY*accelY + accelZ*accelZ);
-  if (magnitude > 0.1) {
-    accelX /= magnitude;
-    accelY /= magnitude;
-    accelZ /= magnitude;
+  if (calibrationCapturing) {
+    captureCalibrationSample(raw);
+  } else if (calibrationRetryUntilValid && (long)(millis() - calibrationRetryAt) >= 0) {
+    calibrateGyroscope();
   }
   
-  // Apply gentle smoothing using complementary filter to reduce jitter
-  static float filteredX = 0.0, filteredY = 0.0;
-  static bool firstReading = true;
+  int32_t accel[3], gyro[3];
+  for (int axis = 0; axis < 3; axis++) {
+    accel[axis] = raw[axis] - accelOffsetCounts[axis];
+    gyro[axis] = raw[3 + axis] - gyroBiasCounts[axis];
+  }
+  if (!calibrationCapturing) {
+    checkGyroDrift(accel, gyro);
+  }
+  if (traceLength < traceCapacity) {
+    ImuTraceSample& entry = traceSamples[traceLength++];
+    for (int axis = 0; axis < 3; axis++) {
+      entry.accel[axis] = constrain(accel[axis], INT16_MIN, INT16_MAX);
+      entry.gyro[axis] = constrain(gyro[axis], INT16_MIN, INT16_MAX);
+    }
+  }
+  if (abs(gyro[0]) > IMU_MOTION_GYRO_LIMIT || abs(gyro[1]) > IMU_MOTION_GYRO_LIMIT ||
+      abs(gyro[2]) > IMU_MOTION_GYRO_LIMIT) {
+    lastMotionMillis = millis();
+  }
   
-  if (firstReading) {
-    filteredX = accelX;
-    filteredY = accelY;
-    firstReading = false;
-  } else {
-    // Reduce filter strength to prevent jumpiness
-    float filterStrength = 0.15; // Much gentler than 0.25
-    filteredX = filterStrength * accelX + (1.0 - filterStrength) * filteredX;
-    filteredY = filterStrength * accelY + (1.0 - filterStrength) * filteredY;
+  if (!fusionSeeded) {
+    resetMotionFusion(accel);
+    fusionSeeded = true;
+  }
+  updateMotionFusion(accel, gyro);
+}
+
+// Gravity for the frame about to be drawn, predicted to when it reaches the LEDs
+static void publishGravity() {
+  if (!fusionSeeded) {
+    return;
   }
+  float gravity[3];
+  predictGravity(micros() + MOTION_PREDICTION_LEAD_MS * 1000UL - lastSampleMicros, gravity);
   
   // Map to screen coordinates with deadzone to prevent micro-movements
   float deadzone = 0.05; // Small deadzone for stability
-  float mappedX = (abs(filteredY) > deadzone) ? filteredY * 0.8 : 0.0; // Flipped for upside-down gyroscope mount
-  float mappedY = (abs(filteredX) > deadzone) ? filteredX * 0.8 : 0.0;
+  float mappedX = (abs(gravity[1]) > deadzone) ? gravity[1] * 0.8 : 0.0; // Flipped for upside-down gyroscope mount
+  float mappedY = (abs(gravity[0]) > deadzone) ? gravity[0] * 0.8 : 0.0;
   
   // Final gravity values
-  gravityX = constrain(mappedX, -1.0, 1.0);
-  gravityY = constrain(mappedY, -1.0, 1.0);
+  GravityState state;
+  state.x = constrain(mappedX, -1.0, 1.0);
+  state.y = constrain(mappedY, -1.0, 1.0);
+  state.z = gravity[2];
+  state.sampleMicros = lastSampleMicros;
+  publishSnapshot(gravitySnapshot, state);
+}
+
+static void collectFifoBurst() {
+  I2cStatus status = fifoBurstRead.status;
+  fifoBurstRead.status = I2C_IDLE;
+  if (status != I2C_DONE) {
+    noteMpuReadError();
+    resetMotionFifo();  // A partial read leaves the FIFO misaligned
+    return;
+  }
+  
+  consecutiveErrors = 0;
+  uint8_t samples = fifoBurstRead.readLength / MPU6050_SAMPLE_BYTES;
+  for (uint8_t i = 0; i < samples; i++) {
+    applyMotionSample(fifoBurstRead.readData + i * MPU6050_SAMPLE_BYTES);
+  }
+  lastSampleMicros = burstNewestSampleMicros;
+  fifoBursts++;
+  fifoSamples += samples;
+}
+
+// Returns false if the count was unusable
+static bool collectFifoCount() {
+  I2cStatus status = fifoCountRead.status;
+  fifoCountRead.status = I2C_IDLE;
+  if (status != I2C_DONE) {
+    noteMpuReadError();
+    return false;
+  }
+  
+  uint16_t bytes = (fifoCountRead.readData[0] << 8) | fifoCountRead.readData[1];
+  if (bytes >= MPU6050_FIFO_SIZE || bytes % MPU6050_SAMPLE_BYTES != 0) {
+    resetMotionFifo();  // Overflowed or lost alignment
+    return false;
+  }
+  setPendingSamples(bytes / MPU6050_SAMPLE_BYTES);
+  return true;
+}
+
+static void serviceTemperature() {
+  if (isI2cPending(&temperatureRead)) {
+    return;
+  }
+  if (temperatureRead.status == I2C_DONE) {
+    imuTemperatureC = temperatureFromRegister(temperatureRead.readData);
+  }
+  temperatureRead.status = I2C_IDLE;
+  
+  if (millis() - lastTemperatureRead >= MPU6050_TEMPERATURE_READ_MS) {
+    prepareI2cRead(&temperatureRead, I2C_DEVICE_MPU6050, MPU6050_I2C_ADDRESS, MPU6050_REG_TEMP_OUT_H, 2);
+    submitI2cTransaction(&temperatureRead, I2C_PRIORITY_NORMAL, MPU6050_TEMPERATURE_READ_MS);
+    lastTemperatureRead = millis();
+  }
+}
+
+static void serviceMotionFifo() {
+  // Last call's reads are still on the bus - samples keep queueing in the FIFO
+  if (isI2cPending(&fifoCountRead) || isI2cPending(&fifoBurstRead)) {
+    return;
+  }
+  
+  if (fifoBurstRead.status != I2C_IDLE) {
+    collectFifoBurst();
+  }
+  bool counted = false;
+  if (fifoCountRead.status != I2C_IDLE) {
+    if (!collectFifoCount()) {
+      return;
+    }
+    counted = true;
+  }
+  
+  unsigned long now = millis();
+  if ((long)(now - errorBackoffUntil) < 0) {
+    return;
+  }
+  
+  if (!counted && (!dataReadySeen || now - lastFifoResync >= MPU6050_FIFO_RESYNC_MS)) {
+    // No interrupt wired (or a periodic check): ask the FIFO directly, but only
+    // once a batch should have accumulated
+    if (!dataReadySeen && now - lastFifoRead < MPU6050_FIFO_BATCH * 1000UL / MPU6050_SAMPLE_RATE_HZ) {
+      return;
+    }
+    prepareI2cRead(&fifoCountRead, I2C_DEVICE_MPU6050, MPU6050_I2C_ADDRESS, MPU6050_REG_FIFO_COUNT_H, 2);
+    if (submitI2cTransaction(&fifoCountRead, I2C_PRIORITY_HIGH, MPU6050_READ_TIMEOUT_MS)) {
+      lastFifoResync = now;
+    }
+    return;
+  }
+  
+  uint16_t available = pendingSamples;
+  if (available < MPU6050_FIFO_BATCH) {
+    return;
+  }
+  if (available * MPU6050_SAMPLE_BYTES >= MPU6050_FIFO_SIZE) {
+    // The FIFO has wrapped and lost sample alignment
+    resetMotionFifo();
+    return;
+  }
+  
+  // One burst for the batch, applied on the next call. A backlog after a stall is
+  // read oldest-first over several calls so the gyro integration sees every sample.
+  uint16_t burst = min(available, (uint16_t)MPU6050_FIFO_MAX_BURST);
+  prepareI2cRead(&fifoBurstRead, I2C_DEVICE_MPU6050, MPU6050_I2C_ADDRESS,
+                 MPU6050_REG_FIFO_R_W, burst * MPU6050_SAMPLE_BYTES);
+  if (!submitI2cTransaction(&fifoBurstRead, I2C_PRIORITY_HIGH, MPU6050_READ_TIMEOUT_MS)) {
+    return;
+  }
+  portENTER_CRITICAL(&pendingSamplesMux);
+  pendingSamples = (pendingSamples > burst) ? pendingSamples - burst : 0;
+  portEXIT_CRITICAL(&pendingSamplesMux);
+  // Newest sample in this burst is on average half a period older than the latest data-ready
+  burstNewestSampleMicros = micros() - (available - burst) * (1000000UL / MPU6050_SAMPLE_RATE_HZ) -
+                            500000UL / MPU6050_SAMPLE_RATE_HZ;
+  lastFifoRead = now;
+}
+
+void updateGravity() {
+  if (!fifoEnabled) {
+    return;
+  }
+  serviceMotionFifo();
+  serviceTemperature();
+  publishGravity();
+}
+
+void serviceGravitySensor() {
+  // Frames normally drain the FIFO; without them (painter, battery screen) keep it from overflowing
+  bool resultWaiting = (fifoCountRead.status != I2C_IDLE && !isI2cPending(&fifoCountRead)) ||
+                       (fifoBurstRead.status != I2C_IDLE && !isI2cPending(&fifoBurstRead));
+  if (resultWaiting || millis() - lastFifoRead > 4 * MPU6050_FIFO_BATCH * 1000UL / MPU6050_SAMPLE_RATE_HZ) {
+    updateGravity();
+  }
+}
+
+bool armMotionWake() {
+  if (!fifoEnabled) {
+    return false;
+  }
+  fifoEnabled = false;
+#if MPU6050_INT_PIN >= 0
+  detachInterrupt(digitalPinToInterrupt(MPU6050_INT_PIN));
+#endif
   
-  lastSensorUpdate = millis();  // Update timing
-} 
\ No newline at end of file
+  // Motion interrupt on the high-passed accelerometer, latched on INT until INT_STATUS is read
+  uint8_t threshold = constrain(MOTION_WAKE_THRESHOLD_MG / 2, 1, 255);  // 2 mg per count
+  bool ok = writeMpuRegister(MPU6050_REG_FIFO_EN, 0x00) &&
+            writeMpuRegister(MPU6050_REG_INT_ENABLE, 0x00) &&
+            writeMpuRegister(MPU6050_REG_ACCEL_CONFIG, 0x01) &&  // ±2g, 5 Hz high-pass
+            writeMpuRegister(MPU6050_REG_MOT_THR, threshold) &&
+            writeMpuRegister(MPU6050_REG_MOT_DUR, 1) &&
+            writeMpuRegister(MPU6050_REG_INT_PIN_CFG, 0x20) &&
+            writeMpuRegister(MPU6050_REG_INT_ENABLE, 0x40);
+  uint8_t status;
+  readMpuRegisters(MPU6050_REG_INT_STATUS, &status, 1);
+  
+  // Gyros to standby, accelerometer cycling at 20 Hz on the internal oscillator
+  ok = ok && writeMpuRegister(MPU6050_REG_PWR_MGMT_2, 0x87) &&
+       writeMpuRegister(MPU6050_REG_PWR_MGMT_1, 0x28);
+  motionWakeArmed = true;
+  if (!ok) {
+    Serial.println("❌ MPU6050 motion wake setup failed - buttons only");
+    disarmMotionWake();
+    return false;
+  }
+  return true;
+}
+
+void disarmMotionWake() {
+  if (!motionWakeArmed) {
+    return;
+  }
+  motionWakeArmed = false;
+  
+  writeMpuRegister(MPU6050_REG_PWR_MGMT_1, 0x01);
+  writeMpuRegister(MPU6050_REG_PWR_MGMT_2, 0x00);
+  writeMpuRegister(MPU6050_REG_ACCEL_CONFIG, 0x00);
+  writeMpuRegister(MPU6050_REG_INT_ENABLE, 0x00);
+  uint8_t status;
+  readMpuRegisters(MPU6050_REG_INT_STATUS, &status, 1);
+  delay(30);  // Gyro start-up
+  
+  // Reads queued before the sleep describe the old orientation
+  if (!isI2cPending(&fifoCountRead)) {
+    fifoCountRead.status = I2C_IDLE;
+  }
+  if (!isI2cPending(&fifoBurstRead)) {
+    fifoBurstRead.status = I2C_IDLE;
+  }
+  stillCount = 0;
+  uint32_t resets = fifoResets;
+  enableMotionFifo();  // Reseeds the fusion from the accelerometer
+  fifoResets = resets;
+  lastMotionMillis = millis();
+}
+
+bool getImuCalibration(ImuCalibration& calibration) {
+  if (!calibrationStored) {
+    return false;
+  }
+  calibration.accelOffset[0] = calibrationOffsetX;
+  calibration.accelOffset[1] = calibrationOffsetY;
+  calibration.accelOffset[2] = calibrationOffsetZ;
+  calibration.gyroBias[0] = gyroBiasX;
+  calibration.gyroBias[1] = gyroBiasY;
+  calibration.gyroBias[2] = gyroBiasZ;
+  calibration.temperatureC = calibrationTemperatureC;
+  return true;
+}
+
+void presetImuCalibration(const ImuCalibration& calibration) {
+  presetCalibration = calibration;
+  calibrationPreset = true;
+}
+
+unsigned long getLastMotionTime() {
+  return lastMotionMillis;
+}
+
+bool isGravityInterruptActive() {
+  return dataReadySeen;
+}
+
+uint32_t getGravityBurstCount() {
+  return fifoBursts;
+}
+
+uint32_t getGravitySampleCount() {
+  return fifoSamples;
+}
+
+uint32_t getGravityFifoResets() {
+  return fifoResets;
+}
+
+float getTiltRoll() {
+  float q[4];
+  getMotionOrientation(q);
+  return atan2f(2.0f * (q[0] * q[1] + q[2] * q[3]), 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2])) * RAD_TO_DEG;
+}
+
+float getTiltPitch() {
+  float q[4];
+  getMotionOrientation(q);
+  return asinf(constrain(2.0f * (q[0] * q[2] - q[3] * q[1]), -1.0f, 1.0f)) * RAD_TO_DEG;
+}
+
+float getImuTemperature() {
+  return imuTemperatureC;
+}
+
+bool isImuCalibrationStored() {
+  return calibrationStored;
+}
+
+bool isImuCalibrating() {
+  return calibrationCapturing;
+}
+
+uint32_t getGyroDriftCorrections() {
+  return driftCorrections;
+}
+
+bool startImuTrace(uint16_t seconds) {
+  if (traceSamples != NULL) {
+    return false;
+  }
+  uint16_t capacity = constrain(seconds, 1, IMU_TRACE_MAX_SECONDS) * MPU6050_SAMPLE_RATE_HZ;
+  traceSamples = (ImuTraceSample*)malloc(capacity * sizeof(ImuTraceSample));
+  if (traceSamples == NULL) {
+    return false;
+  }
+  traceLength = 0;
+  traceCapacity = capacity;
+  Serial.printf("📈 IMU trace capture started (%d samples)\n", capacity);
+  return true;
+}
+
+bool isImuTraceActive() {
+  return traceSamples != NULL;
+}
+
+const ImuTraceSample* getImuTrace(uint16_t& length) {
+  length = traceLength;
+  return (traceSamples != NULL && traceLength == traceCapacity) ? traceSamples : NULL;
+}
+
+void endImuTrace() {
+  free(traceSamples);
+  traceSamples = NULL;
+  traceCapacity = 0;
+  traceLength = 0;
+}
@@ -8,24 +8,96 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include "config.h"
+#include "imu_calibration.h"
+#include "seqlock.h"
 
 // Sensor update interval
+#ifndef SENSOR_UPDATE_MS
 #define SENSOR_UPDATE_MS 20
+#endif
 
-// External variables for gravity readings
-extern float gravityX;
-extern float gravityY;
-extern float gravityZ;
+// FIFO sampling configuration
+#ifndef MPU6050_INT_PIN
+#define MPU6050_INT_PIN -1
+#endif
+#ifndef MPU6050_DLPF_CFG
+#define MPU6050_DLPF_CFG 3
+#endif
+#ifndef MPU6050_SAMPLE_RATE_HZ
+#define MPU6050_SAMPLE_RATE_HZ 100
+#endif
+#ifndef MPU6050_FIFO_BATCH
+#define MPU6050_FIFO_BATCH 6
+#endif
+#ifndef MOTION_WAKE_THRESHOLD_MG
+#define MOTION_WAKE_THRESHOLD_MG 40
+#endif
+#ifndef MOTION_PREDICTION_LEAD_MS
+#define MOTION_PREDICTION_LEAD_MS 8
+#endif
+#ifndef IMU_TRACE_MAX_SECONDS
+#define IMU_TRACE_MAX_SECONDS 30       // Trace capture limit (12 bytes per sample)
+#endif
+
+// Gravity for the next frame, published by updateGravity()
+struct GravityState {
+  float x;                  // Screen axes with deadzone, -1..1
+  float y;
+  float z;                  // Sensor Z, 1 when lying flat
+  uint32_t sampleMicros;    // Newest FIFO sample behind the prediction
+};
+extern Seqlock<GravityState> gravitySnapshot;
 
 // Calibration variables
 extern float calibrationOffsetX;
 extern float calibrationOffsetY;
 extern float calibrationOffsetZ;
 extern bool gyroCalibrated;
+extern float gyroBiasX;
+extern float gyroBiasY;
+extern float gyroBiasZ;
 
 // Function declarations
 void initMPU6050();
-void calibrateGyroscope();
-void updateGravity();
+void calibrateGyroscope();          // Captures offsets from the next second of samples (panel flat and still)
+void updateGravity();         // Burst-reads the FIFO once a batch is waiting (call before each frame)
+void serviceGravitySensor();  // Keeps the FIFO drained when no frames are rendering
+
+// FIFO statistics
+bool isGravityInterruptActive();
+uint32_t getGravityBurstCount();
+uint32_t getGravitySampleCount();
+uint32_t getGravityFifoResets();
+
+// Calibration state
+float getImuTemperature();
+bool isImuCalibrationStored();
+bool isImuCalibrating();
+uint32_t getGyroDriftCorrections();
+
+// Warm resume: current (drift-corrected) calibration, and one to use instead of NVS
+bool getImuCalibration(ImuCalibration& calibration);
+void presetImuCalibration(const ImuCalibration& calibration);  // Before initMPU6050()
+
+// Idle sleep: arming stops sampling and leaves INT latched high on the next bump or tilt
+bool armMotionWake();
+void disarmMotionWake();            // Back to FIFO sampling, orientation reseeded
+unsigned long getLastMotionTime();  // millis() when the panel was last handled
+
+// Trace capture for the host fusion replay (test/motion_fusion): calibrated
+// FIFO samples, one per 1/MPU6050_SAMPLE_RATE_HZ, into a buffer held until ended
+struct ImuTraceSample {
+  int16_t accel[3];
+  int16_t gyro[3];
+};
+bool startImuTrace(uint16_t seconds);   // False while one is held or out of memory
+bool isImuTraceActive();
+const ImuTraceSample* getImuTrace(uint16_t& length);  // NULL until the capture is full
+void endImuTrace();
+
+// Orientation from the gyro/accelerometer fusion (degrees)
+float getTiltRoll();
+float getTiltPitch();
 
 #endif // SENSOR_MANAGER_H 
\ No newline at end of file
@@ -0,0 +1,57 @@
+/*
+ * Seqlock Module
+ * Versioned snapshots for state written by one module and read from any task:
+ * readers never take a lock, they retry if a publish overlapped their copy
+ */
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <string.h>
+
+// T must be plain data (copied with memcpy). Sequence is odd while a publish is in progress.
+template <typename T>
+struct Seqlock {
+  std::atomic<uint32_t> sequence;
+  portMUX_TYPE writerMux = portMUX_INITIALIZER_UNLOCKED;
+  T value;
+
+  explicit Seqlock(const T& initial) : sequence(0), value(initial) {}
+};
+
+// Publisher side. The critical section keeps the writer from being preempted mid-copy,
+// so a higher-priority reader on the same core can never spin on a half-written value.
+template <typename T>
+inline void publishSnapshot(Seqlock<T>& lock, const T& value) {
+  portENTER_CRITICAL(&lock.writerMux);
+  uint32_t sequence = lock.sequence.load(std::memory_order_relaxed);
+  lock.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(&lock.value, &value, sizeof(T));
+  lock.sequence.store(sequence + 2, std::memory_order_release);
+  portEXIT_CRITICAL(&lock.writerMux);
+}
+
+// Reader side - task context on either core, never blocks the publisher
+template <typename T>
+inline T readSnapshot(const Seqlock<T>& lock) {
+  T copy;
+  uint32_t before, after;
+  do {
+    before = lock.sequence.load(std::memory_order_acquire);
+    memcpy(&copy, &lock.value, sizeof(T));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    after = lock.sequence.load(std::memory_order_relaxed);
+  } while ((before & 1) || before != after);
+  return copy;
+}
+
+// Number of publishes so far - lets a reader skip the copy when nothing changed
+template <typename T>
+inline uint32_t snapshotVersion(const Seqlock<T>& lock) {
+  return lock.sequence.load(std::memory_order_acquire) >> 1;
+}
+
+#endif // SEQLOCK_H
@@ -0,0 +1,173 @@
+/*
+ * Frame Check Host Runner
+ * Runs runFrameCheck() from frame_check.cpp against the sketch's own pattern,
+ * LED and compositor code, with the modules outside the render path stubbed,
+ * then replays a button session through the main loop's guarded stages.
+ * Every malloc goes through host_heap.cpp, so any allocation in an armed stage
+ * fails the run. Last, the Custom test program's render time is held to the
+ * pixel VM budget against Ripples.
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include "frame_check.h"
+#include "sensor_manager.h"
+#include "runtime_governor.h"
+#include "alloc_guard.h"
+#include "button_handler.h"
+#include "led_control.h"
+#include "compositor.h"
+
+#define SESSION_FRAMES 2000              // Loop passes in the button session (40 s)
+#define SESSION_PRESS_FRAMES 10          // Each press is held this long (200 ms)
+#define BUDGET_WARMUP_FRAMES 100         // Ripples needs a few waves in flight first
+#define BUDGET_BATCH_FRAMES 100          // Frames timed together
+#define BUDGET_BATCHES 30                // Fastest batch counts (scheduler noise only adds)
+
+// Battery, sensor, GitHub-client and web state the render path and buttons read
+Seqlock<GravityState> gravitySnapshot(GravityState{0.0f, 1.0f, 0.0f, 0});
+bool showGitHubLoading = false;
+bool painterMode = false;
+
+float getBatteryPercentage() {
+  return 100.0;
+}
+
+bool getChargingStatus() {
+  return false;
+}
+
+bool isLowBattery() {
+  return false;
+}
+
+uint8_t getGovernorBrightnessCeiling() {
+  return 255;
+}
+
+void drawGitHubLoadingAnimation() {
+}
+
+void flushFrameQueue() {
+}
+
+void noteUserActivity() {
+}
+
+void setGitHubPatternActive(bool active) {
+}
+
+// Button pressed at this loop pass, or -1: pattern presses every second, a
+// battery toggle and a brightness step in between
+static int sessionButtonPin(int frame) {
+  int slot = frame / SESSION_PRESS_FRAMES;
+  if (slot % 2 == 1) {
+    return -1;
+  }
+  switch ((slot / 2) % 5) {
+    case 0: case 2: case 4: return BUTTON_PIN_1;
+    case 1: return (slot / 10) % 2 == 0 ? BUTTON_PIN_2 : BUTTON_PIN_3;
+    default: return BUTTON_PIN_3;
+  }
+}
+
+static int runButtonSession() {
+  // Same stage order and arming as loop(); buttons drive pattern switches,
+  // transitions, overlays and brightness
+  uint32_t before[ALLOC_STAGE_COUNT];
+  for (int stage = 0; stage < ALLOC_STAGE_COUNT; stage++) {
+    before[stage] = getAllocCount((AllocStage)stage);
+  }
+
+  initializeButtons();
+  for (int frame = 0; frame < SESSION_FRAMES; frame++) {
+    int pressed = sessionButtonPin(frame);
+    setHostPin(BUTTON_PIN_1, pressed == BUTTON_PIN_1 ? LOW : HIGH);
+    setHostPin(BUTTON_PIN_2, pressed == BUTTON_PIN_2 ? LOW : HIGH);
+    setHostPin(BUTTON_PIN_3, pressed == BUTTON_PIN_3 ? LOW : HIGH);
+
+    armAllocGuard(ALLOC_STAGE_BUTTONS);
+    handleButtons();
+    disarmAllocGuard();
+
+    armAllocGuard(ALLOC_STAGE_PATTERN);
+    updateCurrentPattern();
+    disarmAllocGuard();
+    markBaseLayerDirty();
+
+    armAllocGuard(ALLOC_STAGE_SHOW);
+    showLEDs();
+    disarmAllocGuard();
+
+    advanceHostMicros(PATTERN_UPDATE_MS * 1000UL);
+  }
+
+  int failures = 0;
+  for (int stage = ALLOC_STAGE_PATTERN; stage < ALLOC_STAGE_COUNT; stage++) {
+    uint32_t count = getAllocCount((AllocStage)stage) - before[stage];
+    if (count > 0) {
+      fprintf(stderr, "Button session: FAIL - %u allocation(s) in %s stage\n",
+              (unsigned)count, getAllocStageName((AllocStage)stage));
+      failures++;
+    }
+  }
+  if (failures == 0) {
+    fprintf(stderr, "Button session: PASS (%d loop passes, no allocations)\n", SESSION_FRAMES);
+  }
+  return failures;
+}
+
+// Fastest per-frame render time of a pattern, in wall-clock microseconds (the
+// host micros() is simulated, so it can't time anything)
+static double measureRenderUs(PatternType pattern) {
+  static CRGB frame[NUM_LEDS];
+  unsigned long frameTime = FRAME_CHECK_START_MS;
+  double best = INFINITY;
+
+  beginOffscreenRender(pattern);
+  for (int i = 0; i < BUDGET_WARMUP_FRAMES; i++, frameTime += PATTERN_UPDATE_MS) {
+    renderOffscreenFrame(frame, frameTime);
+  }
+  for (int batch = 0; batch < BUDGET_BATCHES; batch++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BUDGET_BATCH_FRAMES; i++, frameTime += PATTERN_UPDATE_MS) {
+      renderOffscreenFrame(frame, frameTime);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    best = min(best, elapsed.count() / BUDGET_BATCH_FRAMES);
+  }
+  endOffscreenRender();
+  return best;
+}
+
+static int runVmBudgetCheck() {
+  if (!loadFrameCheckProgram()) {
+    fprintf(stderr, "VM budget: FAIL - test program rejected\n");
+    return 1;
+  }
+  double customUs = measureRenderUs(PATTERN_CUSTOM);
+  double ripplesUs = measureRenderUs(PATTERN_RIPPLES);
+  double ratio = customUs / ripplesUs;
+  fprintf(stderr, "VM budget: %s (Custom %.1f us, Ripples %.1f us per frame, %.2fx of %.2fx)\n",
+          ratio <= PIXEL_VM_BUDGET_RATIO ? "PASS" : "FAIL", customUs, ripplesUs, ratio, PIXEL_VM_BUDGET_RATIO);
+  return ratio <= PIXEL_VM_BUDGET_RATIO ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+  bool record = argc > 1 && strcmp(argv[1], "--record") == 0;
+  setHostMicros((uint64_t)FRAME_CHECK_START_MS * 1000);
+
+  // stdio would otherwise malloc its buffer on the first write, inside whichever stage logs first
+  static char stdoutBuffer[BUFSIZ];
+  setvbuf(stdout, stdoutBuffer, _IOFBF, sizeof(stdoutBuffer));
+  initializeAllocGuard();
+
+  String report;
+  int failures = runFrameCheck(report, record);
+  fputs(report.c_str(), stderr);
+  if (!record) {
+    failures += runButtonSession();
+    failures += runVmBudgetCheck();
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+/*
+ * Host Arduino Shim
+ * Just enough of the ESP32 Arduino core to build the sketch's render and
+ * sensor-fusion modules on a PC: a settable clock, settable input pins, Serial
+ * on stdout, and FreeRTOS locks that do nothing (host tests are single-threaded)
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+#define ESP_ARDUINO_VERSION_MAJOR 3
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+
+#define HEX 16
+#define DEC 10
+#define PI 3.1415926535897932384626433832795
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+using std::min;
+using std::max;
+
+template <class T, class L, class H>
+inline T constrain(T x, L low, H high) {
+  return x < low ? low : (x > high ? high : x);
+}
+
+// Clock - advanced by the test, never by itself
+unsigned long millis();
+unsigned long micros();
+void setHostMicros(uint64_t now);
+void advanceHostMicros(uint64_t delta);
+inline void delay(unsigned long ms) { advanceHostMicros((uint64_t)ms * 1000); }
+inline void yield() {}
+
+// GPIO - inputs read whatever level the test last set with setHostPin()
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+int digitalRead(uint8_t pin);
+void setHostPin(uint8_t pin, int level);
+
+class String {
+public:
+  String(const char* text = "") : value(text ? text : "") {}
+  String(const std::string& text) : value(text) {}
+  String(char c) : value(1, c) {}
+  String(int number, int base = DEC) { format(base == HEX ? "%x" : "%d", number); }
+  String(unsigned int number, int base = DEC) { format(base == HEX ? "%x" : "%u", number); }
+  String(long number, int base = DEC) { format(base == HEX ? "%lx" : "%ld", number); }
+  String(unsigned long number, int base = DEC) { format(base == HEX ? "%lx" : "%lu", number); }
+  String(float number, int decimals = 2) { format("%.*f", decimals, number); }
+  String(double number, int decimals = 2) { format("%.*f", decimals, number); }
+
+  unsigned int length() const { return value.size(); }
+  const char* c_str() const { return value.c_str(); }
+  bool isEmpty() const { return value.empty(); }
+  bool reserve(unsigned int size) { value.reserve(size); return true; }
+
+  String& operator+=(const String& rhs) { value += rhs.value; return *this; }
+  String& operator+=(const char* rhs) { value += rhs; return *this; }
+  String& operator+=(char rhs) { value += rhs; return *this; }
+  friend String operator+(const String& lhs, const String& rhs) { return String(lhs.value + rhs.value); }
+  friend String operator+(const String& lhs, const char* rhs) { return String(lhs.value + rhs); }
+  friend String operator+(const char* lhs, const String& rhs) { return String(lhs + rhs.value); }
+  bool operator==(const String& rhs) const { return value == rhs.value; }
+  bool operator==(const char* rhs) const { return value == rhs; }
+  bool operator!=(const String& rhs) const { return value != rhs.value; }
+  bool operator!=(const char* rhs) const { return value != rhs; }
+
+private:
+  template <typename... Args>
+  void format(const char* spec, Args... args) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), spec, args...);
+    value = buffer;
+  }
+
+  std::string value;
+};
+
+class HardwareSerial {
+public:
+  void begin(unsigned long baud) {}
+  int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, format);
+    int written = vprintf(format, args);
+    va_end(args);
+    return written;
+  }
+  void print(const char* text) { fputs(text, stdout); }
+  void print(const String& text) { fputs(text.c_str(), stdout); }
+  void print(int number) { ::printf("%d", number); }
+  void println(const char* text = "") { puts(text); }
+  void println(const String& text) { puts(text.c_str()); }
+  void println(int number) { ::printf("%d\n", number); }
+  void flush() { fflush(stdout); }
+};
+
+extern HardwareSerial Serial;
+
+// FreeRTOS - one thread on the host, so critical sections are no-ops
+typedef struct { int owner; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+inline void portENTER_CRITICAL(portMUX_TYPE* mux) {}
+inline void portEXIT_CRITICAL(portMUX_TYPE* mux) {}
+inline void portENTER_CRITICAL_ISR(portMUX_TYPE* mux) {}
+inline void portEXIT_CRITICAL_ISR(portMUX_TYPE* mux) {}
+typedef void* TaskHandle_t;
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return NULL; }
+typedef void* SemaphoreHandle_t;
+typedef void* QueueHandle_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#endif // HOST_ARDUINO_H
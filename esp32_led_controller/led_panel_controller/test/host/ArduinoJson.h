@@ -0,0 +1,11 @@
+/*
+ * Host ArduinoJson Shim
+ * Headers only - host builds never touch the network
+ */
+
+#ifndef HOST_ARDUINOJSON_H
+#define HOST_ARDUINOJSON_H
+
+#include <Arduino.h>
+
+#endif // HOST_ARDUINOJSON_H
@@ -0,0 +1,279 @@
+/*
+ * Host FastLED Subset
+ * The parts of FastLED the sketch's render path uses, with the same integer
+ * math as FastLED 3.x (FASTLED_SCALE8_FIXED=1, hsv2rgb_rainbow, blend8), so
+ * frames rendered on the host match the panel byte for byte
+ */
+
+#ifndef HOST_FASTLED_H
+#define HOST_FASTLED_H
+
+#include <Arduino.h>
+
+typedef uint8_t fract8;
+
+inline uint8_t qadd8(uint8_t i, uint8_t j) {
+  unsigned t = i + j;
+  return t > 255 ? 255 : t;
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j) {
+  int t = i - j;
+  return t < 0 ? 0 : t;
+}
+
+inline uint8_t scale8(uint8_t i, fract8 scale) {
+  return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale) {
+  return (((uint16_t)i * scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB) {
+  uint16_t partial = (a << 8) | b;
+  partial += (b * amountOfB);
+  partial -= (a * amountOfB);
+  return partial >> 8;
+}
+
+inline int16_t sin16(uint16_t theta) {
+  static const uint16_t base[] = {0, 6393, 12539, 18204, 23170, 27245, 30273, 32137};
+  static const uint8_t slope[] = {49, 48, 44, 38, 31, 23, 14, 4};
+
+  uint16_t offset = (theta & 0x3FFF) >> 3;  // 0..2047
+  if (theta & 0x4000) offset = 2047 - offset;
+
+  uint8_t section = offset / 256;  // 0..7
+  uint16_t b = base[section];
+  uint8_t m = slope[section];
+  uint8_t secoffset8 = (uint8_t)(offset) / 2;
+  uint16_t mx = m * secoffset8;
+  int16_t y = mx + b;
+  if (theta & 0x8000) y = -y;
+  return y;
+}
+
+inline int16_t cos16(uint16_t theta) {
+  return sin16(theta + 16384);
+}
+
+struct CHSV {
+  union {
+    struct {
+      union { uint8_t hue; uint8_t h; };
+      union { uint8_t sat; uint8_t s; };
+      union { uint8_t val; uint8_t v; };
+    };
+    uint8_t raw[3];
+  };
+  CHSV() {}
+  CHSV(uint8_t ih, uint8_t is, uint8_t iv) : h(ih), s(is), v(iv) {}
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB {
+  union {
+    struct {
+      union { uint8_t r; uint8_t red; };
+      union { uint8_t g; uint8_t green; };
+      union { uint8_t b; uint8_t blue; };
+    };
+    uint8_t raw[3];
+  };
+
+  enum HTMLColorCode {
+    Black = 0x000000,
+    Green = 0x008000,
+    Orange = 0xFFA500,
+    Red = 0xFF0000,
+    White = 0xFFFFFF,
+    Yellow = 0xFFFF00
+  };
+
+  CRGB() {}
+  CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+  CRGB(HTMLColorCode colorcode) : CRGB((uint32_t)colorcode) {}
+  CRGB(const CHSV& rhs) { hsv2rgb_rainbow(rhs, *this); }
+
+  CRGB& operator=(const CHSV& rhs) {
+    hsv2rgb_rainbow(rhs, *this);
+    return *this;
+  }
+
+  uint8_t& operator[](uint8_t x) { return raw[x]; }
+  const uint8_t& operator[](uint8_t x) const { return raw[x]; }
+
+  CRGB& operator+=(const CRGB& rhs) {
+    r = qadd8(r, rhs.r);
+    g = qadd8(g, rhs.g);
+    b = qadd8(b, rhs.b);
+    return *this;
+  }
+
+  CRGB& operator-=(const CRGB& rhs) {
+    r = qsub8(r, rhs.r);
+    g = qsub8(g, rhs.g);
+    b = qsub8(b, rhs.b);
+    return *this;
+  }
+
+  CRGB& nscale8(uint8_t scaledown) {
+    uint16_t scaleFixed = scaledown + 1;
+    r = (r * scaleFixed) >> 8;
+    g = (g * scaleFixed) >> 8;
+    b = (b * scaleFixed) >> 8;
+    return *this;
+  }
+
+  CRGB& nscale8_video(uint8_t scaledown) {
+    r = scale8_video(r, scaledown);
+    g = scale8_video(g, scaledown);
+    b = scale8_video(b, scaledown);
+    return *this;
+  }
+
+  CRGB& fadeToBlackBy(uint8_t fadefactor) {
+    return nscale8(255 - fadefactor);
+  }
+
+  explicit operator bool() const { return r || g || b; }
+  bool operator==(const CRGB& rhs) const { return r == rhs.r && g == rhs.g && b == rhs.b; }
+  bool operator!=(const CRGB& rhs) const { return !(*this == rhs); }
+};
+
+inline void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb) {
+  // FastLED's "rainbow" colour space: yellow boosted (Y1), no green scaling
+  const uint8_t K255 = 255, K171 = 171, K170 = 170, K85 = 85;
+
+  uint8_t hue = hsv.hue;
+  uint8_t sat = hsv.sat;
+  uint8_t val = hsv.val;
+
+  uint8_t offset8 = (hue & 0x1F) << 3;
+  uint8_t third = scale8(offset8, (256 / 3));
+  uint8_t r, g, b;
+
+  if (!(hue & 0x80)) {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) {
+        r = K255 - third; g = third; b = 0;                    // R -> O
+      } else {
+        r = K171; g = K85 + third; b = 0;                      // O -> Y
+      }
+    } else {
+      if (!(hue & 0x20)) {
+        uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));  // Y -> G
+        r = K171 - twothirds; g = K170 + third; b = 0;
+      } else {
+        r = 0; g = K255 - third; b = third;                    // G -> A
+      }
+    }
+  } else {
+    if (!(hue & 0x40)) {
+      if (!(hue & 0x20)) {
+        uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));  // A -> B
+        r = 0; g = K171 - twothirds; b = K85 + twothirds;
+      } else {
+        r = third; g = 0; b = K255 - third;                    // B -> P
+      }
+    } else {
+      if (!(hue & 0x20)) {
+        r = K85 + third; g = 0; b = K171 - third;              // P -> K
+      } else {
+        r = K170 + third; g = 0; b = K85 - third;              // K -> R
+      }
+    }
+  }
+
+  if (sat != 255) {
+    if (sat == 0) {
+      r = 255; g = 255; b = 255;
+    } else {
+      uint8_t desat = 255 - sat;
+      desat = scale8_video(desat, desat);
+      uint8_t satscale = 255 - desat;
+      r = scale8(r, satscale);
+      g = scale8(g, satscale);
+      b = scale8(b, satscale);
+      r += desat;
+      g += desat;
+      b += desat;
+    }
+  }
+
+  if (val != 255) {
+    val = scale8_video(val, val);
+    if (val == 0) {
+      r = 0; g = 0; b = 0;
+    } else {
+      r = scale8(r, val);
+      g = scale8(g, val);
+      b = scale8(b, val);
+    }
+  }
+
+  rgb.r = r;
+  rgb.g = g;
+  rgb.b = b;
+}
+
+inline CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amountOfOverlay) {
+  if (amountOfOverlay == 0) {
+    return existing;
+  }
+  if (amountOfOverlay == 255) {
+    existing = overlay;
+    return existing;
+  }
+  existing.red = blend8(existing.red, overlay.red, amountOfOverlay);
+  existing.green = blend8(existing.green, overlay.green, amountOfOverlay);
+  existing.blue = blend8(existing.blue, overlay.blue, amountOfOverlay);
+  return existing;
+}
+
+inline CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2) {
+  CRGB nu(p1);
+  nblend(nu, p2, amountOfP2);
+  return nu;
+}
+
+inline void fill_solid(CRGB* leds, int numToFill, const CRGB& color) {
+  for (int i = 0; i < numToFill; i++) {
+    leds[i] = color;
+  }
+}
+
+inline void fadeToBlackBy(CRGB* leds, uint16_t numLeds, uint8_t fadeBy) {
+  for (uint16_t i = 0; i < numLeds; i++) {
+    leds[i].fadeToBlackBy(fadeBy);
+  }
+}
+
+// Output side - the host keeps frames in memory, nothing is driven
+enum EOrder { RGB, GRB };
+struct WS2812B {};
+
+class CFastLED {
+public:
+  template <class CHIPSET, int DATA_PIN, EOrder ORDER>
+  void addLeds(CRGB* data, int count) { ledData = data; ledCount = count; }
+  void setBrightness(uint8_t scale) { brightness = scale; }
+  uint8_t getBrightness() { return brightness; }
+  void setMaxPowerInVoltsAndMilliamps(uint8_t volts, uint32_t milliamps) {}
+  void setDither(uint8_t ditherMode) {}
+  void clear(bool writeData = false) { if (ledData) fill_solid(ledData, ledCount, CRGB::Black); }
+  void show() {}
+
+private:
+  CRGB* ledData = NULL;
+  int ledCount = 0;
+  uint8_t brightness = 255;
+};
+
+extern CFastLED FastLED;
+
+#endif // HOST_FASTLED_H
@@ -0,0 +1,11 @@
+/*
+ * Host HTTPClient Shim
+ * Headers only - host builds never touch the network
+ */
+
+#ifndef HOST_HTTPCLIENT_H
+#define HOST_HTTPCLIENT_H
+
+#include <Arduino.h>
+
+#endif // HOST_HTTPCLIENT_H
@@ -0,0 +1,20 @@
+/*
+ * Host Preferences Shim
+ * NVS is always empty on the host - nothing is restored or saved
+ */
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false) { return false; }
+  void end() {}
+  size_t getBytesLength(const char* key) { return 0; }
+  size_t getBytes(const char* key, void* buffer, size_t length) { return 0; }
+  size_t putBytes(const char* key, const void* value, size_t length) { return 0; }
+};
+
+#endif // HOST_PREFERENCES_H
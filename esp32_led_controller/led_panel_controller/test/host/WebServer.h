@@ -0,0 +1,13 @@
+/*
+ * Host WebServer Shim
+ * Headers only - the server object is declared by web_server.h but never built
+ */
+
+#ifndef HOST_WEBSERVER_H
+#define HOST_WEBSERVER_H
+
+#include <Arduino.h>
+
+class WebServer;
+
+#endif // HOST_WEBSERVER_H
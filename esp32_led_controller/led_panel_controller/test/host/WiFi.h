@@ -0,0 +1,11 @@
+/*
+ * Host WiFi Shim
+ * Headers only - host builds never touch the network
+ */
+
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+
+#endif // HOST_WIFI_H
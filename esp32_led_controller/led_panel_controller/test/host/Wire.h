@@ -0,0 +1,11 @@
+/*
+ * Host Wire Shim
+ * Headers only - the host build never talks to the I2C bus
+ */
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+#endif // HOST_WIRE_H
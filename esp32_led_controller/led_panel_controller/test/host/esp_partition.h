@@ -0,0 +1,39 @@
+/*
+ * Host Partition Shim
+ * No flash partitions on the host - lookups always fail
+ */
+
+#ifndef HOST_ESP_PARTITION_H
+#define HOST_ESP_PARTITION_H
+
+#include <Arduino.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+typedef enum { ESP_PARTITION_TYPE_APP = 0, ESP_PARTITION_TYPE_DATA = 1 } esp_partition_type_t;
+typedef enum { ESP_PARTITION_SUBTYPE_ANY = 0xff } esp_partition_subtype_t;
+typedef enum { ESP_PARTITION_MMAP_DATA, ESP_PARTITION_MMAP_INST } esp_partition_mmap_memory_t;
+typedef uint32_t esp_partition_mmap_handle_t;
+
+typedef struct {
+  esp_partition_type_t type;
+  esp_partition_subtype_t subtype;
+  uint32_t address;
+  uint32_t size;
+  char label[17];
+} esp_partition_t;
+
+inline const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                       const char* label) {
+  return NULL;
+}
+inline esp_err_t esp_partition_mmap(const esp_partition_t* partition, size_t offset, size_t size,
+                                    esp_partition_mmap_memory_t memory, const void** out,
+                                    esp_partition_mmap_handle_t* handle) {
+  return ESP_FAIL;
+}
+inline void esp_partition_munmap(esp_partition_mmap_handle_t handle) {}
+
+#endif // HOST_ESP_PARTITION_H
@@ -0,0 +1,42 @@
+/*
+ * Host Arduino Shim Implementation
+ */
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+HardwareSerial Serial;
+CFastLED FastLED;
+
+static uint64_t hostMicros = 0;
+
+unsigned long millis() {
+  return (unsigned long)(hostMicros / 1000);
+}
+
+unsigned long micros() {
+  return (unsigned long)hostMicros;
+}
+
+void setHostMicros(uint64_t now) {
+  hostMicros = now;
+}
+
+void advanceHostMicros(uint64_t delta) {
+  hostMicros += delta;
+}
+
+// Inputs idle high (buttons are active-low with pull-ups)
+static int hostPins[64];
+static bool hostPinsSet[64];
+
+int digitalRead(uint8_t pin) {
+  return (pin < 64 && hostPinsSet[pin]) ? hostPins[pin] : HIGH;
+}
+
+void setHostPin(uint8_t pin, int level) {
+  if (pin < 64) {
+    hostPins[pin] = level;
+    hostPinsSet[pin] = true;
+  }
+}
@@ -0,0 +1,53 @@
+/*
+ * Host Heap Hook
+ * Stands in for the ESP-IDF heap hooks: every malloc/calloc/realloc in the host
+ * build calls esp_heap_trace_alloc_hook(), so alloc_guard.cpp (built with
+ * CONFIG_HEAP_USE_HOOKS) counts std::string and operator new traffic exactly
+ * as it counts Arduino String and new on the device
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+
+void esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps);
+void esp_heap_trace_free_hook(void* ptr);
+
+void* malloc(size_t size) {
+  void* ptr = __libc_malloc(size);
+  if (ptr != NULL) {
+    esp_heap_trace_alloc_hook(ptr, size, 0);
+  }
+  return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+  void* ptr = __libc_calloc(count, size);
+  if (ptr != NULL) {
+    esp_heap_trace_alloc_hook(ptr, count * size, 0);
+  }
+  return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+  void* moved = __libc_realloc(ptr, size);
+  if (moved != NULL) {
+    esp_heap_trace_alloc_hook(moved, size, 0);
+  }
+  return moved;
+}
+
+void free(void* ptr) {
+  if (ptr != NULL) {
+    esp_heap_trace_free_hook(ptr);
+  }
+  __libc_free(ptr);
+}
+
+}
@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+"""
+Motion Fusion Trace Generator
+Writes the synthetic IMU traces in traces/ and turns captures from the panel's
+/imu-trace endpoint into replayable traces with a reference gravity.
+
+Synthetic traces simulate an MPU6050 at 1 kHz and keep every 10th sample:
+  - accelerometer and gyro through the DLPF (MPU6050_DLPF_CFG 3, ~43 Hz)
+  - accelerometer noise 0.01 g rms, gyro noise 0.1 deg/s rms, int16 saturation
+  - gyro scale error per axis, gyro axes misaligned against the accelerometer,
+    a residual bias left by calibration and a bias step (temperature shift)
+    halfway through each trace
+so integrating the gyro alone drifts away from the reference.
+
+Device captures (us,ax,ay,az,gx,gy,gz, calibrated counts) have no ground
+truth; the reference is a forward-backward complementary filter over the whole
+capture, which has no lag, and the still stretches pin it to the
+accelerometer (on the synthetic traces it stays within 0.03 of the truth).
+Those traces are checked with the device_*.csv limits.
+
+Capture on the panel (repeat the request until it answers 200):
+    curl 'http://<panel>/imu-trace?seconds=20' -o capture.csv
+
+Usage:
+    make_traces.py [traces_dir]                   regenerate the synthetic traces
+    make_traces.py --device capture.csv NAME      write traces_dir/device_NAME.csv
+"""
+
+import os
+import math
+import random
+import argparse
+
+RATE_HZ = 100
+SIM_HZ = 1000
+ACCEL_COUNTS_PER_G = 16384
+GYRO_COUNTS_PER_DPS = 131
+ACCEL_NOISE_G = 0.01
+GYRO_NOISE_DPS = 0.1
+DLPF_HZ = 43
+
+# Gyro unit errors - within the MPU6050 datasheet tolerances
+GYRO_SCALE = (1.02, 0.985, 1.01)               # Sensitivity tolerance is +/-3%
+GYRO_MISALIGNMENT_DEG = (0.8, -0.6, 0.5)       # Cross-axis sensitivity is +/-2%
+GYRO_BIAS_DPS = (0.4, -0.3, 0.2)               # Left over after calibration
+GYRO_BIAS_STEP_DPS = (0.5, -0.4, 0.3)          # Added halfway through
+
+# Reference filter for device captures
+REFERENCE_GAIN = 0.5                           # Accelerometer correction (1/s)
+REFERENCE_STILL_G = 0.02                       # |a| - 1 g below this trusts the accelerometer
+
+
+def clip(value):
+    return max(-32768, min(32767, int(round(value))))  # int16 registers saturate
+
+
+def gravity(roll, pitch):
+    return (-math.sin(pitch), math.sin(roll) * math.cos(pitch), math.cos(roll) * math.cos(pitch))
+
+
+def body_rates(angles, t):
+    # Instantaneous rates (rad/s) of roll-then-pitch angles in sensor axes
+    h = 1e-5
+    r0, p0 = angles(t - h)
+    r1, p1 = angles(t + h)
+    roll, _ = angles(t)
+    roll_rate = (r1 - r0) / (2 * h)
+    pitch_rate = (p1 - p0) / (2 * h)
+    return (roll_rate, pitch_rate * math.cos(roll), -pitch_rate * math.sin(roll))
+
+
+def rotation(degrees):
+    # Small rotation by x, y, z angles (gyro axes as seen by the accelerometer)
+    ax, ay, az = (math.radians(d) for d in degrees)
+    cx, sx, cy, sy, cz, sz = math.cos(ax), math.sin(ax), math.cos(ay), math.sin(ay), math.cos(az), math.sin(az)
+    return ((cy * cz, sx * sy * cz - cx * sz, cx * sy * cz + sx * sz),
+            (cy * sz, sx * sy * sz + cx * cz, cx * sy * sz - sx * cz),
+            (-sy, sx * cy, cx * cy))
+
+
+def multiply(matrix, vector):
+    return [sum(matrix[row][k] * vector[k] for k in range(3)) for row in range(3)]
+
+
+def write_header(out, description, seed):
+    for line in description:
+        out.write('# %s\n' % line)
+    out.write('# Synthetic: %d Hz through a %d Hz DLPF, accel noise %.2f g rms, gyro noise %.1f deg/s rms, '
+              'int16 saturation, seed %d\n' % (RATE_HZ, DLPF_HZ, ACCEL_NOISE_G, GYRO_NOISE_DPS, seed))
+    out.write('# Gyro: scale %s, misaligned %s deg, bias %s deg/s stepping by %s deg/s halfway\n'
+              % (GYRO_SCALE, GYRO_MISALIGNMENT_DEG, GYRO_BIAS_DPS, GYRO_BIAS_STEP_DPS))
+    out.write('# us,ax,ay,az,gx,gy,gz,gravity_x,gravity_y,gravity_z\n')
+
+
+def write_synthetic(directory, name, description, duration, angles, knock=None, seed=1):
+    rng = random.Random(seed)
+    misalignment = rotation(GYRO_MISALIGNMENT_DEG)
+    alpha = 1 - math.exp(-2 * math.pi * DLPF_HZ / SIM_HZ)
+    decimation = SIM_HZ // RATE_HZ
+
+    accel = None
+    gyro = None
+    with open(os.path.join(directory, name), 'w') as out:
+        write_header(out, description, seed)
+        for step in range(int(duration * SIM_HZ) + 1):
+            t = step / SIM_HZ
+            truth = gravity(*angles(t))
+            raw_accel = [g * ACCEL_COUNTS_PER_G for g in truth]
+            if knock and knock(t):
+                raw_accel[0] += 2.5 * ACCEL_COUNTS_PER_G
+
+            rates = multiply(misalignment, [math.degrees(w) for w in body_rates(angles, t)])
+            bias_step = 1 if t >= duration / 2 else 0
+            raw_gyro = [(rates[k] * GYRO_SCALE[k] + GYRO_BIAS_DPS[k] + bias_step * GYRO_BIAS_STEP_DPS[k])
+                        * GYRO_COUNTS_PER_DPS for k in range(3)]
+
+            if accel is None:
+                accel, gyro = raw_accel, raw_gyro
+            accel = [a + alpha * (r - a) for a, r in zip(accel, raw_accel)]
+            gyro = [g + alpha * (r - g) for g, r in zip(gyro, raw_gyro)]
+
+            if step % decimation == 0:
+                sampled_accel = [a + rng.gauss(0, ACCEL_NOISE_G * ACCEL_COUNTS_PER_G) for a in accel]
+                sampled_gyro = [g + rng.gauss(0, GYRO_NOISE_DPS * GYRO_COUNTS_PER_DPS) for g in gyro]
+                out.write('%d,%s,%s,%.5f,%.5f,%.5f\n' % (
+                    step * 1000000 // SIM_HZ,
+                    ','.join(str(clip(v)) for v in sampled_accel),
+                    ','.join(str(clip(v)) for v in sampled_gyro),
+                    truth[0], truth[1], truth[2]))
+
+
+def write_synthetic_traces(directory):
+    d = math.radians
+    write_synthetic(directory, 'rest.csv',
+                    ['Flat and still for 8 s'],
+                    8, lambda t: (0.0, 0.0), seed=1)
+
+    def roll_step(t):
+        if t < 1:
+            roll = 0
+        elif t < 1.2:
+            roll = 200 * (t - 1)
+        elif t < 2.5:
+            roll = 40
+        elif t < 2.7:
+            roll = 40 - 200 * (t - 2.5)
+        else:
+            roll = 0
+        return (d(roll), 0.0)
+    write_synthetic(directory, 'roll_step.csv',
+                    ['Still 1 s, roll 0 -> 40 deg at 200 deg/s, hold, back at 200 deg/s at 2.5 s, hold to 4 s'],
+                    4, roll_step, seed=2)
+
+    write_synthetic(directory, 'wobble.csv',
+                    ['Hand-held wobble: roll 10 deg at 1.3 Hz and pitch 15 deg at 2 Hz for 6 s'],
+                    6, lambda t: (d(10 * math.sin(2 * math.pi * 1.3 * t)), d(15 * math.sin(2 * math.pi * 2 * t))),
+                    seed=3)
+
+    write_synthetic(directory, 'knocks.csv',
+                    ['Resting at roll 20 deg, pitch -10 deg; a 2.5 g knock along X for 20 ms every 0.5 s'],
+                    6, lambda t: (d(20), d(-10)), knock=lambda t: t >= 0.5 and round(t * 1000) % 500 < 20, seed=4)
+
+
+def normalized(vector):
+    length = math.sqrt(sum(v * v for v in vector))
+    return [v / length for v in vector]
+
+
+def is_still(accel):
+    magnitude = math.sqrt(sum(a * a for a in accel)) / ACCEL_COUNTS_PER_G
+    return abs(magnitude - 1) < REFERENCE_STILL_G
+
+
+def complementary_pass(samples, direction):
+    # Gravity per sample from one pass of a gyro + accelerometer filter; running
+    # backwards in time negates the rotation. Seeded from the first sample that
+    # looks like plain gravity, which the samples before it also get.
+    order = list(range(len(samples)))
+    if direction < 0:
+        order.reverse()
+    seed = next((i for i in order if is_still(samples[i][1])), order[0])
+    estimate = normalized(samples[seed][1])
+    previous_us = samples[seed][0]
+    result = [estimate] * len(samples)
+    for i in order[order.index(seed) + 1:]:
+        us, accel, gyro = samples[i]
+        dt = abs(us - previous_us) / 1e6
+        w = [math.radians(g / GYRO_COUNTS_PER_DPS) * direction for g in gyro]
+        # Gravity rotates opposite to the sensor: dg/dt = g x w
+        estimate = [estimate[0] + (estimate[1] * w[2] - estimate[2] * w[1]) * dt,
+                    estimate[1] + (estimate[2] * w[0] - estimate[0] * w[2]) * dt,
+                    estimate[2] + (estimate[0] * w[1] - estimate[1] * w[0]) * dt]
+        if is_still(accel):
+            gain = min(1.0, REFERENCE_GAIN * dt)
+            estimate = [e + gain * (m - e) for e, m in zip(estimate, normalized(accel))]
+        estimate = normalized(estimate)
+        previous_us = us
+        result[i] = estimate
+    return result
+
+
+def convert_device_capture(capture, directory, name):
+    samples = []
+    with open(capture) as source:
+        for line in source:
+            if line.startswith('#') or not line.strip():
+                continue
+            fields = [int(v) for v in line.split(',')[:7]]
+            samples.append((fields[0], fields[1:4], fields[4:7]))
+    if len(samples) < 2:
+        raise SystemExit('%s: no samples' % capture)
+
+    forward = complementary_pass(samples, 1)
+    backward = complementary_pass(samples, -1)
+    path = os.path.join(directory, 'device_%s.csv' % name)
+    with open(path, 'w') as out:
+        out.write('# Recorded on the panel via /imu-trace (%s)\n' % os.path.basename(capture))
+        out.write('# Reference: forward-backward complementary filter, accelerometer gain %.1f/s when within '
+                  '%.2f g of 1 g\n' % (REFERENCE_GAIN, REFERENCE_STILL_G))
+        out.write('# us,ax,ay,az,gx,gy,gz,gravity_x,gravity_y,gravity_z\n')
+        for (us, accel, gyro), f, b in zip(samples, forward, backward):
+            reference = normalized([(x + y) / 2 for x, y in zip(f, b)])
+            out.write('%d,%s,%s,%.5f,%.5f,%.5f\n' % (
+                us - samples[0][0], ','.join(map(str, accel)), ','.join(map(str, gyro)),
+                reference[0], reference[1], reference[2]))
+    print('Wrote %s (%d samples)' % (path, len(samples)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('directory', nargs='?', default=os.path.join(os.path.dirname(__file__), 'traces'),
+                        help='Trace directory (default: traces/ next to this script)')
+    parser.add_argument('--device', nargs=2, metavar=('CAPTURE', 'NAME'),
+                        help='Convert a /imu-trace capture instead of writing the synthetic traces')
+    args = parser.parse_args()
+
+    if args.device:
+        convert_device_capture(args.device[0], args.directory, args.device[1])
+    else:
+        write_synthetic_traces(args.directory)
+
+
+if __name__ == '__main__':
+    main()
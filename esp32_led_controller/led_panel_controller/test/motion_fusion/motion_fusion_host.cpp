@@ -0,0 +1,270 @@
+/*
+ * Motion Fusion Host Runner
+ * Replays IMU traces through motion_fusion.cpp and checks latency and noise of
+ * the gravity it publishes against the trace's reference gravity. The old
+ * accelerometer-only EMA is replayed alongside for comparison.
+ *
+ * Trace format (traces/<name>.csv, '#' lines are comments), one FIFO sample per line:
+ *   us, ax, ay, az, gx, gy, gz, gravity_x, gravity_y, gravity_z
+ * with raw calibrated counts as updateMotionFusion() takes them and the true
+ * gravity direction as a unit vector in sensor axes. make_traces.py writes the
+ * synthetic traces (sensor DLPF, noise and gyro scale, misalignment and bias-step
+ * errors) and converts /imu-trace captures from the panel into device_*.csv,
+ * which are replayed with the device limits below.
+ */
+
+#include <Arduino.h>
+#include <array>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <dirent.h>
+#include "motion_fusion.h"
+
+#define SETTLE_US 1000000        // Metrics ignore the first second (filter seeding)
+#define STILL_SAMPLES 50         // Reference unchanged this long counts as held still
+#define LAG_MIN_US -50000        // Latency search window
+#define LAG_MAX_US 300000
+#define LAG_STEP_US 1000
+
+struct TraceSample {
+  uint32_t us;
+  int32_t accel[3];
+  int32_t gyro[3];
+  float truth[3];
+};
+
+// Limits for one trace (negative = not checked, e.g. latency of a trace without motion)
+struct TraceCheck {
+  const char* file;
+  float maxLatencyMs;      // Fused gravity behind the trace, as of the newest sample
+  float maxDisplayLagMs;   // Predicted gravity behind display time (MOTION_PREDICTION_LEAD_MS ahead)
+  float maxJitter;         // RMS sample-to-sample noise while the reference holds still
+  float maxError;          // Worst error after settling (includes offsets from gyro bias)
+};
+
+// About 1.4x the worst of several generator seeds
+static const TraceCheck traceChecks[] = {
+  {"rest.csv",      -1, -1, 0.0005, 0.025},
+  {"roll_step.csv", 10, 10, 0.0010, 0.035},
+  {"wobble.csv",    10, 10,     -1, 0.035},
+  {"knocks.csv",    -1, -1, 0.0010, 0.045},
+};
+
+// Recorded traces: the reference is reconstructed offline and is itself ~0.025 off
+// on the synthetic traces, so the error limit is wider
+static const TraceCheck deviceTraceCheck = {"device_*.csv", 20, 20, 0.0020, 0.060};
+
+// Metrics of one gravity series against the trace
+struct TraceMetrics {
+  float latencyMs;         // NAN when the reference never moves
+  float jitter;            // NAN when the reference is never still
+  float maxError;
+};
+
+static bool loadTrace(const char* path, std::vector<TraceSample>& samples) {
+  FILE* file = fopen(path, "r");
+  if (file == NULL) {
+    return false;
+  }
+  char line[160];
+  while (fgets(line, sizeof(line), file)) {
+    if (line[0] == '#' || line[0] == '\n') {
+      continue;
+    }
+    TraceSample sample;
+    if (sscanf(line, "%u,%d,%d,%d,%d,%d,%d,%f,%f,%f", &sample.us,
+               &sample.accel[0], &sample.accel[1], &sample.accel[2],
+               &sample.gyro[0], &sample.gyro[1], &sample.gyro[2],
+               &sample.truth[0], &sample.truth[1], &sample.truth[2]) == 10) {
+      samples.push_back(sample);
+    }
+  }
+  fclose(file);
+  return !samples.empty();
+}
+
+static float distance(const float* a, const float* b) {
+  float dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+  return sqrtf(dx * dx + dy * dy + dz * dz);
+}
+
+// Reference gravity at any time, linearly interpolated between samples
+static bool truthAt(const std::vector<TraceSample>& samples, int64_t us, float* out) {
+  if (us < samples.front().us || us > samples.back().us) {
+    return false;
+  }
+  size_t period = samples[1].us - samples[0].us;
+  size_t index = (size_t)((us - samples.front().us) / period);
+  if (index + 1 >= samples.size()) {
+    memcpy(out, samples.back().truth, sizeof(samples.back().truth));
+    return true;
+  }
+  float fraction = (float)(us - samples[index].us) / period;
+  for (int i = 0; i < 3; i++) {
+    out[i] = samples[index].truth[i] + (samples[index + 1].truth[i] - samples[index].truth[i]) * fraction;
+  }
+  return true;
+}
+
+// 'estimates' belong to sample time + targetUs; latency is the delay that best
+// lines them up with the reference
+static TraceMetrics measure(const std::vector<TraceSample>& samples,
+                            const std::vector<std::array<float, 3>>& estimates, int64_t targetUs) {
+  TraceMetrics metrics = {NAN, NAN, 0};
+  float truth[3];
+
+  bool moving = false;
+  double jitterSum = 0;
+  int stillCount = 0;
+  int unchanged = 0;
+  for (size_t i = 0; i < samples.size(); i++) {
+    if (i > 0 && distance(samples[i].truth, samples[i - 1].truth) > 1e-5f) {
+      moving = true;
+      unchanged = 0;
+    } else {
+      unchanged++;
+    }
+    if (samples[i].us < SETTLE_US || !truthAt(samples, samples[i].us + targetUs, truth)) {
+      continue;
+    }
+    float error = distance(estimates[i].data(), truth);
+    metrics.maxError = max(metrics.maxError, error);
+    // Successive differences cancel any steady offset; /2 leaves the per-sample variance
+    if (unchanged >= STILL_SAMPLES) {
+      float step = distance(estimates[i].data(), estimates[i - 1].data());
+      jitterSum += step * step / 2;
+      stillCount++;
+    }
+  }
+  if (stillCount > 0) {
+    metrics.jitter = sqrt(jitterSum / stillCount);
+  }
+
+  if (moving) {
+    double bestRms = INFINITY;
+    for (int64_t lag = LAG_MIN_US; lag <= LAG_MAX_US; lag += LAG_STEP_US) {
+      double sum = 0;
+      int count = 0;
+      for (size_t i = 0; i < samples.size(); i++) {
+        if (samples[i].us >= SETTLE_US && truthAt(samples, samples[i].us + targetUs - lag, truth)) {
+          float error = distance(estimates[i].data(), truth);
+          sum += error * error;
+          count++;
+        }
+      }
+      if (count > 0 && sum / count < bestRms) {
+        bestRms = sum / count;
+        metrics.latencyMs = lag / 1000.0f;
+      }
+    }
+  }
+  return metrics;
+}
+
+static void printMetrics(const char* label, const TraceMetrics& metrics) {
+  char latency[16], jitter[16];
+  snprintf(latency, sizeof(latency), isnan(metrics.latencyMs) ? "-" : "%.0f ms", metrics.latencyMs);
+  snprintf(jitter, sizeof(jitter), isnan(metrics.jitter) ? "-" : "%.5f", metrics.jitter);
+  printf("  %-8s latency %-8s jitter %-9s max error %.4f\n", label, latency, jitter, metrics.maxError);
+}
+
+// Negative limits and NAN metrics are both "not applicable"
+static int checkLimit(const char* file, const char* name, float value, float limit, const char* unit) {
+  if (limit < 0 || isnan(value) || fabsf(value) <= limit) {
+    return 0;
+  }
+  printf("❌ %s: %s %.4f%s over the %.4f%s limit\n", file, name, value, unit, limit, unit);
+  return 1;
+}
+
+static int replayTrace(const char* directory, const TraceCheck& check) {
+  std::string path = std::string(directory) + "/" + check.file;
+  std::vector<TraceSample> samples;
+  if (!loadTrace(path.c_str(), samples) || samples.size() < 2) {
+    printf("❌ %s: could not read trace\n", path.c_str());
+    return 1;
+  }
+
+  // Same per-sample EMA the sensor manager used before fusion
+  const float emaStrength = 1.0f - powf(0.85f, 20.0f / MPU6050_SAMPLE_RATE_HZ);
+  float ema[3] = {0, 0, 0};
+
+  std::vector<std::array<float, 3>> fused, predicted, smoothed;
+  resetMotionFusion(samples[0].accel);
+  for (size_t i = 0; i < samples.size(); i++) {
+    const TraceSample& sample = samples[i];
+    updateMotionFusion(sample.accel, sample.gyro);
+
+    std::array<float, 3> gravity;
+    predictGravity(0, gravity.data());
+    fused.push_back(gravity);
+    predictGravity(MOTION_PREDICTION_LEAD_MS * 1000UL, gravity.data());
+    predicted.push_back(gravity);
+
+    float magnitude = sqrtf((float)sample.accel[0] * sample.accel[0] + (float)sample.accel[1] * sample.accel[1] +
+                            (float)sample.accel[2] * sample.accel[2]);
+    for (int axis = 0; axis < 3; axis++) {
+      float measured = sample.accel[axis] / magnitude;
+      ema[axis] = (i == 0) ? measured : ema[axis] + emaStrength * (measured - ema[axis]);
+    }
+    smoothed.push_back({ema[0], ema[1], ema[2]});
+  }
+
+  TraceMetrics fusedMetrics = measure(samples, fused, 0);
+  TraceMetrics displayMetrics = measure(samples, predicted, MOTION_PREDICTION_LEAD_MS * 1000L);
+  TraceMetrics emaMetrics = measure(samples, smoothed, 0);
+
+  printf("%s (%u samples)\n", check.file, (unsigned)samples.size());
+  printMetrics("fused", fusedMetrics);
+  printMetrics("display", displayMetrics);
+  printMetrics("old EMA", emaMetrics);
+
+  int failures = 0;
+  failures += checkLimit(check.file, "latency", fusedMetrics.latencyMs, check.maxLatencyMs, " ms");
+  failures += checkLimit(check.file, "display lag", displayMetrics.latencyMs, check.maxDisplayLagMs, " ms");
+  failures += checkLimit(check.file, "jitter", fusedMetrics.jitter, check.maxJitter, "");
+  failures += checkLimit(check.file, "max error", fusedMetrics.maxError, check.maxError, "");
+  return failures;
+}
+
+static std::vector<std::string> findDeviceTraces(const char* directory) {
+  std::vector<std::string> names;
+  DIR* dir = opendir(directory);
+  if (dir == NULL) {
+    return names;
+  }
+  while (struct dirent* entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name.rfind("device_", 0) == 0 && name.size() > 4 && name.compare(name.size() - 4, 4, ".csv") == 0) {
+      names.push_back(name);
+    }
+  }
+  closedir(dir);
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+int main(int argc, char** argv) {
+  const char* directory = argc > 1 ? argv[1] : "traces";
+
+  int failures = 0;
+  for (size_t i = 0; i < sizeof(traceChecks) / sizeof(traceChecks[0]); i++) {
+    failures += replayTrace(directory, traceChecks[i]);
+  }
+  std::vector<std::string> deviceTraces = findDeviceTraces(directory);
+  for (const std::string& name : deviceTraces) {
+    TraceCheck check = deviceTraceCheck;
+    check.file = name.c_str();
+    failures += replayTrace(directory, check);
+  }
+  if (deviceTraces.empty()) {
+    printf("ℹ️ No device traces - capture one with /imu-trace and make_traces.py --device\n");
+  }
+  if (failures == 0) {
+    printf("✅ All traces within limits\n");
+  } else {
+    printf("❌ %d limit(s) exceeded\n", failures);
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -6,6 +6,24 @@
 #include "web_server.h"
 #include "config.h"
 #include "led_control.h"
+#include "pattern_engine.h"
+#include "github_client.h"
+#include "frame_check.h"
+#include "alloc_guard.h"
+#include "pattern_arena.h"
+#include "compositor.h"
+#include "frame_queue.h"
+#include "anim_player.h"
+#include "display_list.h"
+#include "pixel_vm.h"
+#include "pattern_preview.h"
+#include "i2c_bus.h"
+#include "power_manager.h"
+#include "boot_timeline.h"
+#include "battery_manager.h"
+#include "sensor_manager.h"
+#include "pattern_status.h"
+#include "runtime_governor.h"
 
 // Hardware definitions now in config.h
 #ifndef BUTTON_PIN_1
@@ -18,170 +36,177 @@
 #define BUTTON_PIN_3 26
 #endif
 
-// External variable declarations
-extern bool isCharging;
-
-extern float gravityX, gravityY;
-
-// Pattern type declarations
-enum PatternType {
-  PATTERN_PLASMA_BLOB,
-  PATTERN_RAIN_MATRIX,
-  PATTERN_RAINBOW_WAVE,
-  PATTERN_STARFIELD,
-  PATTERN_RIPPLES,
-  PATTERN_GITHUB_ACTIVITY,
-  PATTERN_OFF
-};
-extern PatternType currentPattern;
-
-// Forward declarations for battery functions
-float getBatteryPercentage();
-float getBatteryVoltage();
-bool isFuelGaugeWorking();
-
 // Web server instance  
 WebServer server(80);
+static volatile bool webServerReady = false;
+
+// WiFi bring-up state machine (see serviceWiFi)
+enum WiFiBringUpState {
+  WIFI_BRINGUP_RESET,
+  WIFI_BRINGUP_STATION_START,
+  WIFI_BRINGUP_CONNECTING,
+  WIFI_BRINGUP_STATION_RETRY,
+  WIFI_BRINGUP_AP_START,
+  WIFI_BRINGUP_SERVER_START,
+  WIFI_BRINGUP_RUNNING
+};
+static const char* const wifiStateNames[] = {
+  "reset", "stationStart", "connecting", "stationRetry", "apStart", "serverStart", "running"
+};
+static volatile WiFiBringUpState wifiState = WIFI_BRINGUP_RESET;
+static unsigned long wifiStateSince = 0;
+static unsigned long wifiStateWaitMs = 0;
+static unsigned long wifiConnectStart = 0;
+static unsigned long wifiLastStuckCheck = 0;
 
 // LED Painter variables
 bool painterMode = false;
 CRGB painterGrid[MATRIX_HEIGHT][MATRIX_WIDTH];
 uint8_t painterBrightness = 255;
+bool painterGridChanged = false;
+
+// Largest display list accepted by /draw
+#define DRAW_COMMAND_MAX 1024
+
+static int hexDigitValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
 
-int scanI2CDevices() {
-  int deviceCount = 0;
+// Decodes a hex-encoded body (or ?<argName>=) - binary bodies do not survive WebServer.
+// Sends the 400 response itself and returns false on bad input.
+static bool readHexRequest(const char* argName, uint8_t* out, size_t capacity, size_t& length) {
+  String hex = server.hasArg(argName) ? server.arg(argName) : server.arg("plain");
+  hex.trim();
   
-  for (int address = 1; address < 127; address++) {
-    Wire.beginTransmission(address);
-    if (Wire.endTransmission() == 0) {
-      deviceCount++;
+  length = hex.length() / 2;
+  if (hex.length() % 2 != 0 || length == 0 || length > capacity) {
+    server.send(400, "text/plain", "Expected 1-" + String(capacity) + " hex-encoded bytes");
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    int high = hexDigitValue(hex[i * 2]);
+    int low = hexDigitValue(hex[i * 2 + 1]);
+    if (high < 0 || low < 0) {
+      server.send(400, "text/plain", "Invalid hex at byte " + String(i));
+      return false;
     }
+    out[i] = (uint8_t)((high << 4) | low);
   }
-  
-  return deviceCount;
+  return true;
 }
 
-String getI2CDeviceList() {
-  String deviceList = "Found I2C devices: ";
-  int deviceCount = 0;
-  
-  for (int address = 1; address < 127; address++) {
-    Wire.beginTransmission(address);
-    if (Wire.endTransmission() == 0) {
-      if (deviceCount > 0) deviceList += ", ";
-      deviceList += "0x" + String(address, HEX);
-      
-      // Identify known devices
-      if (address == 0x68) deviceList += " (MPU6050)";
-      else if (address == 0x36) deviceList += " (Max17048)";
-      
-      deviceCount++;
+// Pattern names used by /pattern and /preview (-1 if unknown)
+static int patternFromName(const String& type) {
+  if (type == "plasma") return PATTERN_PLASMA_BLOB;
+  if (type == "rain") return PATTERN_RAIN_MATRIX;
+  if (type == "rainbow") return PATTERN_RAINBOW_WAVE;
+  if (type == "starfield") return PATTERN_STARFIELD;
+  if (type == "ripples") return PATTERN_RIPPLES;
+  if (type == "github") return PATTERN_GITHUB_ACTIVITY;
+  if (type == "off") return PATTERN_OFF;
+  if (type == "animation") return PATTERN_ANIMATION;
+  if (type == "custom") return PATTERN_CUSTOM;
+  return -1;
+}
+
+static const char* patternToName(uint8_t pattern) {
+  static const char* const names[] = {"plasma", "rain", "rainbow", "starfield", "ripples",
+                                      "github", "off", "animation", "custom"};
+  return pattern <= PATTERN_CUSTOM ? names[pattern] : "unknown";
+}
+
+// Text for HTML content and quoted attributes - animation names come from the
+// flashed pack and may hold anything
+static String escapeHtml(const String& text) {
+  String escaped;
+  escaped.reserve(text.length());
+  for (unsigned int i = 0; i < text.length(); i++) {
+    char c = text[i];
+    switch (c) {
+      case '&': escaped += "&amp;"; break;
+      case '<': escaped += "&lt;"; break;
+      case '>': escaped += "&gt;"; break;
+      case '"': escaped += "&quot;"; break;
+      case '\'': escaped += "&#39;"; break;
+      default: escaped += c; break;
     }
   }
-  
-  if (deviceCount == 0) {
-    deviceList = "No I2C devices found! Check SDA/SCL wiring.";
+  return escaped;
+}
+
+// JS string literal body - anything outside a safe set becomes \xNN, so it cannot
+// close the string or (once the attribute is decoded) the surrounding markup
+static String escapeJsString(const String& text) {
+  static const char hexDigits[] = "0123456789ABCDEF";
+  String escaped;
+  for (unsigned int i = 0; i < text.length(); i++) {
+    uint8_t c = (uint8_t)text[i];
+    if (isalnum(c) || c == ' ' || c == '_' || c == '-' || c == '&' || c == '=') {
+      escaped += (char)c;
+    } else {
+      escaped += "\\x";
+      escaped += hexDigits[c >> 4];
+      escaped += hexDigits[c & 0x0F];
+    }
   }
-  
-  return deviceList;
+  return escaped;
 }
 
-void setupWebServer() {
-  // Complete WiFi reset to fix state machine issues
-  Serial.println("🔧 Initializing WiFi...");
-  WiFi.disconnect(true);
-  WiFi.mode(WIFI_OFF);
-  delay(2000); // Longer delay for complete reset
-  
-  // Use externally defined credentials to avoid duplication
-  extern const char* home_ssid;
-  extern const char* home_password;
-  extern const char* ap_ssid;
-  extern const char* ap_password;
-  
-  Serial.printf("🌐 Connecting to WiFi: %s\n", HOME_WIFI_SSID);
-  
-  // Set WiFi to station mode and configure - fixes "cannot set config" error
-  WiFi.mode(WIFI_STA);
-  delay(100); // Critical delay after mode change
-  
-  // Disable auto features that can cause state conflicts
-  WiFi.setAutoReconnect(false);
-  // Note: setAutoConnect() not available in ESP32 Arduino Core 3.3.0
-  delay(100);
-  
-  // Additional ESP32-specific settings to prevent connection issues
-  WiFi.setSleep(false); // Disable WiFi sleep mode
-  delay(100);
-  
-  Serial.printf("📋 WiFi Mode: %d, Status: %d\n", WiFi.getMode(), WiFi.status());
-  
-  // Begin connection with timeout
-  Serial.println("🔌 Starting WiFi connection...");
-  WiFi.begin(HOME_WIFI_SSID, HOME_WIFI_PASSWORD);
-  delay(500); // Allow connection to initialize
-  
-  // More robust connection attempts with proper state checking
-  int attempts = 0;
-  const int maxAttempts = 20; // Reduced max attempts
-  
-  while (WiFi.status() != WL_CONNECTED && attempts < maxAttempts) {
-    delay(1000);
-    Serial.print(".");
-    attempts++;
-    
-    // Check WiFi status and reset if stuck
-    if (attempts % 5 == 0) {
-      wl_status_t status = WiFi.status();
-      Serial.printf("\n🔍 WiFi Status: %d (attempt %d/%d)\n", status, attempts, maxAttempts);
-      
-      // If stuck in connecting state, force reset
-      if (status == WL_DISCONNECTED || status == WL_CONNECTION_LOST || status == WL_NO_SSID_AVAIL) {
-        Serial.println("🔄 WiFi stuck - performing hard reset...");
-        WiFi.disconnect(true);
-        WiFi.mode(WIFI_OFF);
-        delay(1000);
-        WiFi.mode(WIFI_STA);
-        delay(500);
-        WiFi.begin(HOME_WIFI_SSID, HOME_WIFI_PASSWORD);
-      }
+// Pattern button with an animated preview canvas (filled in by playPreview() on the page)
+static String patternButton(const String& type, const String& label) {
+  String button = "<button class='pattern-btn' onclick='setPattern(\"" + escapeHtml(escapeJsString(type)) + "\")'>";
+  if (type != "off" && type != "github") {
+    button += "<canvas class='preview' data-type='" + escapeHtml(type) + "' width='16' height='16'></canvas><br>";
+  }
+  return button + escapeHtml(label) + "</button>";
+}
+
+// Devices that answered their latest probe or transfer (from the bus task's inventory)
+int countI2CDevices() {
+  I2cInventoryEntry entries[I2C_INVENTORY_SIZE];
+  uint8_t count = getI2cInventory(entries, I2C_INVENTORY_SIZE);
+  int present = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (entries[i].present) present++;
+  }
+  return present;
+}
+
+String getI2CDeviceList() {
+  I2cInventoryEntry entries[I2C_INVENTORY_SIZE];
+  uint8_t count = getI2cInventory(entries, I2C_INVENTORY_SIZE);
+  if (count == 0) {
+    if (getI2cInventorySweeps() == 0) {
+      return "Scanning I2C bus...";
     }
+    return "No I2C devices found! Check SDA/SCL wiring.";
   }
   
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.println();
-    Serial.println("✅ WiFi connected to home network!");
-    Serial.printf("📡 IP address: %s\n", WiFi.localIP().toString().c_str());
-    Serial.printf("📶 Signal strength: %d dBm\n", WiFi.RSSI());
-  } else {
-    Serial.println();
-    Serial.printf("❌ Failed to connect to '%s'\n", HOME_WIFI_SSID);
-    Serial.printf("🔍 Final WiFi status: %d\n", WiFi.status());
-    Serial.println("📋 Possible issues:");
-    Serial.println("   - Incorrect WiFi credentials");
-    Serial.println("   - WiFi network not in range");
-    Serial.println("   - Router security settings");
-    Serial.println("   - ESP32 antenna/hardware issue");
-    Serial.println();
-    Serial.println("🏠 Starting AP mode instead...");
-    
-    // Ensure clean transition to AP mode
-    WiFi.disconnect(true);
-    WiFi.mode(WIFI_OFF);
-    delay(1000);
-    WiFi.mode(WIFI_AP);
-    
-    bool apStarted = WiFi.softAP(AP_SSID, AP_PASSWORD);
-    if (apStarted) {
-      Serial.println("✅ WiFi AP started successfully");
-      Serial.printf("📍 AP IP address: %s\n", WiFi.softAPIP().toString().c_str());
-      Serial.printf("📡 Connect to network: %s\n", AP_SSID);
-      Serial.printf("🔑 Password: %s\n", AP_PASSWORD);
-    } else {
-      Serial.println("❌ Failed to start AP mode");
+  String deviceList = "Found I2C devices (" + String(getI2cInventorySweeps()) + " sweeps):";
+  unsigned long now = millis();
+  for (uint8_t i = 0; i < count; i++) {
+    const I2cInventoryEntry& entry = entries[i];
+    deviceList += "<br>0x" + String(entry.address, HEX);
+    
+    // Identify known devices
+    if (entry.address == 0x68) deviceList += " (MPU6050)";
+    else if (entry.address == 0x36) deviceList += " (Max17048)";
+    
+    deviceList += entry.present ? " - seen " : " - MISSING, last seen ";
+    deviceList += String((now - entry.lastSeenMs) / 1000) + "s ago";
+    if (entry.errors > 0 || entry.missedProbes > 0) {
+      deviceList += ", " + String(entry.errors) + " errors, " + String(entry.missedProbes) + " missed probes";
     }
   }
   
+  return deviceList;
+}
+
+// Registers the routes and starts listening - called by the WiFi task once a network is up
+static void setupWebServer() {
   // Serve control page
   server.on("/", []() {
     String html = "<!DOCTYPE html><html><head><title>LED Panel Controller</title>";
@@ -191,7 +216,8 @@ void setupWebServer() {
     html += "button{padding:15px 30px;margin:10px;font-size:16px;border:none;border-radius:5px;cursor:pointer;}";
     html += ".pattern-btn{background:#4CAF50;color:white;}";
     html += ".game-btn{background:#FF9800;color:white;}";
-    html += ".status{margin:20px 0;padding:10px;background:#333;border-radius:5px;}</style></head>";
+    html += ".status{margin:20px 0;padding:10px;background:#333;border-radius:5px;}";
+    html += ".preview{width:48px;height:48px;image-rendering:pixelated;background:#000;}</style></head>";
     html += "<body><div class='container'><h1>LED Panel Controller</h1>";
     html += "<div class='status'><h3>Mode: <span id='mode'>Pattern</span></h3>";
     html += "<p>Battery: <span id='battery'>Loading...</span>%</p>";
@@ -200,23 +226,34 @@ void setupWebServer() {
     html += "<h3>Brightness Control</h3>";
     html += "<button class='game-btn' onclick='cycleBrightness()'>Cycle Brightness Level</button>";
     html += "<p id='brightness-info'>Current: AUTO (battery controlled)</p>";
+    html += "<p>Smoothing: <select id='interpolation' onchange='setInterpolation(this.value)'>";
+    html += "<option value='1'>Off (render every frame)</option><option value='2'>2x</option>";
+    html += "<option value='3'>3x</option><option value='4'>4x</option><option value='6'>6x</option></select></p>";
     html += "<h3>Patterns</h3>";
-    html += "<button class='pattern-btn' onclick='setPattern(\"plasma\")'>Plasma Blob</button>";
-    html += "<button class='pattern-btn' onclick='setPattern(\"rain\")'>Rain Matrix</button>";
-    html += "<button class='pattern-btn' onclick='setPattern(\"rainbow\")'>Rainbow Wave</button>";
-    html += "<button class='pattern-btn' onclick='setPattern(\"starfield\")'>Starfield</button>";
-    html += "<button class='pattern-btn' onclick='setPattern(\"ripples\")'>Ripples</button>";
-    html += "<button class='pattern-btn' onclick='setPattern(\"github\")'>GitHub Activity</button>";
-    html += "<button class='pattern-btn' onclick='setPattern(\"off\")'>Off</button>";
+    html += patternButton("plasma", "Plasma Blob");
+    html += patternButton("rain", "Rain Matrix");
+    html += patternButton("rainbow", "Rainbow Wave");
+    html += patternButton("starfield", "Starfield");
+    html += patternButton("ripples", "Ripples");
+    html += patternButton("github", "GitHub Activity");
+    html += patternButton("off", "Off");
+    for (uint8_t i = 0; i < getAnimationCount(); i++) {
+      html += patternButton("animation&index=" + String(i), getAnimationName(i));
+    }
+    if (isPixelVmLoaded()) {
+      html += patternButton("custom", "Custom");
+    }
     html += "<h3>LED Painter</h3>";
     html += "<a href='/painter' style='display:inline-block;padding:15px 30px;margin:10px;background:#9C27B0;color:white;text-decoration:none;border-radius:5px;'>LED Painter</a>";
     html += "<h3>Diagnostics</h3>";
     html += "<a href='/diagnostics' style='display:inline-block;padding:15px 30px;margin:10px;background:#666;color:white;text-decoration:none;border-radius:5px;'>System Diagnostics</a>";
     html += "<h3>Emergency Tools</h3>";
     html += "<button onclick='resetFuelGauge()' style='background:#ff4444;'>Reset Fuel Gauge</button>";
+    html += "<button onclick='calibrateImu()'>Recalibrate Tilt Sensor</button>";
     html += "</div><script>";
     html += "function setPattern(pattern){fetch('/pattern?type='+pattern).then(()=>updateStatus());}";
     html += "function cycleBrightness(){fetch('/brightness').then(()=>updateStatus());}";
+    html += "function setInterpolation(factor){fetch('/interpolation?factor='+factor).then(()=>updateStatus());}";
     html += "function updateStatus(){fetch('/status').then(r=>r.json()).then(data=>{";
     html += "document.getElementById('mode').textContent=data.mode;";
     html += "document.getElementById('battery').textContent=data.battery;";
@@ -224,8 +261,23 @@ void setupWebServer() {
     html += "var githubStatus='Updated '+data.githubLastUpdate+'s ago';";
     html += "if(data.githubStale==='true')githubStatus+=' (stale)';";
     html += "document.getElementById('github-status').textContent=githubStatus;";
+    html += "document.getElementById('interpolation').value=data.keyframeInterval;";
     html += "document.getElementById('brightness-info').textContent='Current: '+data.brightnessMode+' ('+data.currentBrightness+')';});}";
+        html += "function calibrateImu(){if(confirm('Lay the panel flat and keep it still for a second. Continue?')){fetch('/calibrate-imu').then(r=>r.text()).then(result=>alert(result));}}";
         html += "function resetFuelGauge(){if(confirm('WARNING: This will reset fuel gauge learning data. Continue?')){fetch('/reset-fuel-gauge').then(r=>r.text()).then(result=>alert(result));}}";  
+    // Previews are anim_player clips (keyframe/XOR delta RLE frames in serpentine LED order)
+    html += "function playPreview(c){return fetch('/preview?type='+c.dataset.type).then(r=>r.status==202?new Promise(w=>setTimeout(w,500)).then(()=>playPreview(c)):r.ok?r.arrayBuffer().then(b=>showPreview(c,b)):null);}";
+    html += "function showPreview(c,b){";
+    html += "var d=new DataView(b),n=d.getUint16(6,true),delay=d.getUint16(8,true),o=12,px=new Uint8Array(768),frames=[];";
+    html += "for(var f=0;f<n;f++){var delta=d.getUint8(o),e=o+4+d.getUint16(o+2,true),p=o+4,q=0;";
+    html += "while(p<e){var k=d.getUint8(p++),cnt=(k&127)+1;for(var j=0;j<cnt;j++,q++){var v=d.getUint8(k&128?p:p+j);px[q]=delta?px[q]^v:v;}p+=k&128?1:cnt;}";
+    html += "frames.push(px.slice());o=e;}";
+    html += "var g=c.getContext('2d'),img=g.createImageData(16,16),i=0;setInterval(()=>{var fr=frames[i++%n];";
+    html += "for(var y=0;y<16;y++)for(var x=0;x<16;x++){var s=(y*16+(y&1?15-x:x))*3,t=(y*16+x)*4;";
+    html += "img.data[t]=fr[s];img.data[t+1]=fr[s+1];img.data[t+2]=fr[s+2];img.data[t+3]=255;}g.putImageData(img,0,0);},delay);}";
+    // One at a time - a cache miss renders on the device (202 until the clip is ready)
+    html += "var previews=[...document.querySelectorAll('canvas.preview')];";
+    html += "(function next(){var c=previews.shift();if(c)playPreview(c).then(next,next);})();";
     html += "setInterval(updateStatus,2000);updateStatus();</script></body></html>";
     
     server.send(200, "text/html", html);
@@ -233,32 +285,53 @@ void setupWebServer() {
   
   // Pattern control
   server.on("/pattern", []() {
-    String type = server.arg("type");
-    if (type == "plasma") currentPattern = PATTERN_PLASMA_BLOB;
-    else if (type == "rain") currentPattern = PATTERN_RAIN_MATRIX;
-    else if (type == "rainbow") currentPattern = PATTERN_RAINBOW_WAVE;
-    else if (type == "starfield") currentPattern = PATTERN_STARFIELD;
-    else if (type == "ripples") currentPattern = PATTERN_RIPPLES;
-    else if (type == "github") currentPattern = PATTERN_GITHUB_ACTIVITY;
-    else if (type == "off") currentPattern = PATTERN_OFF;
+    noteUserActivity();
+    int pattern = patternFromName(server.arg("type"));
+    if (pattern == PATTERN_ANIMATION && getAnimationCount() > 0) {
+      if (server.hasArg("index")) {
+        selectAnimation((uint8_t)server.arg("index").toInt());
+      }
+      currentPattern = PATTERN_ANIMATION;
+    }
+    else if (pattern == PATTERN_CUSTOM && isPixelVmLoaded()) currentPattern = PATTERN_CUSTOM;
+    else if (pattern >= 0 && pattern != PATTERN_ANIMATION && pattern != PATTERN_CUSTOM) {
+      currentPattern = (PatternType)pattern;
+    }
     
     // Notify GitHub client if switching to/from GitHub pattern
-    extern void setGitHubPatternActive(bool active);
     setGitHubPatternActive(currentPattern == PATTERN_GITHUB_ACTIVITY);
     
     painterMode = false; // Exit painter mode when selecting patterns
     server.send(200, "text/plain", "OK");
   });
   
+  // Pattern preview - anim_player clip rendered offscreen, cached in flash
+  server.on("/preview", []() {
+    int pattern = patternFromName(server.arg("type"));
+    uint8_t index = (uint8_t)server.arg("index").toInt();
+    
+    File preview;
+    PreviewStatus status = (pattern >= 0) ? openPatternPreview((uint8_t)pattern, index, preview)
+                                          : PREVIEW_UNAVAILABLE;
+    if (status == PREVIEW_RENDERING) {
+      // Rendered by the main loop a tick per pass - the page asks again
+      server.send(202, "text/plain", "Rendering preview");
+      return;
+    }
+    if (status != PREVIEW_READY) {
+      server.send(404, "text/plain", "No preview for this pattern");
+      return;
+    }
+    server.streamFile(preview, "application/octet-stream");
+    preview.close();
+  });
+  
   // Brightness control
   server.on("/brightness", []() {
-    extern uint8_t manualBrightnessLevel;
-    
-    // Define brightness levels locally to avoid linker issues
-    const uint8_t brightnessLevels[5] = {0, 80, 140, 180, 220};
+    noteUserActivity();
     
     // Cycle through brightness levels
-    manualBrightnessLevel = (manualBrightnessLevel + 1) % 5;
+    manualBrightnessLevel = (manualBrightnessLevel + 1) % BRIGHTNESS_LEVEL_COUNT;
     
     if (manualBrightnessLevel == 0) {
       // Auto brightness mode
@@ -279,6 +352,91 @@ void setupWebServer() {
     server.send(200, "text/plain", "OK");
   });
 
+  // Display list drawing - body (or ?cmd=) is the hex-encoded command buffer from display_list.h,
+  // drawn on top of the current painter canvas in panel coordinates (y down)
+  server.on("/draw", []() {
+    noteUserActivity();
+    static uint8_t commands[DRAW_COMMAND_MAX];
+    size_t length;
+    if (!readHexRequest("cmd", commands, DRAW_COMMAND_MAX, length)) {
+      return;
+    }
+    
+    // painterGrid rows are stored bottom-up (web painter orientation)
+    static CRGB canvas[NUM_LEDS];
+    for (int y = 0; y < MATRIX_HEIGHT; y++) {
+      for (int x = 0; x < MATRIX_WIDTH; x++) {
+        canvas[y * MATRIX_WIDTH + x] = painterMode ? painterGrid[MATRIX_HEIGHT - 1 - y][x] : CRGB(CRGB::Black);
+      }
+    }
+    
+    if (!executeDisplayList(commands, length, canvas, NULL)) {
+      server.send(400, "text/plain", "Malformed display list");
+      return;
+    }
+    
+    for (int y = 0; y < MATRIX_HEIGHT; y++) {
+      for (int x = 0; x < MATRIX_WIDTH; x++) {
+        painterGrid[MATRIX_HEIGHT - 1 - y][x] = canvas[y * MATRIX_WIDTH + x];
+      }
+    }
+    painterMode = true;
+    painterGridChanged = true;
+    server.send(200, "text/plain", "Drew " + String(length) + " bytes");
+  });
+
+  // Custom pattern upload - body (or ?code=) is hex bytecode from pattern_compiler.py;
+  // it is saved to NVS and shown straight away
+  server.on("/custom-pattern", []() {
+    static uint8_t program[PIXEL_VM_MAX_CODE];
+    size_t length;
+    if (!readHexRequest("code", program, PIXEL_VM_MAX_CODE, length)) {
+      return;
+    }
+    
+    const char* error = NULL;
+    if (!loadPixelVmProgram(program, length, &error)) {
+      server.send(400, "text/plain", String("Rejected: ") + error);
+      return;
+    }
+    bool saved = savePixelVmProgram();
+    invalidatePatternPreview(PATTERN_CUSTOM);
+    
+    currentPattern = PATTERN_CUSTOM;
+    setGitHubPatternActive(false);
+    painterMode = false;
+    server.send(200, "text/plain", "Loaded " + String(getPixelVmPixelInstructions()) + " pixel + " +
+                String(getPixelVmFrameInstructions()) + " frame instructions" + (saved ? "" : " (not saved)"));
+  });
+
+  // Runtime target (?hours=6 = last at least six more hours, 0 = off) - reports hours remaining
+  server.on("/runtime-target", []() {
+    noteUserActivity();
+    if (server.hasArg("hours")) {
+      setRuntimeTarget(server.arg("hours").toFloat());
+    }
+    server.send(200, "text/plain", String(getRuntimeTargetHours(), 1));
+  });
+  
+  // Pattern crossfade duration (?ms=0 switches to hard cuts)
+  server.on("/transition", []() {
+    if (server.hasArg("ms")) {
+      long ms = server.arg("ms").toInt();
+      patternTransitionMs = (uint16_t)constrain(ms, 0L, 5000L);
+    }
+    
+    server.send(200, "text/plain", String(patternTransitionMs));
+  });
+
+  // Keyframe interpolation factor for smooth patterns (?factor=1 renders every frame)
+  server.on("/interpolation", []() {
+    if (server.hasArg("factor")) {
+      setKeyframeInterval((uint8_t)constrain(server.arg("factor").toInt(), 1L, 255L));
+    }
+    
+    server.send(200, "text/plain", String(keyframeInterval));
+  });
+
   // LED Painter page
   server.on("/painter", []() {
     String html = "<!DOCTYPE html><html><head><title>LED Panel Painter</title>";
@@ -451,6 +609,7 @@ void setupWebServer() {
 
   // LED Painter apply endpoint - now handles live updates
   server.on("/painter-apply", HTTP_POST, []() {
+    noteUserActivity();
     if (server.hasArg("plain")) {
       String body = server.arg("plain");
       
@@ -534,6 +693,7 @@ void setupWebServer() {
         
         painterBrightness = finalBrightness;
         painterMode = true;
+        painterGridChanged = true;
         
         // Build response without alerts/emojis
         String response = "Live update applied";
@@ -559,31 +719,128 @@ void setupWebServer() {
 
   // Status endpoint
   server.on("/status", []() {
-    extern uint8_t manualBrightnessLevel;
+    // The open web UI polls this every 2s - keep the panel awake while someone is watching
+    noteUserActivity();
+    
+    // One consistent copy of each publisher's state for the whole response
+    BatteryState battery = readSnapshot(batterySnapshot);
+    GravityState gravity = readSnapshot(gravitySnapshot);
+    PatternStatus patternState = readSnapshot(patternStatus);
     
     String json = "{";
     json += "\"mode\":\"Pattern\",";
-    json += "\"battery\":" + String(getBatteryPercentage(), 1) + ",";
-    json += "\"voltage\":" + String(getBatteryVoltage(), 2) + ",";
-    json += "\"fuelGaugeWorking\":" + String(isFuelGaugeWorking() ? "true" : "false") + ",";
-    json += "\"charging\":" + String(isCharging ? "true" : "false") + ",";
-    json += "\"gravityX\":" + String(gravityX, 2) + ",";
-    json += "\"gravityY\":" + String(gravityY, 2) + ",";
+    json += "\"battery\":" + String(battery.percentage, 1) + ",";
+    json += "\"voltage\":" + String(battery.voltage, 2) + ",";
+    json += "\"fuelGaugeWorking\":" + String(battery.fuelGaugeWorking ? "true" : "false") + ",";
+    json += "\"charging\":" + String(battery.charging ? "true" : "false") + ",";
+    json += "\"fuelGauge\":{";
+    json += "\"chargeRate\":" + String(battery.chargeRate, 1) + ",";
+    json += "\"hibernating\":" + String(battery.fuelGaugeHibernating ? "true" : "false") + ",";
+    json += "\"bursts\":" + String(getFuelGaugeBurstCount()) + ",";
+    json += "\"alerts\":" + String(getFuelGaugeAlertCount());
+    json += "},";
+    json += "\"gravityX\":" + String(gravity.x, 2) + ",";
+    json += "\"gravityY\":" + String(gravity.y, 2) + ",";
+    json += "\"imu\":{";
+    json += "\"dataReadyInterrupt\":" + String(isGravityInterruptActive() ? "true" : "false") + ",";
+    json += "\"bursts\":" + String(getGravityBurstCount()) + ",";
+    json += "\"samples\":" + String(getGravitySampleCount()) + ",";
+    json += "\"fifoResets\":" + String(getGravityFifoResets()) + ",";
+    json += "\"rollDeg\":" + String(getTiltRoll(), 1) + ",";
+    json += "\"pitchDeg\":" + String(getTiltPitch(), 1) + ",";
+    json += "\"temperatureC\":" + String(getImuTemperature(), 1) + ",";
+    json += "\"calibration\":\"" + String(isImuCalibrating() ? "capturing" : isImuCalibrationStored() ? "stored" : "none") + "\",";
+    json += "\"driftCorrections\":" + String(getGyroDriftCorrections());
+    json += "},";
+    json += "\"boot\":{";
+    json += "\"wifi\":\"" + String(getWiFiStateName()) + "\",";
+    json += "\"phases\":[";
+    for (uint8_t i = 0; i < getBootPhaseCount(); i++) {
+      const BootPhase* phase = getBootPhase(i);
+      json += String(i ? "," : "") + "{\"name\":\"" + phase->name + "\",\"ms\":" + String(phase->atMs) + "}";
+    }
+    json += "]},";
+    json += "\"power\":{";
+    json += "\"state\":\"" + String(getPowerStateName()) + "\",";
+    json += "\"idleSeconds\":" + String(getIdleMillis() / 1000) + ",";
+    json += "\"lightSleeps\":" + String(getLightSleepCount()) + ",";
+    json += "\"lastWake\":\"" + String(getLastWakeSource()) + "\"";
+    json += "},";
+    json += "\"governor\":{";
+    json += "\"active\":" + String(isRuntimeGovernorActive() ? "true" : "false") + ",";
+    json += "\"targetHours\":" + String(getRuntimeTargetHours(), 2) + ",";
+    json += "\"drainPctPerHour\":" + String(getGovernorDrainRate(), 2) + ",";
+    json += "\"predictedHours\":" + String(getGovernorPredictedHours(), 1) + ",";
+    json += "\"source\":\"" + String(getGovernorSource()) + "\",";
+    json += "\"brightnessCeiling\":" + String(getGovernorBrightnessCeiling()) + ",";
+    json += "\"contentLevel\":" + String(getGovernorContentLevel(), 3);
+    json += "},";
+    json += "\"i2c\":{";
+    json += "\"frequencyKHz\":" + String(I2C_FREQUENCY / 1000) + ",";
+    json += "\"recoveries\":" + String(getI2cBusRecoveries());
+    for (int device = 0; device < I2C_DEVICE_COUNT; device++) {
+      const I2cDeviceStats* stats = getI2cDeviceStats((I2cDevice)device);
+      json += ",\"" + String(getI2cDeviceName((I2cDevice)device)) + "\":{";
+      json += "\"transactions\":" + String(stats->transactions) + ",";
+      json += "\"errors\":" + String(stats->errors) + ",";
+      json += "\"retries\":" + String(stats->retries) + ",";
+      json += "\"expired\":" + String(stats->expired) + ",";
+      json += "\"avgLatencyUs\":" + String(stats->averageLatencyUs) + ",";
+      json += "\"maxLatencyUs\":" + String(stats->maxLatencyUs);
+      json += "}";
+    }
+    json += "},";
+    
+    json += "\"pattern\":{";
+    json += "\"requested\":\"" + String(patternToName(patternState.requested)) + "\",";
+    json += "\"shown\":\"" + String(patternToName(patternState.shown)) + "\",";
+    json += "\"transitioning\":" + String(patternState.transitioning ? "true" : "false") + ",";
+    json += "\"frames\":" + String(patternState.frames);
+    json += "},";
     
     // Add brightness status
     const char* levelNames[] = {"AUTO", "LOW", "MEDIUM", "HIGH", "MAX"};
     json += "\"brightnessMode\":\"" + String(levelNames[manualBrightnessLevel]) + "\",";
     json += "\"currentBrightness\":" + String(getCurrentBrightness()) + ",";
+    json += "\"composedPixels\":" + String(getLastComposedPixels()) + ",";
+    json += "\"transitionMs\":" + String(patternTransitionMs) + ",";
+    json += "\"keyframeInterval\":" + String(keyframeInterval) + ",";
+    json += "\"patternRenderUs\":" + String(getPatternRenderUs()) + ",";
+    json += "\"customPattern\":{";
+    json += "\"loaded\":" + String(isPixelVmLoaded() ? "true" : "false") + ",";
+    json += "\"pixelInstructions\":" + String(getPixelVmPixelInstructions()) + ",";
+    json += "\"frameInstructions\":" + String(getPixelVmFrameInstructions()) + ",";
+    json += "\"foldedNodes\":" + String(getPixelVmFoldedNodes());
+    json += "},";
+    json += "\"frameQueue\":{";
+    json += "\"depth\":" + String(getFrameQueueDepth()) + ",";
+    json += "\"stallFrames\":" + String(getFrameQueueStallFrames()) + ",";
+    json += "\"underruns\":" + String(getFrameQueueUnderruns());
+    json += "},";
+    
+    // Add adaptive resolution metrics
+    json += "\"renderScale\":{";
+    json += "\"halfResolution\":" + String(isHalfResolutionActive() ? "true" : "false") + ",";
+    json += "\"reason\":\"" + String(getRenderScaleReason()) + "\",";
+    json += "\"frameIntervalMs\":" + String(getSmoothedFrameInterval(), 1) + ",";
+    json += "\"switches\":" + String(getRenderScaleSwitches()) + ",";
+    json += "\"halfResFrames\":" + String(getHalfResolutionFrames());
+    json += "},";
     
     // Add GitHub status
-    extern unsigned long getLastGitHubUpdate();
-    extern bool isGitHubDataStale();
     unsigned long lastUpdate = getLastGitHubUpdate();
     unsigned long timeSinceUpdate = (millis() - lastUpdate) / 1000; // seconds
     
     json += "\"githubLastUpdate\":" + String(timeSinceUpdate) + ",";
-    json += "\"githubStale\":" + String(isGitHubDataStale() ? "true" : "false");
-    json += "}";
+    json += "\"githubStale\":" + String(isGitHubDataStale() ? "true" : "false") + ",";
+    
+    // Add hot-path heap allocation counts (should stay at zero)
+    json += "\"allocations\":{";
+    json += "\"pattern\":" + String(getAllocCount(ALLOC_STAGE_PATTERN)) + ",";
+    json += "\"show\":" + String(getAllocCount(ALLOC_STAGE_SHOW)) + ",";
+    json += "\"buttons\":" + String(getAllocCount(ALLOC_STAGE_BUTTONS)) + ",";
+    json += "\"exact\":" + String(isAllocGuardExact() ? "true" : "false");
+    json += "}}";
     
     server.send(200, "application/json", json);
   });
@@ -597,9 +854,9 @@ void setupWebServer() {
     html += ".good{border-left:5px solid #4CAF50;} .warning{border-left:5px solid #FF9800;} .error{border-left:5px solid #f44336;}</style></head>";
     html += "<body><h1>ESP32 LED Panel Diagnostics</h1>";
     
-    // I2C Device Scan
-    html += "<div class='status " + String((scanI2CDevices() > 0) ? "good" : "error") + "'>";
-    html += "<h3>I2C Device Scan</h3>";
+    // I2C devices - the bus task keeps the inventory, so this never probes the bus
+    html += "<div class='status " + String((countI2CDevices() > 0) ? "good" : "error") + "'>";
+    html += "<h3>I2C Devices</h3>";
     html += "<p>" + getI2CDeviceList() + "</p>";
     html += "</div>";
     
@@ -613,7 +870,7 @@ void setupWebServer() {
     html += "<p>Voltage: " + String(getBatteryVoltage(), 2) + "V</p>";
     html += "<p>Percentage: " + String(getBatteryPercentage(), 1) + "%</p>";
     html += "<p>Source: " + String(isFuelGaugeWorking() ? "Max17048 Fuel Gauge" : "ADC Voltage Divider") + "</p>";
-    html += "<p>Charging: " + String(isCharging ? "YES" : "NO") + "</p>";
+    html += "<p>Charging: " + String(getChargingStatus() ? "YES" : "NO") + "</p>";
     html += "<p>Raw ADC Reading: " + String(analogRead(BATTERY_ADC_PIN)) + " / 4095</p>";
     html += "</div>";
     
@@ -627,6 +884,7 @@ void setupWebServer() {
     html += "<div class='status good'>";
     html += "<h3>System Information</h3>";
     html += "<p>Free Heap: " + String(ESP.getFreeHeap()) + " bytes</p>";
+    html += "<p>Pattern Arena: " + String(getPatternArenaUsed()) + " / " + String(PATTERN_ARENA_SIZE * PATTERN_ARENA_SLOTS) + " bytes</p>";
     html += "<p>Uptime: " + String(millis() / 1000) + " seconds</p>";
     html += "<p>WiFi RSSI: " + String(WiFi.RSSI()) + " dBm</p>";
     html += "</div>";
@@ -637,9 +895,65 @@ void setupWebServer() {
     server.send(200, "text/html", html);
   });
 
+  // Golden-frame regression check (add ?record=1 to print a new golden table to serial)
+  server.on("/frame-check", []() {
+    bool record = server.hasArg("record") && server.arg("record") == "1";
+    
+    String report;
+    int failures = runFrameCheck(report, record);
+    server.send(failures == 0 ? 200 : 500, "text/plain", report);
+  });
+  
   // Fuel gauge reset endpoint (emergency use only)
+  // Recapture accelerometer offsets and gyro bias from the next second of samples
+  server.on("/calibrate-imu", []() {
+    calibrateGyroscope();
+    server.send(200, "text/plain", "Calibrating - keep the panel flat and still. Check /status for the result.");
+  });
+  
+  // IMU trace for the host fusion replay: the first request starts a capture
+  // (?seconds=N, default 10), later ones answer 202 until it is full, then
+  // download the CSV - test/motion_fusion/make_traces.py --device turns it into a trace
+  server.on("/imu-trace", []() {
+    if (!isImuTraceActive()) {
+      uint16_t seconds = server.hasArg("seconds") ? server.arg("seconds").toInt() : 10;
+      if (!startImuTrace(seconds)) {
+        server.send(503, "text/plain", "Not enough memory for the trace");
+        return;
+      }
+      server.send(202, "text/plain", "Capturing - handle the panel, then ask again");
+      return;
+    }
+    
+    uint16_t length;
+    const ImuTraceSample* trace = getImuTrace(length);
+    if (trace == NULL) {
+      server.send(202, "text/plain", "Capturing (" + String(length) + " samples so far)");
+      return;
+    }
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "text/csv", "# us,ax,ay,az,gx,gy,gz (calibrated counts)\n");
+    String chunk;
+    chunk.reserve(1024);
+    char line[64];
+    for (uint16_t i = 0; i < length; i++) {
+      const ImuTraceSample& sample = trace[i];
+      snprintf(line, sizeof(line), "%lu,%d,%d,%d,%d,%d,%d\n",
+               (unsigned long)i * (1000000UL / MPU6050_SAMPLE_RATE_HZ),
+               sample.accel[0], sample.accel[1], sample.accel[2],
+               sample.gyro[0], sample.gyro[1], sample.gyro[2]);
+      chunk += line;
+      if (chunk.length() > 960) {
+        server.sendContent(chunk);
+        chunk = "";
+      }
+    }
+    server.sendContent(chunk);
+    server.sendContent("");
+    endImuTrace();
+  });
+  
   server.on("/reset-fuel-gauge", []() {
-    extern void resetFuelGaugeHardware();
     resetFuelGaugeHardware();
     server.send(200, "text/plain", "Fuel gauge reset complete. Battery readings should stabilize within 30 seconds.");
   });
@@ -648,7 +962,6 @@ void setupWebServer() {
   server.on("/github-data", HTTP_POST, []() {
     if (server.hasArg("plain")) {
       String jsonData = server.arg("plain");
-      extern void setGitHubData(const String& jsonData);
       setGitHubData(jsonData);
       server.send(200, "text/plain", "GitHub data updated successfully");
     } else {
@@ -657,5 +970,126 @@ void setupWebServer() {
   });
   
   server.begin();
+  webServerReady = true;
   Serial.println("Web server started");
+}
+
+// WiFi bring-up, serviced every WIFI_SERVICE_MS from its own task so no step ever
+// blocks the LEDs: station connect with stuck-state resets, AP fallback, then the server
+static void enterWiFiState(WiFiBringUpState state, unsigned long waitMs) {
+  wifiState = state;
+  wifiStateSince = millis();
+  wifiStateWaitMs = waitMs;
+}
+
+static void startStationConnect() {
+  WiFi.mode(WIFI_STA);
+  // Reconnects are handled here rather than by the driver's own state machine
+  WiFi.setAutoReconnect(false);
+  WiFi.setSleep(false); // Disable WiFi sleep mode
+  WiFi.begin(HOME_WIFI_SSID, HOME_WIFI_PASSWORD);
+  Serial.printf("🔌 Connecting to WiFi: %s\n", HOME_WIFI_SSID);
+}
+
+static void serviceWiFi() {
+  unsigned long now = millis();
+  if (now - wifiStateSince < wifiStateWaitMs) {
+    return;
+  }
+  
+  switch (wifiState) {
+    case WIFI_BRINGUP_RESET:
+      // Complete WiFi reset to fix state machine issues, then give the radio a moment
+      WiFi.disconnect(true);
+      WiFi.mode(WIFI_OFF);
+      enterWiFiState(WIFI_BRINGUP_STATION_START, WIFI_RESET_SETTLE_MS);
+      break;
+      
+    case WIFI_BRINGUP_STATION_START:
+      startStationConnect();
+      wifiConnectStart = now;
+      wifiLastStuckCheck = now;
+      enterWiFiState(WIFI_BRINGUP_CONNECTING, 0);
+      break;
+      
+    case WIFI_BRINGUP_CONNECTING: {
+      wl_status_t status = WiFi.status();
+      if (status == WL_CONNECTED) {
+        markBootPhase("wifiConnected");
+        Serial.printf("✅ WiFi connected to home network! IP %s, %d dBm\n",
+                      WiFi.localIP().toString().c_str(), WiFi.RSSI());
+        enterWiFiState(WIFI_BRINGUP_SERVER_START, 0);
+      } else if (now - wifiConnectStart >= WIFI_CONNECT_TIMEOUT_MS) {
+        Serial.printf("❌ Failed to connect to '%s' (status %d) - starting AP mode instead\n",
+                      HOME_WIFI_SSID, status);
+        WiFi.disconnect(true);
+        WiFi.mode(WIFI_OFF);
+        enterWiFiState(WIFI_BRINGUP_AP_START, WIFI_RESET_SETTLE_MS);
+      } else if (now - wifiLastStuckCheck >= WIFI_STUCK_CHECK_MS) {
+        wifiLastStuckCheck = now;
+        // If stuck in connecting state, force reset (the connect deadline keeps running)
+        if (status == WL_DISCONNECTED || status == WL_CONNECTION_LOST || status == WL_NO_SSID_AVAIL) {
+          Serial.printf("🔄 WiFi stuck (status %d) - performing hard reset...\n", status);
+          WiFi.disconnect(true);
+          WiFi.mode(WIFI_OFF);
+          enterWiFiState(WIFI_BRINGUP_STATION_RETRY, WIFI_RESET_SETTLE_MS);
+        }
+      }
+      break;
+    }
+      
+    case WIFI_BRINGUP_STATION_RETRY:
+      startStationConnect();
+      enterWiFiState(WIFI_BRINGUP_CONNECTING, 0);
+      break;
+      
+    case WIFI_BRINGUP_AP_START:
+      WiFi.mode(WIFI_AP);
+      if (WiFi.softAP(AP_SSID, AP_PASSWORD)) {
+        markBootPhase("apStarted");
+        Serial.printf("✅ WiFi AP '%s' started at %s\n", AP_SSID, WiFi.softAPIP().toString().c_str());
+      } else {
+        Serial.println("❌ Failed to start AP mode");
+      }
+      enterWiFiState(WIFI_BRINGUP_SERVER_START, 0);
+      break;
+      
+    case WIFI_BRINGUP_SERVER_START:
+      setupWebServer();
+      markBootPhase("webServer");
+      Serial.printf("🔗 Web Interface: http://%s\n", (WiFi.getMode() == WIFI_AP ? WiFi.softAPIP() : WiFi.localIP()).toString().c_str());
+      enterWiFiState(WIFI_BRINGUP_RUNNING, 0);
+      break;
+      
+    case WIFI_BRINGUP_RUNNING:
+      // Station dropped (router restart, light sleep) - ask the driver to rejoin now and then
+      if (WiFi.getMode() == WIFI_STA && WiFi.status() != WL_CONNECTED) {
+        Serial.println("🔄 WiFi connection lost - reconnecting");
+        WiFi.reconnect();
+        enterWiFiState(WIFI_BRINGUP_RUNNING, WIFI_CONNECT_TIMEOUT_MS);
+      }
+      break;
+  }
+}
+
+static void wifiTask(void* parameter) {
+  for (;;) {
+    serviceWiFi();
+    vTaskDelay(pdMS_TO_TICKS(WIFI_SERVICE_MS));
+  }
+}
+
+void startWebServerInBackground() {
+  Serial.println("🔧 Initializing WiFi...");
+  enterWiFiState(WIFI_BRINGUP_RESET, 0);
+  // Core 0 alongside the WiFi stack; the main loop only ever sees isWebServerReady()
+  xTaskCreatePinnedToCore(wifiTask, "wifi", WEB_TASK_STACK_SIZE, NULL, WEB_TASK_PRIORITY, NULL, 0);
+}
+
+const char* getWiFiStateName() {
+  return wifiStateNames[wifiState];
+}
+
+bool isWebServerReady() {
+  return webServerReady;
 } 
\ No newline at end of file
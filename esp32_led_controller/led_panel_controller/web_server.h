@@ -10,13 +10,36 @@
 #include <WiFi.h>
 #include <WebServer.h>
 #include <Wire.h>
+#include <FastLED.h>
+#include "config.h"
 
 // External references to web server
 extern WebServer server;
 
+// LED Painter state (set by the painter routes, drawn by the main loop)
+extern bool painterMode;
+extern CRGB painterGrid[MATRIX_HEIGHT][MATRIX_WIDTH];
+extern uint8_t painterBrightness;
+extern bool painterGridChanged;
+
+#ifndef WIFI_SERVICE_MS
+#define WIFI_SERVICE_MS 50          // WiFi task poll interval
+#endif
+#ifndef WIFI_RESET_SETTLE_MS
+#define WIFI_RESET_SETTLE_MS 1000   // Radio off before switching mode
+#endif
+#ifndef WIFI_STUCK_CHECK_MS
+#define WIFI_STUCK_CHECK_MS 5000    // Stuck-connection check while connecting
+#endif
+#ifndef WIFI_CONNECT_TIMEOUT_MS
+#define WIFI_CONNECT_TIMEOUT_MS 20000
+#endif
+
 // Function declarations
-void setupWebServer();
-String getI2CDeviceList();
-int scanI2CDevices();
+void startWebServerInBackground();  // WiFi connect / AP fallback / server start on its own task
+bool isWebServerReady();            // Routes registered and listening (loop may call handleClient)
+const char* getWiFiStateName();
+String getI2CDeviceList();          // From the I2C bus inventory, no bus traffic
+int countI2CDevices();
 
 #endif // WEB_SERVER_H 
\ No newline at end of file
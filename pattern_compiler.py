@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+"""
+Pattern Compiler for ESP32 LED Panel
+Compiles a tiny expression language into pixel VM bytecode (pixel_vm.h)
+
+Example (ripples):
+    let d = sqrt((x - 7.5) * (x - 7.5) + (y - 7.5) * (y - 7.5))
+    let wave = (sin(d * 0.8 - t * 9) * 0.5 + 0.5 + sin(d * 0.4 - t * 13.5) * 0.3 + 0.5) / 2
+    hsv(d * 0.078 + t * 0.59, 1, wave)
+
+Inputs: x, y (0-15), i (pixel index), t (seconds), gx, gy (gravity), battery (0-1)
+Constants: pi, tau, width, height
+Functions: sin cos (radians), sqrt abs floor fract min max clamp(v, lo, hi)
+Output: hsv(h, s, v) or rgb(r, g, b), components 0-1 (hue wraps)
+
+Constant folding and per-frame hoisting of pixel-invariant work happen on the
+device when the program is loaded, so write expressions the readable way.
+"""
+
+import re
+import sys
+import struct
+import argparse
+import math
+import urllib.request
+
+# Must match pixel_vm.h
+PIXEL_VM_MAGIC = 0x31564C42   # "LBV1"
+MAX_CODE = 512
+REGISTERS = 16
+OUTPUT_MODES = {'hsv': 0, 'rgb': 1}
+
+OP_PUSH, OP_X, OP_Y, OP_INDEX, OP_T, OP_GRAVITY_X, OP_GRAVITY_Y, OP_BATTERY = range(0x01, 0x09)
+OP_LOAD, OP_STORE = 0x09, 0x0A
+BINARY_OPS = {'+': 0x10, '-': 0x11, '*': 0x12, '/': 0x13, '%': 0x14, 'min': 0x15, 'max': 0x16}
+UNARY_OPS = {'neg': 0x20, 'abs': 0x21, 'sin': 0x22, 'cos': 0x23, 'sqrt': 0x24,
+             'floor': 0x25, 'fract': 0x26}
+
+INPUTS = {'x': OP_X, 'y': OP_Y, 'i': OP_INDEX, 't': OP_T,
+          'gx': OP_GRAVITY_X, 'gy': OP_GRAVITY_Y, 'battery': OP_BATTERY}
+CONSTANTS = {'pi': math.pi, 'tau': 2 * math.pi, 'width': 16, 'height': 16}
+
+TOKEN = re.compile(r'\s*(?:(\d+\.?\d*|\.\d+)|([A-Za-z_]\w*)|(.))')
+
+
+class CompileError(Exception):
+    pass
+
+
+def tokenize(line):
+    tokens = []
+    for number, name, symbol in TOKEN.findall(line):
+        if number:
+            tokens.append(('num', float(number)))
+        elif name:
+            tokens.append(('name', name))
+        elif symbol.strip():
+            tokens.append(('sym', symbol))
+    return tokens
+
+
+class Parser:
+    """Recursive descent straight to stack code"""
+
+    def __init__(self, tokens, variables):
+        self.tokens = tokens
+        self.position = 0
+        self.variables = variables
+        self.code = bytearray()
+
+    def peek(self):
+        return self.tokens[self.position] if self.position < len(self.tokens) else (None, None)
+
+    def take(self, kind=None, value=None):
+        token = self.peek()
+        if token[0] is None or (kind and token[0] != kind) or (value is not None and token[1] != value):
+            raise CompileError(f"expected {value or kind}, got {token[1]!r}")
+        self.position += 1
+        return token[1]
+
+    def at_symbol(self, *symbols):
+        kind, value = self.peek()
+        return kind == 'sym' and value in symbols
+
+    def push_constant(self, value):
+        fixed = int(round(value * 65536))
+        if not -2**31 <= fixed < 2**31:
+            raise CompileError(f"constant {value} out of Q16.16 range")
+        self.code += struct.pack('<Bi', OP_PUSH, fixed)
+
+    def expression(self):
+        self.term()
+        while self.at_symbol('+', '-'):
+            op = self.take()
+            self.term()
+            self.code.append(BINARY_OPS[op])
+
+    def term(self):
+        self.unary()
+        while self.at_symbol('*', '/', '%'):
+            op = self.take()
+            self.unary()
+            self.code.append(BINARY_OPS[op])
+
+    def unary(self):
+        if self.at_symbol('-'):
+            self.take()
+            self.unary()
+            self.code.append(UNARY_OPS['neg'])
+        else:
+            self.primary()
+
+    def arguments(self, count, name):
+        self.take('sym', '(')
+        for index in range(count):
+            if index:
+                self.take('sym', ',')
+            self.expression()
+        if not self.at_symbol(')'):
+            raise CompileError(f"{name}() takes {count} argument(s)")
+        self.take('sym', ')')
+
+    def primary(self):
+        kind, value = self.peek()
+        if kind == 'num':
+            self.take()
+            self.push_constant(value)
+        elif self.at_symbol('('):
+            self.take()
+            self.expression()
+            self.take('sym', ')')
+        elif kind == 'name':
+            self.take()
+            if value in UNARY_OPS and value != 'neg':
+                self.arguments(1, value)
+                self.code.append(UNARY_OPS[value])
+            elif value in ('min', 'max'):
+                self.arguments(2, value)
+                self.code.append(BINARY_OPS[value])
+            elif value == 'clamp':
+                # clamp(v, lo, hi) = min(max(v, lo), hi)
+                self.take('sym', '(')
+                self.expression()
+                self.take('sym', ',')
+                self.expression()
+                self.code.append(BINARY_OPS['max'])
+                self.take('sym', ',')
+                self.expression()
+                self.take('sym', ')')
+                self.code.append(BINARY_OPS['min'])
+            elif value in self.variables:
+                self.code += bytes([OP_LOAD, self.variables[value]])
+            elif value in INPUTS:
+                self.code.append(INPUTS[value])
+            elif value in CONSTANTS:
+                self.push_constant(CONSTANTS[value])
+            else:
+                raise CompileError(f"unknown name {value!r}")
+        else:
+            raise CompileError(f"unexpected {value!r}")
+
+    def finish(self):
+        if self.position != len(self.tokens):
+            raise CompileError(f"unexpected {self.peek()[1]!r}")
+
+
+def compile_source(source):
+    """Returns the uploadable program (header + bytecode)"""
+    variables = {}
+    code = bytearray()
+    mode = None
+
+    lines = [line.split('#', 1)[0].strip() for line in source.replace(';', '\n').splitlines()]
+    for number, line in enumerate(lines, 1):
+        if not line:
+            continue
+        try:
+            if mode is not None:
+                raise CompileError("nothing may follow the hsv()/rgb() output")
+            tokens = tokenize(line)
+            if tokens[0] == ('name', 'let'):
+                name = tokens[1][1] if len(tokens) > 1 else None
+                if not name or tokens[1][0] != 'name' or name in INPUTS or name in CONSTANTS:
+                    raise CompileError("bad variable name")
+                parser = Parser(tokens[3:] if len(tokens) > 2 and tokens[2] == ('sym', '=') else [], variables)
+                if not parser.tokens:
+                    raise CompileError("expected 'let name = expression'")
+                parser.expression()
+                parser.finish()
+                if name not in variables:
+                    if len(variables) >= REGISTERS:
+                        raise CompileError(f"more than {REGISTERS} variables")
+                    variables[name] = len(variables)
+                code += parser.code + bytes([OP_STORE, variables[name]])
+            elif tokens[0][0] == 'name' and tokens[0][1] in OUTPUT_MODES:
+                mode = OUTPUT_MODES[tokens[0][1]]
+                parser = Parser(tokens[1:], variables)
+                parser.arguments(3, tokens[0][1])
+                parser.finish()
+                code += parser.code
+            else:
+                raise CompileError("expected 'let' or hsv()/rgb()")
+        except CompileError as error:
+            raise CompileError(f"line {number}: {error}") from None
+
+    if mode is None:
+        raise CompileError("missing hsv()/rgb() output")
+
+    program = struct.pack('<IBBH', PIXEL_VM_MAGIC, mode, 0, len(code)) + bytes(code)
+    if len(program) > MAX_CODE:
+        raise CompileError(f"program is {len(program)} bytes, the device accepts {MAX_CODE}")
+    return program
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('source', help='pattern source file (- for stdin)')
+    parser.add_argument('-o', '--output', help='write raw bytecode to this file')
+    parser.add_argument('--upload', metavar='HOST', help='send to http://HOST/custom-pattern')
+    args = parser.parse_args()
+
+    source = sys.stdin.read() if args.source == '-' else open(args.source).read()
+    try:
+        program = compile_source(source)
+    except CompileError as error:
+        sys.exit(f"{args.source}: {error}")
+
+    if args.output:
+        with open(args.output, 'wb') as f:
+            f.write(program)
+    print(f"{len(program)} bytes: {program.hex()}")
+
+    if args.upload:
+        request = urllib.request.Request(f"http://{args.upload}/custom-pattern",
+                                         data=program.hex().encode(), method='POST')
+        with urllib.request.urlopen(request, timeout=10) as response:
+            print(response.read().decode())
+
+
+if __name__ == '__main__':
+    main()